@@ -638,6 +638,16 @@ unsigned LZ4_count(const BYTE* pIn, const BYTE* pMatch, const BYTE* pInLimit)
 static int (*LZ4_compress_fast_extState_fp)(void* state, const char* source,
     char* dest, int inputSize,
     int maxOutputSize, int acceleration) = LZ4_compress_fast_extState;
+LZ4_FORCE_INLINE int LZ4_compress_fast_extState_fastReset_default(void* state, const char* src,
+    char* dst, int srcSize, int dstCapacity, int acceleration);
+static int (*LZ4_compress_fast_extState_fastReset_fp)(void* state, const char* src,
+    char* dst, int srcSize, int dstCapacity,
+    int acceleration) = LZ4_compress_fast_extState_fastReset_default;
+LZ4_FORCE_INLINE int LZ4_compress_destSize_extState_default(LZ4_stream_t* state, const char* src,
+    char* dst, int* srcSizePtr, int targetDstSize);
+static int (*LZ4_compress_destSize_extState_fp)(LZ4_stream_t* state, const char* src,
+    char* dst, int* srcSizePtr,
+    int targetDstSize) = LZ4_compress_destSize_extState_default;
 #endif
 
 /*-************************************
@@ -645,12 +655,17 @@ static int (*LZ4_compress_fast_extState_fp)(void* state, const char* source,
 **************************************/
 static const int LZ4_64Klimit = ((64 KB) + (MFLIMIT-1));
 static const U32 LZ4_skipTrigger = 6;  /* Increase this value ==> compression run slower on incompressible data */
+static const int AOCL_LZ4_smallLimit = 4 KB;   /* inputs below use a byU16Small table */
+/* byU16Small table : the first (1 << AOCL_LZ4_SMALL_HASHLOG) entries of the
+ * byU16 table. Small inputs fill few of its entries, and the reduced table
+ * stays in L1 together with the input, and is cheap to clear. */
+#define AOCL_LZ4_SMALL_HASHLOG 10
 
 
 /*-************************************
 *  Local Structures and types
 **************************************/
-typedef enum { clearedTable = 0, byPtr, byU32, byU16 } tableType_t;
+typedef enum { clearedTable = 0, byPtr, byU32, byU16, byU16Small } tableType_t;
 
 /**
  * This enum distinguishes several different modes of accessing previous
@@ -712,6 +727,8 @@ LZ4_FORCE_INLINE U32 LZ4_hash4(U32 sequence, tableType_t const tableType)
 {
     if (tableType == byU16)
         return ((sequence * 2654435761U) >> ((MINMATCH*8)-(LZ4_HASHLOG+1)));
+    else if (tableType == byU16Small)
+        return ((sequence * 2654435761U) >> ((MINMATCH*8)-AOCL_LZ4_SMALL_HASHLOG));
     else
         return ((sequence * 2654435761U) >> ((MINMATCH*8)-LZ4_HASHLOG));
 }
@@ -730,7 +747,7 @@ LZ4_FORCE_INLINE U32 LZ4_hash5(U64 sequence, tableType_t const tableType)
 
 LZ4_FORCE_INLINE U32 LZ4_hashPosition(const void* const p, tableType_t const tableType)
 {
-    if ((sizeof(reg_t)==8) && (tableType != byU16)) return LZ4_hash5(LZ4_read_ARCH(p), tableType);
+    if ((sizeof(reg_t)==8) && (tableType != byU16) && (tableType != byU16Small)) return LZ4_hash5(LZ4_read_ARCH(p), tableType);
     return LZ4_hash4(LZ4_read32(p), tableType);
 }
 
@@ -742,6 +759,7 @@ LZ4_FORCE_INLINE void LZ4_clearHash(U32 h, void* tableBase, tableType_t const ta
     case clearedTable: { /* illegal! */ assert(0); return; }
     case byPtr: { const BYTE** hashTable = (const BYTE**)tableBase; hashTable[h] = NULL; return; }
     case byU32: { U32* hashTable = (U32*) tableBase; hashTable[h] = 0; return; }
+    case byU16Small: /* fallthrough */
     case byU16: { U16* hashTable = (U16*) tableBase; hashTable[h] = 0; return; }
     }
 }
@@ -754,6 +772,7 @@ LZ4_FORCE_INLINE void LZ4_putIndexOnHash(U32 idx, U32 h, void* tableBase, tableT
     case clearedTable: /* fallthrough */
     case byPtr: { /* illegal! */ assert(0); return; }
     case byU32: { U32* hashTable = (U32*) tableBase; hashTable[h] = idx; return; }
+    case byU16Small: /* fallthrough */
     case byU16: { U16* hashTable = (U16*) tableBase; assert(idx < 65536); hashTable[h] = (U16)idx; return; }
     }
 }
@@ -767,6 +786,7 @@ LZ4_FORCE_INLINE void LZ4_putPositionOnHash(const BYTE* p, U32 h,
     case clearedTable: { /* illegal! */ assert(0); return; }
     case byPtr: { const BYTE** hashTable = (const BYTE**)tableBase; hashTable[h] = p; return; }
     case byU32: { U32* hashTable = (U32*) tableBase; hashTable[h] = (U32)(p-srcBase); return; }
+    case byU16Small: /* fallthrough */
     case byU16: { U16* hashTable = (U16*) tableBase; hashTable[h] = (U16)(p-srcBase); return; }
     }
 }
@@ -780,7 +800,7 @@ LZ4_FORCE_INLINE void LZ4_putPosition(const BYTE* p, void* tableBase, tableType_
 /* LZ4_getIndexOnHash() :
  * Index of match position registered in hash table.
  * hash position must be calculated by using base+index, or dictBase+index.
- * Assumption 1 : only valid if tableType == byU32 or byU16.
+ * Assumption 1 : only valid if tableType == byU32, byU16 or byU16Small.
  * Assumption 2 : h is presumed valid (within limits of hash table)
  */
 LZ4_FORCE_INLINE U32 LZ4_getIndexOnHash(U32 h, const void* tableBase, tableType_t tableType)
@@ -791,7 +811,7 @@ LZ4_FORCE_INLINE U32 LZ4_getIndexOnHash(U32 h, const void* tableBase, tableType_
         assert(h < (1U << (LZ4_MEMORY_USAGE-2)));
         return hashTable[h];
     }
-    if (tableType == byU16) {
+    if ((tableType == byU16) || (tableType == byU16Small)) {
         const U16* const hashTable = (const U16*) tableBase;
         assert(h < (1U << (LZ4_MEMORY_USAGE-1)));
         return hashTable[h];
@@ -826,15 +846,22 @@ LZ4_prepareTable(LZ4_stream_t_internal* const cctx,
     if ((tableType_t)cctx->tableType != clearedTable) {
         assert(inputSize >= 0);
         if ((tableType_t)cctx->tableType != tableType
-          || ((tableType == byU16) && cctx->currentOffset + (unsigned)inputSize >= 0xFFFFU)
+          || ((tableType == byU16 || tableType == byU16Small) && cctx->currentOffset + (unsigned)inputSize >= 0xFFFFU)
           || ((tableType == byU32) && cctx->currentOffset > 1 GB)
           || tableType == byPtr
           || inputSize >= 4 KB)
         {
             DEBUGLOG(4, "LZ4_prepareTable: Resetting table in %p", cctx);
-            MEM_INIT(cctx->hashTable, 0, LZ4_HASHTABLESIZE);
+            if (tableType == byU16Small) {
+                /* the rest of the table is not read by byU16Small, and is
+                 * cleared when the state switches to another table type */
+                MEM_INIT(cctx->hashTable, 0, sizeof(U16) << AOCL_LZ4_SMALL_HASHLOG);
+                cctx->tableType = (U32)byU16Small;
+            } else {
+                MEM_INIT(cctx->hashTable, 0, LZ4_HASHTABLESIZE);
+                cctx->tableType = (U32)clearedTable;
+            }
             cctx->currentOffset = 0;
-            cctx->tableType = (U32)clearedTable;
         } else {
             DEBUGLOG(4, "LZ4_prepareTable: Re-use hash table (no reset)");
         }
@@ -1311,7 +1338,7 @@ LZ4_FORCE_INLINE int AOCL_LZ4_compress_generic_validated(
     /* If init conditions are not met, we don't have to mark stream
      * as having dirty context, since no action was taken yet */
     if (outputDirective == fillOutput && maxOutputSize < 1) { return 0; } /* Impossible to store anything */
-    if ((tableType == byU16) && (inputSize>=LZ4_64Klimit)) { return 0; }  /* Size too large (not within 64K limit) */
+    if ((tableType == byU16 || tableType == byU16Small) && (inputSize>=LZ4_64Klimit)) { return 0; }  /* Size too large (not within 64K limit) */
     if (tableType==byPtr) assert(dictDirective==noDict);      /* only supported use case with byPtr */
     assert(acceleration >= 1);
 
@@ -1371,7 +1398,7 @@ LZ4_FORCE_INLINE int AOCL_LZ4_compress_generic_validated(
             } while ( (match+LZ4_DISTANCE_MAX < ip)
                    || (LZ4_read32(match) != LZ4_read32(ip)) );
 
-        } else {   /* byU32, byU16 */
+        } else {   /* byU32, byU16, byU16Small */
 
             const BYTE* forwardIp = ip;
             int step = 1;
@@ -1441,7 +1468,7 @@ LZ4_FORCE_INLINE int AOCL_LZ4_compress_generic_validated(
                 DEBUGLOG(7, "candidate at pos=%u  (offset=%u \n", matchIndex, current - matchIndex);
                 if ((dictIssue == dictSmall) && (matchIndex < prefixIdxLimit)) { continue; }    /* match outside of valid area */
                 assert(matchIndex < current);
-                if ( ((tableType != byU16) || (LZ4_DISTANCE_MAX < LZ4_DISTANCE_ABSOLUTE_MAX))
+                if ( ((tableType != byU16 && tableType != byU16Small) || (LZ4_DISTANCE_MAX < LZ4_DISTANCE_ABSOLUTE_MAX))
                   && (matchIndex+LZ4_DISTANCE_MAX < current)) {
                     continue;
                 } /* too far */
@@ -1632,7 +1659,7 @@ _next_match:
               && (LZ4_read32(match) == LZ4_read32(ip)) )
             { token=op++; *token=0; goto _next_match; }
 
-        } else {   /* byU32, byU16 */
+        } else {   /* byU32, byU16, byU16Small */
 
             U32 const h = LZ4_hashPosition(ip, tableType);
             U32 const current = (U32)(ip-base);
@@ -1663,7 +1690,7 @@ _next_match:
             LZ4_putIndexOnHash(current, h, cctx->hashTable, tableType);
             assert(matchIndex < current);
             if ( ((dictIssue==dictSmall) ? (matchIndex >= prefixIdxLimit) : 1)
-              && (((tableType==byU16) && (LZ4_DISTANCE_MAX == LZ4_DISTANCE_ABSOLUTE_MAX)) ? 1 : (matchIndex+LZ4_DISTANCE_MAX >= current))
+              && (((tableType==byU16 || tableType==byU16Small) && (LZ4_DISTANCE_MAX == LZ4_DISTANCE_ABSOLUTE_MAX)) ? 1 : (matchIndex+LZ4_DISTANCE_MAX >= current))
               && (LZ4_read32(match) == LZ4_read32(ip)) ) {
                 token=op++;
                 *token=0;
@@ -1863,7 +1890,7 @@ int AOCL_LZ4_compress_fast_extState(void* state, const char* source, char* dest,
  * (see comment in lz4.h on LZ4_resetStream_fast() for a definition of
  * "correctly initialized").
  */
-int LZ4_compress_fast_extState_fastReset(void* state, const char* src, char* dst, int srcSize, int dstCapacity, int acceleration)
+LZ4_FORCE_INLINE int LZ4_compress_fast_extState_fastReset_default(void* state, const char* src, char* dst, int srcSize, int dstCapacity, int acceleration)
 {
     LZ4_stream_t_internal* ctx = &((LZ4_stream_t*)state)->internal_donotuse;
     if (acceleration < 1) acceleration = LZ4_ACCELERATION_DEFAULT;
@@ -1900,6 +1927,82 @@ int LZ4_compress_fast_extState_fastReset(void* state, const char* src, char* dst
     }
 }
 
+/* AOCL_LZ4_compress_fast_extState_fastReset() :
+ * Inputs below AOCL_LZ4_smallLimit use the byU16Small table. As for byU16,
+ * the table is only cleared when currentOffset would pass 64 KB : positions
+ * of earlier inputs stay below currentOffset, and are rejected as dictSmall
+ * candidates, so a state reused for small inputs is cleared once every
+ * 64 KB of input instead of on every call. */
+int AOCL_LZ4_compress_fast_extState_fastReset(void* state, const char* src, char* dst, int srcSize, int dstCapacity, int acceleration)
+{
+    LZ4_stream_t_internal* ctx;
+    if (state==NULL || (src==NULL && srcSize!=0) || dst==NULL)
+        return -1;
+
+    ctx = &((LZ4_stream_t*)state)->internal_donotuse;
+    if (acceleration < 1) acceleration = LZ4_ACCELERATION_DEFAULT;
+    if (acceleration > LZ4_ACCELERATION_MAX) acceleration = LZ4_ACCELERATION_MAX;
+
+    if (dstCapacity >= LZ4_compressBound(srcSize)) {
+        if (srcSize < AOCL_LZ4_smallLimit) {
+            const tableType_t tableType = byU16Small;
+            LZ4_prepareTable(ctx, srcSize, tableType);
+            if (ctx->currentOffset) {
+                return AOCL_LZ4_compress_generic(ctx, src, dst, srcSize, NULL, 0, notLimited, tableType, noDict, dictSmall, acceleration);
+            } else {
+                return AOCL_LZ4_compress_generic(ctx, src, dst, srcSize, NULL, 0, notLimited, tableType, noDict, noDictIssue, acceleration);
+            }
+        } else if (srcSize < LZ4_64Klimit) {
+            const tableType_t tableType = byU16;
+            LZ4_prepareTable(ctx, srcSize, tableType);
+            if (ctx->currentOffset) {
+                return AOCL_LZ4_compress_generic(ctx, src, dst, srcSize, NULL, 0, notLimited, tableType, noDict, dictSmall, acceleration);
+            } else {
+                return AOCL_LZ4_compress_generic(ctx, src, dst, srcSize, NULL, 0, notLimited, tableType, noDict, noDictIssue, acceleration);
+            }
+        } else {
+            const tableType_t tableType = ((sizeof(void*)==4) && ((uptrval)src > LZ4_DISTANCE_MAX)) ? byPtr : byU32;
+            LZ4_prepareTable(ctx, srcSize, tableType);
+            return AOCL_LZ4_compress_generic(ctx, src, dst, srcSize, NULL, 0, notLimited, tableType, noDict, noDictIssue, acceleration);
+        }
+    } else {
+        if (srcSize < AOCL_LZ4_smallLimit) {
+            const tableType_t tableType = byU16Small;
+            LZ4_prepareTable(ctx, srcSize, tableType);
+            if (ctx->currentOffset) {
+                return AOCL_LZ4_compress_generic(ctx, src, dst, srcSize, NULL, dstCapacity, limitedOutput, tableType, noDict, dictSmall, acceleration);
+            } else {
+                return AOCL_LZ4_compress_generic(ctx, src, dst, srcSize, NULL, dstCapacity, limitedOutput, tableType, noDict, noDictIssue, acceleration);
+            }
+        } else if (srcSize < LZ4_64Klimit) {
+            const tableType_t tableType = byU16;
+            LZ4_prepareTable(ctx, srcSize, tableType);
+            if (ctx->currentOffset) {
+                return AOCL_LZ4_compress_generic(ctx, src, dst, srcSize, NULL, dstCapacity, limitedOutput, tableType, noDict, dictSmall, acceleration);
+            } else {
+                return AOCL_LZ4_compress_generic(ctx, src, dst, srcSize, NULL, dstCapacity, limitedOutput, tableType, noDict, noDictIssue, acceleration);
+            }
+        } else {
+            const tableType_t tableType = ((sizeof(void*)==4) && ((uptrval)src > LZ4_DISTANCE_MAX)) ? byPtr : byU32;
+            LZ4_prepareTable(ctx, srcSize, tableType);
+            return AOCL_LZ4_compress_generic(ctx, src, dst, srcSize, NULL, dstCapacity, limitedOutput, tableType, noDict, noDictIssue, acceleration);
+        }
+    }
+}
+
+int LZ4_compress_fast_extState_fastReset(void* state, const char* src, char* dst, int srcSize, int dstCapacity, int acceleration)
+{
+#ifdef AOCL_LZ4_OPT
+#ifdef AOCL_DYNAMIC_DISPATCHER
+    return LZ4_compress_fast_extState_fastReset_fp(state, src, dst, srcSize, dstCapacity, acceleration);
+#else
+    return AOCL_LZ4_compress_fast_extState_fastReset(state, src, dst, srcSize, dstCapacity, acceleration);
+#endif
+#else
+    return LZ4_compress_fast_extState_fastReset_default(state, src, dst, srcSize, dstCapacity, acceleration);
+#endif
+}
+
 
 int LZ4_compress_fast(const char* source, char* dest, int inputSize, int maxOutputSize, int acceleration)
 {
@@ -1937,7 +2040,7 @@ int LZ4_compress_default(const char* src, char* dst, int srcSize, int maxOutputS
 /* Note!: This function leaves the stream in an unclean/broken state!
  * It is not safe to subsequently use the same state with a _fastReset() or
  * _continue() call without resetting it. */
-static int LZ4_compress_destSize_extState (LZ4_stream_t* state, const char* src, char* dst, int* srcSizePtr, int targetDstSize)
+LZ4_FORCE_INLINE int LZ4_compress_destSize_extState_default (LZ4_stream_t* state, const char* src, char* dst, int* srcSizePtr, int targetDstSize)
 {
     if(state==NULL || src==NULL || dst==NULL || srcSizePtr==NULL)
         return -1;
@@ -1956,6 +2059,40 @@ static int LZ4_compress_destSize_extState (LZ4_stream_t* state, const char* src,
     }   }
 }
 
+/* AOCL_LZ4_compress_destSize_extState : same as LZ4_compress_destSize_extState_default(),
+ * using AOCL_LZ4_compress_generic(). Leaves the stream in the same state. */
+LZ4_FORCE_INLINE int AOCL_LZ4_compress_destSize_extState (LZ4_stream_t* state, const char* src, char* dst, int* srcSizePtr, int targetDstSize)
+{
+    if(state==NULL || src==NULL || dst==NULL || srcSizePtr==NULL)
+        return -1;
+
+    void* const s = LZ4_initStream(state, sizeof (*state));
+    assert(s != NULL); (void)s;
+
+    if (targetDstSize >= LZ4_compressBound(*srcSizePtr)) {  /* compression success is guaranteed */
+        return AOCL_LZ4_compress_fast_extState(state, src, dst, *srcSizePtr, targetDstSize, 1);
+    } else {
+        if (*srcSizePtr < LZ4_64Klimit) {
+            return AOCL_LZ4_compress_generic(&state->internal_donotuse, src, dst, *srcSizePtr, srcSizePtr, targetDstSize, fillOutput, byU16, noDict, noDictIssue, 1);
+        } else {
+            tableType_t const addrMode = ((sizeof(void*)==4) && ((uptrval)src > LZ4_DISTANCE_MAX)) ? byPtr : byU32;
+            return AOCL_LZ4_compress_generic(&state->internal_donotuse, src, dst, *srcSizePtr, srcSizePtr, targetDstSize, fillOutput, addrMode, noDict, noDictIssue, 1);
+    }   }
+}
+
+static int LZ4_compress_destSize_extState (LZ4_stream_t* state, const char* src, char* dst, int* srcSizePtr, int targetDstSize)
+{
+#ifdef AOCL_DYNAMIC_DISPATCHER
+    return LZ4_compress_destSize_extState_fp(state, src, dst, srcSizePtr, targetDstSize);
+#else
+#ifdef AOCL_LZ4_OPT
+    return AOCL_LZ4_compress_destSize_extState(state, src, dst, srcSizePtr, targetDstSize);
+#else
+    return LZ4_compress_destSize_extState_default(state, src, dst, srcSizePtr, targetDstSize);
+#endif
+#endif
+}
+
 
 int LZ4_compress_destSize(const char* src, char* dst, int* srcSizePtr, int targetDstSize)
 {
@@ -1982,6 +2119,8 @@ static void aocl_register_lz4_fmv(int optOff, int optLevel)
     {
         //C version
         LZ4_compress_fast_extState_fp = LZ4_compress_fast_extState;
+        LZ4_compress_fast_extState_fastReset_fp = LZ4_compress_fast_extState_fastReset_default;
+        LZ4_compress_destSize_extState_fp = LZ4_compress_destSize_extState_default;
     }
     else
     {
@@ -1993,6 +2132,8 @@ static void aocl_register_lz4_fmv(int optOff, int optLevel)
         case 3://AVX2 version
         default://AVX512 and other versions
             LZ4_compress_fast_extState_fp = AOCL_LZ4_compress_fast_extState;
+            LZ4_compress_fast_extState_fastReset_fp = AOCL_LZ4_compress_fast_extState_fastReset;
+            LZ4_compress_destSize_extState_fp = AOCL_LZ4_compress_destSize_extState;
             break;
         }
     }
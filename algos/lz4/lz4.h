@@ -139,6 +139,8 @@ LZ4LIB_API const char* LZ4_versionString (void);
 
 /**----- AOCL Optimization flags -----*/
 #define AOCL_LZ4_OPT
+#define AOCL_LZ4_AVX2_OPT
+#define AOCL_LZ4_AVX512_OPT
 #define AOCL_LZ4_DATA_ACCESS_OPT_LOAD_EARLY
 //#define AOCL_LZ4_DATA_ACCESS_OPT_PREFETCH_BACKWARDS
 //#define AOCL_LZ4_MATCH_SKIP_OPT_LDS_STRAT1
@@ -817,6 +819,20 @@ LZ4LIB_API int LZ4_decompress_safe_usingDict (const char* src, char* dst, int sr
  */
 LZ4LIB_STATIC_API int LZ4_compress_fast_extState_fastReset (void* state, const char* src, char* dst, int srcSize, int dstCapacity, int acceleration);
 
+#ifdef AOCL_LZ4_OPT
+/*! AOCL_LZ4_compress_fast_extState_fastReset() :
+ *  AOCL optimized LZ4_compress_fast_extState_fastReset(), selected by default.
+ *
+ *  Inputs smaller than 4 KB are hashed into a reduced table, which stays in L1
+ *  together with the input. Positions from earlier calls are told apart from the
+ *  current ones by their offset in the state, so a state reused for small inputs
+ *  is cleared only once every 64 KB of input.
+ *  Keeping one state per thread and passing it to every call is therefore much
+ *  faster than LZ4_compress_default() for small inputs.
+ */
+LZ4LIB_STATIC_API int AOCL_LZ4_compress_fast_extState_fastReset (void* state, const char* src, char* dst, int srcSize, int dstCapacity, int acceleration);
+#endif
+
 /*! LZ4_attach_dictionary() :
  *  This is an experimental API that allows
  *  efficient use of a static dictionary many times.
@@ -298,6 +298,48 @@ static BYTE LZ4F_headerChecksum (const void* header, size_t length)
 }
 
 
+/*! LZ4F_writeHeader() :
+ *  writes the frame header described by frameInfo, magic number included.
+ *  dst must be >= maxFHSize bytes, and blockSizeID must be set.
+ * @return : number of bytes written */
+static size_t LZ4F_writeHeader(void* dst, const LZ4F_frameInfo_t* frameInfo)
+{
+    BYTE* const dstStart = (BYTE*)dst;
+    BYTE* dstPtr = dstStart;
+    BYTE* headerStart;
+
+    /* Magic Number */
+    LZ4F_writeLE32(dstPtr, LZ4F_MAGICNUMBER);
+    dstPtr += 4;
+    headerStart = dstPtr;
+
+    /* FLG Byte */
+    *dstPtr++ = (BYTE)(((1 & _2BITS) << 6)    /* Version('01') */
+        + ((frameInfo->blockMode & _1BIT ) << 5)
+        + ((frameInfo->blockChecksumFlag & _1BIT ) << 4)
+        + ((unsigned)(frameInfo->contentSize > 0) << 3)
+        + ((frameInfo->contentChecksumFlag & _1BIT ) << 2)
+        +  (frameInfo->dictID > 0) );
+    /* BD Byte */
+    *dstPtr++ = (BYTE)((frameInfo->blockSizeID & _3BITS) << 4);
+    /* Optional Frame content size field */
+    if (frameInfo->contentSize) {
+        LZ4F_writeLE64(dstPtr, frameInfo->contentSize);
+        dstPtr += 8;
+    }
+    /* Optional dictionary ID field */
+    if (frameInfo->dictID) {
+        LZ4F_writeLE32(dstPtr, frameInfo->dictID);
+        dstPtr += 4;
+    }
+    /* Header CRC Byte */
+    *dstPtr = LZ4F_headerChecksum(headerStart, (size_t)(dstPtr - headerStart));
+    dstPtr++;
+
+    return (size_t)(dstPtr - dstStart);
+}
+
+
 /*-************************************
 *  Simple-pass compression functions
 **************************************/
@@ -603,7 +645,6 @@ size_t LZ4F_compressBegin_usingCDict(LZ4F_cctx* cctxPtr,
     LZ4F_preferences_t prefNull;
     BYTE* const dstStart = (BYTE*)dstBuffer;
     BYTE* dstPtr = dstStart;
-    BYTE* headerStart;
 
     if (dstCapacity < maxFHSize) return err0r(LZ4F_ERROR_dstMaxSize_tooSmall);
     MEM_INIT(&prefNull, 0, sizeof(prefNull));
@@ -666,34 +707,9 @@ size_t LZ4F_compressBegin_usingCDict(LZ4F_cctx* cctxPtr,
         LZ4_favorDecompressionSpeed((LZ4_streamHC_t*)cctxPtr->lz4CtxPtr, (int)preferencesPtr->favorDecSpeed);
     }
 
-    /* Magic Number */
-    LZ4F_writeLE32(dstPtr, LZ4F_MAGICNUMBER);
-    dstPtr += 4;
-    headerStart = dstPtr;
-
-    /* FLG Byte */
-    *dstPtr++ = (BYTE)(((1 & _2BITS) << 6)    /* Version('01') */
-        + ((cctxPtr->prefs.frameInfo.blockMode & _1BIT ) << 5)
-        + ((cctxPtr->prefs.frameInfo.blockChecksumFlag & _1BIT ) << 4)
-        + ((unsigned)(cctxPtr->prefs.frameInfo.contentSize > 0) << 3)
-        + ((cctxPtr->prefs.frameInfo.contentChecksumFlag & _1BIT ) << 2)
-        +  (cctxPtr->prefs.frameInfo.dictID > 0) );
-    /* BD Byte */
-    *dstPtr++ = (BYTE)((cctxPtr->prefs.frameInfo.blockSizeID & _3BITS) << 4);
-    /* Optional Frame content size field */
-    if (cctxPtr->prefs.frameInfo.contentSize) {
-        LZ4F_writeLE64(dstPtr, cctxPtr->prefs.frameInfo.contentSize);
-        dstPtr += 8;
+    if (cctxPtr->prefs.frameInfo.contentSize)
         cctxPtr->totalInSize = 0;
-    }
-    /* Optional dictionary ID field */
-    if (cctxPtr->prefs.frameInfo.dictID) {
-        LZ4F_writeLE32(dstPtr, cctxPtr->prefs.frameInfo.dictID);
-        dstPtr += 4;
-    }
-    /* Header CRC Byte */
-    *dstPtr = LZ4F_headerChecksum(headerStart, (size_t)(dstPtr - headerStart));
-    dstPtr++;
+    dstPtr += LZ4F_writeHeader(dstPtr, &cctxPtr->prefs.frameInfo);
 
     cctxPtr->cStage = 1;   /* header written, now request input data block */
     return (size_t)(dstPtr - dstStart);
@@ -1022,6 +1038,345 @@ size_t LZ4F_compressEnd(LZ4F_cctx* cctxPtr,
 }
 
 
+/*-***************************************************
+*   Multithreaded compression
+*****************************************************/
+/*
+ * The input is cut into blocks of the frame block size, which are compressed
+ * concurrently by numThreads workers : the calling thread and numThreads-1
+ * threads started once per frame. Each worker owns one context, reused for
+ * all its blocks, so workers share nothing but the read-only input. In a
+ * linked frame the context is restarted on the 64 KB of input preceding the
+ * block, which is the history the decoder holds when it reaches that block.
+ * Blocks are handed out in rounds of numThreads, and the results of a round
+ * are appended to the frame before the next round starts, which bounds the
+ * scratch memory to numThreads blocks.
+ *
+ * Blocks are compressed with the same functions as LZ4F_compressUpdate(), so
+ * the frame is byte-identical to the one of LZ4F_compressFrame() for
+ * independent blocks, and for linked blocks at levels >= LZ4HC_CLEVEL_MIN,
+ * whose context loaded with the history matches the streaming one. At lower
+ * levels, the hash table of LZ4_compress_fast_continue() depends on how all
+ * previous blocks were parsed, so linked blocks differ slightly from the
+ * reference.
+ */
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#endif
+
+#if defined(_WIN32)
+typedef HANDLE LZ4F_mtThread_t;
+typedef CRITICAL_SECTION LZ4F_mtMutex_t;
+typedef CONDITION_VARIABLE LZ4F_mtCond_t;
+#else
+typedef pthread_t LZ4F_mtThread_t;
+typedef pthread_mutex_t LZ4F_mtMutex_t;
+typedef pthread_cond_t LZ4F_mtCond_t;
+#endif
+
+typedef struct {
+    const BYTE* src;        /* block input, preceded by dictSize bytes of history */
+    size_t srcSize;
+    size_t dictSize;
+    BYTE* dst;              /* scratch of BHSize + srcSize + BFSize bytes */
+    size_t dstSize;         /* block written, header and checksum included */
+} LZ4F_mtBlock_t;
+
+typedef struct {
+    LZ4F_mtMutex_t mutex;
+    LZ4F_mtCond_t start;    /* a round started, or the frame is done */
+    LZ4F_mtCond_t done;     /* the last thread of the round finished */
+    unsigned round;         /* number of rounds started */
+    int nbActive;           /* workers with a block in the current round */
+    int pending;            /* threads still compressing in the current round */
+    int shutdown;
+    const LZ4F_preferences_t* prefs;
+} LZ4F_mtPool_t;
+
+typedef struct {
+    LZ4F_mtPool_t* pool;
+    int id;                 /* 0 is the calling thread */
+    void* ctx;              /* LZ4_stream_t or LZ4_streamHC_t, reused for each block */
+    LZ4F_mtBlock_t block;   /* block of the current round */
+    LZ4F_mtThread_t thread;
+} LZ4F_mtWorker_t;
+
+static void LZ4F_mtCompressBlock(LZ4F_mtWorker_t* w)
+{
+    const LZ4F_preferences_t* const prefs = w->pool->prefs;
+    LZ4F_mtBlock_t* const b = &w->block;
+    int const level = prefs->compressionLevel;
+    LZ4F_blockMode_t const blockMode = prefs->frameInfo.blockMode;
+
+    if (blockMode == LZ4F_blockLinked) {
+        /* restart the stream on the history the decoder holds for this block */
+        const char* const dict = (const char*)b->src - b->dictSize;
+        LZ4F_initStream(w->ctx, NULL, level, LZ4F_blockLinked);
+        if (b->dictSize) {
+            if (level < LZ4HC_CLEVEL_MIN)
+                LZ4_loadDict((LZ4_stream_t*)w->ctx, dict, (int)b->dictSize);
+            else
+                LZ4_loadDictHC((LZ4_streamHC_t*)w->ctx, dict, (int)b->dictSize);
+        }
+    }
+    if (level >= LZ4HC_CLEVEL_MIN)
+        LZ4_favorDecompressionSpeed((LZ4_streamHC_t*)w->ctx, (int)prefs->favorDecSpeed);
+    b->dstSize = LZ4F_makeBlock(b->dst, b->src, b->srcSize,
+                                LZ4F_selectCompression(blockMode, level), w->ctx, level,
+                                NULL, prefs->frameInfo.blockChecksumFlag);
+}
+
+#if defined(_WIN32)
+static void LZ4F_mtLock(LZ4F_mtMutex_t* m) { EnterCriticalSection(m); }
+static void LZ4F_mtUnlock(LZ4F_mtMutex_t* m) { LeaveCriticalSection(m); }
+static void LZ4F_mtWait(LZ4F_mtCond_t* c, LZ4F_mtMutex_t* m) { SleepConditionVariableCS(c, m, INFINITE); }
+static void LZ4F_mtBroadcast(LZ4F_mtCond_t* c) { WakeAllConditionVariable(c); }
+#else
+static void LZ4F_mtLock(LZ4F_mtMutex_t* m) { pthread_mutex_lock(m); }
+static void LZ4F_mtUnlock(LZ4F_mtMutex_t* m) { pthread_mutex_unlock(m); }
+static void LZ4F_mtWait(LZ4F_mtCond_t* c, LZ4F_mtMutex_t* m) { pthread_cond_wait(c, m); }
+static void LZ4F_mtBroadcast(LZ4F_mtCond_t* c) { pthread_cond_broadcast(c); }
+#endif
+
+/* Thread loop : compresses the block of each round it takes part in,
+ * until the pool is shut down. */
+static void LZ4F_mtWorkerRun(LZ4F_mtWorker_t* w)
+{
+    LZ4F_mtPool_t* const pool = w->pool;
+    unsigned seen = 0;
+
+    LZ4F_mtLock(&pool->mutex);
+    for (;;) {
+        while (pool->round == seen && !pool->shutdown)
+            LZ4F_mtWait(&pool->start, &pool->mutex);
+        if (pool->shutdown) break;
+        seen = pool->round;
+        if (w->id < pool->nbActive) {
+            LZ4F_mtUnlock(&pool->mutex);
+            LZ4F_mtCompressBlock(w);
+            LZ4F_mtLock(&pool->mutex);
+            if (--pool->pending == 0)
+                LZ4F_mtBroadcast(&pool->done);
+        }
+    }
+    LZ4F_mtUnlock(&pool->mutex);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI LZ4F_mtWorker(LPVOID arg)
+{
+    LZ4F_mtWorkerRun((LZ4F_mtWorker_t*)arg);
+    return 0;
+}
+
+static void LZ4F_mtPoolInit(LZ4F_mtPool_t* pool)
+{
+    InitializeCriticalSection(&pool->mutex);
+    InitializeConditionVariable(&pool->start);
+    InitializeConditionVariable(&pool->done);
+}
+
+static void LZ4F_mtPoolDestroy(LZ4F_mtPool_t* pool)
+{
+    DeleteCriticalSection(&pool->mutex);
+}
+
+static int LZ4F_mtThreadCreate(LZ4F_mtWorker_t* w)
+{
+    w->thread = CreateThread(NULL, 0, LZ4F_mtWorker, w, 0, NULL);
+    return w->thread != NULL;
+}
+
+static void LZ4F_mtThreadJoin(LZ4F_mtWorker_t* w)
+{
+    WaitForSingleObject(w->thread, INFINITE);
+    CloseHandle(w->thread);
+}
+#else
+static void* LZ4F_mtWorker(void* arg)
+{
+    LZ4F_mtWorkerRun((LZ4F_mtWorker_t*)arg);
+    return NULL;
+}
+
+static void LZ4F_mtPoolInit(LZ4F_mtPool_t* pool)
+{
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+}
+
+static void LZ4F_mtPoolDestroy(LZ4F_mtPool_t* pool)
+{
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+}
+
+static int LZ4F_mtThreadCreate(LZ4F_mtWorker_t* w)
+{
+    return pthread_create(&w->thread, NULL, LZ4F_mtWorker, w) == 0;
+}
+
+static void LZ4F_mtThreadJoin(LZ4F_mtWorker_t* w)
+{
+    pthread_join(w->thread, NULL);
+}
+#endif
+
+size_t AOCL_LZ4F_compressFrame_mt(void* dstBuffer, size_t dstCapacity,
+                            const void* srcBuffer, size_t srcSize,
+                            const LZ4F_preferences_t* preferencesPtr,
+                            int numThreads)
+{
+    LZ4F_preferences_t prefs;
+    LZ4F_mtPool_t pool;
+    LZ4F_mtWorker_t* workers;
+    BYTE* scratch;
+    XXH32_state_t xxh;
+    const BYTE* const src = (const BYTE*)srcBuffer;
+    BYTE* const dstStart = (BYTE*)dstBuffer;
+    BYTE* dstPtr = dstStart;
+    size_t blockSize, blockBound, nbBlocks, next, pos;
+    size_t result = 0;
+    int i, n, nbThreads;
+
+    if (dstBuffer == NULL || (srcBuffer == NULL && srcSize))
+        return err0r(LZ4F_ERROR_GENERIC);
+    if (preferencesPtr != NULL)
+        prefs = *preferencesPtr;
+    else
+        MEM_INIT(&prefs, 0, sizeof(prefs));
+    if (prefs.frameInfo.contentSize != 0)
+        prefs.frameInfo.contentSize = (U64)srcSize;   /* auto-correct content size if selected (!=0) */
+    if (prefs.frameInfo.blockSizeID == 0)
+        prefs.frameInfo.blockSizeID = LZ4F_BLOCKSIZEID_DEFAULT;
+    prefs.frameInfo.blockSizeID = LZ4F_optimalBSID(prefs.frameInfo.blockSizeID, srcSize);
+    prefs.autoFlush = 1;
+
+    blockSize = LZ4F_getBlockSize(prefs.frameInfo.blockSizeID);
+    if (LZ4F_isError(blockSize)) return blockSize;
+    if (srcSize <= blockSize)
+        prefs.frameInfo.blockMode = LZ4F_blockIndependent;   /* only one block => no need for inter-block link */
+    if (dstCapacity < LZ4F_compressFrameBound(srcSize, &prefs))  /* condition to guarantee success */
+        return err0r(LZ4F_ERROR_dstMaxSize_tooSmall);
+
+    nbBlocks = (srcSize + blockSize - 1) / blockSize;
+    if (numThreads < 1) numThreads = 1;
+    if ((size_t)numThreads > nbBlocks) numThreads = nbBlocks ? (int)nbBlocks : 1;
+    blockBound = BHSize + blockSize + BFSize;
+
+    workers = (LZ4F_mtWorker_t*)ALLOC_AND_ZERO(numThreads * sizeof(LZ4F_mtWorker_t));
+    scratch = (BYTE*)ALLOC(numThreads * blockBound);
+    if (workers == NULL || scratch == NULL) {
+        FREEMEM(workers);
+        FREEMEM(scratch);
+        return err0r(LZ4F_ERROR_allocation_failed);
+    }
+    MEM_INIT(&pool, 0, sizeof(pool));
+    pool.prefs = &prefs;
+    LZ4F_mtPoolInit(&pool);
+    for (i = 0; i < numThreads; i++) {
+        LZ4F_mtWorker_t* const w = &workers[i];
+        w->pool = &pool;
+        w->id = i;
+        w->block.dst = scratch + (size_t)i * blockBound;
+        if (prefs.compressionLevel < LZ4HC_CLEVEL_MIN) {
+            w->ctx = LZ4_createStream();
+        } else {
+            w->ctx = LZ4_createStreamHC();
+            if (w->ctx != NULL)
+                LZ4_setCompressionLevel((LZ4_streamHC_t*)w->ctx, prefs.compressionLevel);
+        }
+        if (w->ctx == NULL) {
+            result = err0r(LZ4F_ERROR_allocation_failed);
+            goto _end;
+        }
+    }
+
+    /* workers the system cannot start are left out : the frame does not
+     * depend on the number of workers */
+    for (nbThreads = 1; nbThreads < numThreads; nbThreads++) {
+        if (!LZ4F_mtThreadCreate(&workers[nbThreads]))
+            break;
+    }
+
+    dstPtr += LZ4F_writeHeader(dstPtr, &prefs.frameInfo);
+    (void)XXH32_reset(&xxh, 0);
+
+    /* compress in rounds of nbThreads blocks */
+    pos = 0;
+    next = 0;
+    while (next < nbBlocks) {
+        n = (int)MIN(nbBlocks - next, (size_t)nbThreads);
+        for (i = 0; i < n; i++) {
+            LZ4F_mtBlock_t* const b = &workers[i].block;
+            size_t const start = pos + (size_t)i * blockSize;
+
+            b->src = src + start;
+            b->srcSize = MIN(srcSize - start, blockSize);
+            b->dictSize = 0;
+            if (prefs.frameInfo.blockMode == LZ4F_blockLinked)
+                b->dictSize = MIN(start, 64 KB);
+            b->dstSize = 0;
+        }
+
+        LZ4F_mtLock(&pool.mutex);
+        pool.nbActive = n;
+        pool.pending = n - 1;
+        pool.round++;
+        LZ4F_mtBroadcast(&pool.start);
+        LZ4F_mtUnlock(&pool.mutex);
+
+        /* the calling thread takes the first block of the round */
+        LZ4F_mtCompressBlock(&workers[0]);
+        if (prefs.frameInfo.contentChecksumFlag)
+            XXH32_update(&xxh, src + pos, MIN(srcSize - pos, (size_t)n * blockSize));
+
+        LZ4F_mtLock(&pool.mutex);
+        while (pool.pending > 0)
+            LZ4F_mtWait(&pool.done, &pool.mutex);
+        LZ4F_mtUnlock(&pool.mutex);
+
+        for (i = 0; i < n; i++) {
+            memcpy(dstPtr, workers[i].block.dst, workers[i].block.dstSize);
+            dstPtr += workers[i].block.dstSize;
+        }
+        pos += (size_t)n * blockSize;
+        next += (size_t)n;
+    }
+
+    LZ4F_mtLock(&pool.mutex);
+    pool.shutdown = 1;
+    LZ4F_mtBroadcast(&pool.start);
+    LZ4F_mtUnlock(&pool.mutex);
+    for (i = 1; i < nbThreads; i++)
+        LZ4F_mtThreadJoin(&workers[i]);
+
+    LZ4F_writeLE32(dstPtr, 0);
+    dstPtr += 4;   /* endMark */
+    if (prefs.frameInfo.contentChecksumFlag == LZ4F_contentChecksumEnabled) {
+        LZ4F_writeLE32(dstPtr, XXH32_digest(&xxh));
+        dstPtr += 4;   /* content Checksum */
+    }
+    result = (size_t)(dstPtr - dstStart);
+
+_end:
+    for (i = 0; i < numThreads; i++) {
+        if (prefs.compressionLevel < LZ4HC_CLEVEL_MIN)
+            LZ4_freeStream((LZ4_stream_t*)workers[i].ctx);
+        else
+            LZ4_freeStreamHC((LZ4_streamHC_t*)workers[i].ctx);
+    }
+    LZ4F_mtPoolDestroy(&pool);
+    FREEMEM(workers);
+    FREEMEM(scratch);
+    return result;
+}
+
+
 /*-***************************************************
 *   Frame Decompression
 *****************************************************/
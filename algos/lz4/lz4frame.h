@@ -225,6 +225,25 @@ LZ4FLIB_API size_t LZ4F_compressFrame(void* dstBuffer, size_t dstCapacity,
                                 const void* srcBuffer, size_t srcSize,
                                 const LZ4F_preferences_t* preferencesPtr);
 
+/*! AOCL_LZ4F_compressFrame_mt() :
+ *  Compress an entire srcBuffer into a valid LZ4 frame, like LZ4F_compressFrame(),
+ *  with the blocks of the frame compressed concurrently on up to numThreads threads.
+ *  In a linked frame (LZ4F_blockLinked), each block is compressed after loading
+ *  the 64 KB of input preceding it.
+ *  The frame is byte-identical to the one of LZ4F_compressFrame(), whatever numThreads,
+ *  except for linked frames at levels below LZ4HC_CLEVEL_MIN (3), whose size stays close to it.
+ *  The work is split per block : LZ4F_max1MB or LZ4F_max4MB blocks keep all threads busy on large inputs.
+ *  Values of numThreads below 2 compress all blocks on the calling thread.
+ *  dstCapacity MUST be >= LZ4F_compressFrameBound(srcSize, preferencesPtr).
+ *  The frame is decoded by any LZ4 frame decoder, such as LZ4F_decompress().
+ * @return : number of bytes written into dstBuffer.
+ *           or an error code if it fails (can be tested using LZ4F_isError())
+ */
+LZ4FLIB_API size_t AOCL_LZ4F_compressFrame_mt(void* dstBuffer, size_t dstCapacity,
+                                const void* srcBuffer, size_t srcSize,
+                                const LZ4F_preferences_t* preferencesPtr,
+                                int numThreads);
+
 
 /*-***********************************
 *  Advanced compression functions
@@ -88,6 +88,15 @@ typedef enum { noDictCtx, usingDictCtxHc } dictCtx_directive;
 #define UPDATABLE(ip, op, anchor) &ip, &op, &anchor
 
 static U32 LZ4HC_hashPtr(const void* ptr) { return HASH_FUNCTION(LZ4_read32(ptr)); }
+#ifdef AOCL_LZ4HC_OPT
+/* Hash of the context, which may use fewer than LZ4HC_HASH_LOG bits
+ * (see AOCL_LZ4_compress_HC_extStateHC_sized()) */
+#define AOCL_HASH_FUNCTION(i, hashLog) (((i) * 2654435761U) >> ((MINMATCH*8)-(hashLog)))
+static U32 AOCL_LZ4HC_hashPtr(const void* ptr, U32 hashLog) { return AOCL_HASH_FUNCTION(LZ4_read32(ptr), hashLog); }
+#define LZ4HC_CTX_HASHPTR(hc4, ptr) AOCL_LZ4HC_hashPtr((ptr), (U32)(hc4)->hashLog)
+#else
+#define LZ4HC_CTX_HASHPTR(hc4, ptr) LZ4HC_hashPtr(ptr)
+#endif
 
 
 /**************************************
@@ -107,6 +116,7 @@ static void LZ4HC_init_internal (LZ4HC_CCtx_internal* hc4, const BYTE* start)
         startingOffset = 0;
     }
     startingOffset += 64 KB;
+    if (hc4->hashLog == 0) hc4->hashLog = LZ4HC_HASH_LOG;
     hc4->nextToUpdate = (U32) startingOffset;
     hc4->base = start - startingOffset;
     hc4->end = start;
@@ -126,7 +136,7 @@ LZ4_FORCE_INLINE void LZ4HC_Insert (LZ4HC_CCtx_internal* hc4, const BYTE* ip)
     U32 idx = hc4->nextToUpdate;
 
     while (idx < target) {
-        U32 const h = LZ4HC_hashPtr(base+idx);
+        U32 const h = LZ4HC_CTX_HASHPTR(hc4, base+idx);
         size_t delta = idx - hashTable[h];
         if (delta>LZ4_DISTANCE_MAX) delta = LZ4_DISTANCE_MAX;
         DELTANEXTU16(chainTable, idx) = (U16)delta;
@@ -388,6 +398,146 @@ LZ4HC_reverseCountPattern(const BYTE* ip, const BYTE* const iLow, U32 pattern)
     return (unsigned)(iStart - ip);
 }
 
+#ifdef AOCL_LZ4HC_OPT
+#if defined(AOCL_LZ4_AVX2_OPT) || defined(AOCL_LZ4_AVX512_OPT)
+#include <immintrin.h>
+#endif
+
+#ifdef AOCL_LZ4_AVX2_OPT
+/* AOCL_LZ4HC_countPattern_avx2() :
+ * LZ4HC_countPattern() comparing 32 bytes per step. Steps are a multiple of
+ * the pattern length, so the scalar tail starts in phase with pattern32. */
+__attribute__((__target__("avx2"))) static unsigned
+AOCL_LZ4HC_countPattern_avx2(const BYTE* ip, const BYTE* const iEnd, U32 const pattern32)
+{
+    const BYTE* const iStart = ip;
+    __m256i const pattern = _mm256_set1_epi32((int)pattern32);
+
+    while (likely(ip + 32 <= iEnd)) {
+        U32 const equal = (U32)_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)ip), pattern));
+        if (equal != 0xFFFFFFFFU)
+            return (unsigned)(ip - iStart) + (unsigned)__builtin_ctz(~equal);
+        ip += 32;
+    }
+    return (unsigned)(ip - iStart) + LZ4HC_countPattern(ip, iEnd, pattern32);
+}
+
+/* AOCL_LZ4HC_reverseCountPattern_avx2() :
+ * LZ4HC_reverseCountPattern() comparing the 32 bytes before ip per step */
+__attribute__((__target__("avx2"))) static unsigned
+AOCL_LZ4HC_reverseCountPattern_avx2(const BYTE* ip, const BYTE* const iLow, U32 pattern32)
+{
+    const BYTE* const iStart = ip;
+    __m256i const pattern = _mm256_set1_epi32((int)pattern32);
+
+    while (likely(ip >= iLow + 32)) {
+        U32 const equal = (U32)_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(ip - 32)), pattern));
+        if (equal != 0xFFFFFFFFU)
+            return (unsigned)(iStart - ip) + (unsigned)__builtin_clz(~equal);
+        ip -= 32;
+    }
+    return (unsigned)(iStart - ip) + LZ4HC_reverseCountPattern(ip, iLow, pattern32);
+}
+#endif /* AOCL_LZ4_AVX2_OPT */
+
+#ifdef AOCL_LZ4_AVX512_OPT
+/* AOCL_LZ4HC_countPattern_avx512() :
+ * LZ4HC_countPattern() comparing 64 bytes per step. The last bytes are read
+ * with a masked load, so that nothing is read at or past iEnd. */
+__attribute__((__target__("avx512f,avx512bw"))) static unsigned
+AOCL_LZ4HC_countPattern_avx512(const BYTE* ip, const BYTE* const iEnd, U32 const pattern32)
+{
+    const BYTE* const iStart = ip;
+    __m512i const pattern = _mm512_set1_epi32((int)pattern32);
+
+    while (likely(ip + 64 <= iEnd)) {
+        U64 const equal = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void*)ip), pattern);
+        if (equal != ~0ULL)
+            return (unsigned)(ip - iStart) + (unsigned)__builtin_ctzll(~equal);
+        ip += 64;
+    }
+    if (ip < iEnd) {
+        __mmask64 const valid = (~0ULL) >> (64 - (iEnd - ip));
+        U64 const equal = _mm512_mask_cmpeq_epi8_mask(valid,
+            _mm512_maskz_loadu_epi8(valid, (const void*)ip), pattern);
+        /* bits past iEnd are clear in equal, which bounds the count */
+        ip += __builtin_ctzll(~equal);
+    }
+    return (unsigned)(ip - iStart);
+}
+
+/* AOCL_LZ4HC_reverseCountPattern_avx512() :
+ * LZ4HC_reverseCountPattern() comparing the 64 bytes before ip per step.
+ * Bytes between iLow and the last full step are read with a masked load. */
+__attribute__((__target__("avx512f,avx512bw"))) static unsigned
+AOCL_LZ4HC_reverseCountPattern_avx512(const BYTE* ip, const BYTE* const iLow, U32 pattern32)
+{
+    const BYTE* const iStart = ip;
+    __m512i const pattern = _mm512_set1_epi32((int)pattern32);
+
+    while (likely(ip >= iLow + 64)) {
+        U64 const equal = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void*)(ip - 64)), pattern);
+        if (equal != ~0ULL)
+            return (unsigned)(iStart - ip) + (unsigned)__builtin_clzll(~equal);
+        ip -= 64;
+    }
+    if (ip > iLow) {
+        size_t const left = (size_t)(ip - iLow);
+        __mmask64 const valid = (~0ULL) >> (64 - left);
+        /* iLow is not in phase with the pattern, which is rotated to match it */
+        __m512i const rotated = _mm512_set1_epi32((int)LZ4HC_rotatePattern(left, pattern32));
+        U64 const equal = _mm512_mask_cmpeq_epi8_mask(valid,
+            _mm512_maskz_loadu_epi8(valid, (const void*)iLow), rotated);
+        /* shifts the byte before ip to the top bit; bits below iLow become clear */
+        ip -= __builtin_clzll(~(equal << (64 - left)));
+    }
+    return (unsigned)(iStart - ip);
+}
+#endif /* AOCL_LZ4_AVX512_OPT */
+#endif /* AOCL_LZ4HC_OPT */
+
+#ifdef AOCL_DYNAMIC_DISPATCHER
+static unsigned (*LZ4HC_countPattern_fp)(const BYTE* ip, const BYTE* const iEnd,
+                    U32 const pattern32) = LZ4HC_countPattern;
+static unsigned (*LZ4HC_reverseCountPattern_fp)(const BYTE* ip, const BYTE* const iLow,
+                    U32 pattern) = LZ4HC_reverseCountPattern;
+
+// function pointers to variants of the LZ4HC_countPattern() and LZ4HC_reverseCountPattern()
+// functions, used for integration with the dynamic dispatcher.
+#define LZ4HC_COUNT_PATTERN(ip, iEnd, pattern)         LZ4HC_countPattern_fp((ip), (iEnd), (pattern))
+#define LZ4HC_REVERSE_COUNT_PATTERN(ip, iLow, pattern) LZ4HC_reverseCountPattern_fp((ip), (iLow), (pattern))
+#elif defined(AOCL_LZ4HC_OPT) && defined(AOCL_LZ4_AVX2_OPT)
+#define LZ4HC_COUNT_PATTERN(ip, iEnd, pattern)         AOCL_LZ4HC_countPattern_avx2((ip), (iEnd), (pattern))
+#define LZ4HC_REVERSE_COUNT_PATTERN(ip, iLow, pattern) AOCL_LZ4HC_reverseCountPattern_avx2((ip), (iLow), (pattern))
+#else
+#define LZ4HC_COUNT_PATTERN(ip, iEnd, pattern)         LZ4HC_countPattern((ip), (iEnd), (pattern))
+#define LZ4HC_REVERSE_COUNT_PATTERN(ip, iLow, pattern) LZ4HC_reverseCountPattern((ip), (iLow), (pattern))
+#endif
+
+#ifdef AOCL_LZ4HC_UNIT_TEST
+unsigned Test_LZ4HC_countPattern(const BYTE* ip, const BYTE* const iEnd, U32 const pattern32)
+{
+    return LZ4HC_countPattern(ip, iEnd, pattern32);
+}
+
+unsigned Test_AOCL_LZ4HC_countPattern(const BYTE* ip, const BYTE* const iEnd, U32 const pattern32)
+{
+    return LZ4HC_COUNT_PATTERN(ip, iEnd, pattern32);
+}
+
+unsigned Test_LZ4HC_reverseCountPattern(const BYTE* ip, const BYTE* const iLow, U32 pattern)
+{
+    return LZ4HC_reverseCountPattern(ip, iLow, pattern);
+}
+
+unsigned Test_AOCL_LZ4HC_reverseCountPattern(const BYTE* ip, const BYTE* const iLow, U32 pattern)
+{
+    return LZ4HC_REVERSE_COUNT_PATTERN(ip, iLow, pattern);
+}
+#endif
+
 /* LZ4HC_protectDictEnd() :
  * Checks if the match is in the last 3 bytes of the dictionary, so reading the
  * 4 byte MINMATCH would overflow.
@@ -436,7 +586,7 @@ LZ4HC_InsertAndGetWiderMatch (
     DEBUGLOG(7, "LZ4HC_InsertAndGetWiderMatch");
     /* First Match */
     LZ4HC_Insert(hc4, ip);
-    matchIndex = HashTable[LZ4HC_hashPtr(ip)];
+    matchIndex = HashTable[LZ4HC_CTX_HASHPTR(hc4, ip)];
     DEBUGLOG(7, "First match at index %u / %u (lowestMatchIndex)",
                 matchIndex, lowestMatchIndex);
 
@@ -527,7 +677,7 @@ LZ4HC_InsertAndGetWiderMatch (
                     if ( ((pattern & 0xFFFF) == (pattern >> 16))
                       &  ((pattern & 0xFF)   == (pattern >> 24)) ) {
                         repeat = rep_confirmed;
-                        srcPatternLength = LZ4HC_countPattern(ip+sizeof(pattern), iHighLimit, pattern) + sizeof(pattern);
+                        srcPatternLength = LZ4HC_COUNT_PATTERN(ip+sizeof(pattern), iHighLimit, pattern) + sizeof(pattern);
                     } else {
                         repeat = rep_not;
                 }   }
@@ -538,17 +688,17 @@ LZ4HC_InsertAndGetWiderMatch (
                     if (LZ4_read32(matchPtr) == pattern) {  /* good candidate */
                         const BYTE* const dictStart = dictBase + hc4->lowLimit;
                         const BYTE* const iLimit = extDict ? dictBase + dictLimit : iHighLimit;
-                        size_t forwardPatternLength = LZ4HC_countPattern(matchPtr+sizeof(pattern), iLimit, pattern) + sizeof(pattern);
+                        size_t forwardPatternLength = LZ4HC_COUNT_PATTERN(matchPtr+sizeof(pattern), iLimit, pattern) + sizeof(pattern);
                         if (extDict && matchPtr + forwardPatternLength == iLimit) {
                             U32 const rotatedPattern = LZ4HC_rotatePattern(forwardPatternLength, pattern);
-                            forwardPatternLength += LZ4HC_countPattern(lowPrefixPtr, iHighLimit, rotatedPattern);
+                            forwardPatternLength += LZ4HC_COUNT_PATTERN(lowPrefixPtr, iHighLimit, rotatedPattern);
                         }
                         {   const BYTE* const lowestMatchPtr = extDict ? dictStart : lowPrefixPtr;
-                            size_t backLength = LZ4HC_reverseCountPattern(matchPtr, lowestMatchPtr, pattern);
+                            size_t backLength = LZ4HC_REVERSE_COUNT_PATTERN(matchPtr, lowestMatchPtr, pattern);
                             size_t currentSegmentLength;
                             if (!extDict && matchPtr - backLength == lowPrefixPtr && hc4->lowLimit < dictLimit) {
                                 U32 const rotatedPattern = LZ4HC_rotatePattern((U32)(-(int)backLength), pattern);
-                                backLength += LZ4HC_reverseCountPattern(dictBase + dictLimit, dictStart, rotatedPattern);
+                                backLength += LZ4HC_REVERSE_COUNT_PATTERN(dictBase + dictLimit, dictStart, rotatedPattern);
                             }
                             /* Limit backLength not go further than lowestMatchIndex */
                             backLength = matchCandidateIdx - MAX(matchCandidateIdx - (U32)backLength, lowestMatchIndex);
@@ -599,7 +749,7 @@ LZ4HC_InsertAndGetWiderMatch (
       && nbAttempts > 0
       && ipIndex - lowestMatchIndex < LZ4_DISTANCE_MAX) {
         size_t const dictEndOffset = (size_t)(dictCtx->end - dictCtx->base);
-        U32 dictMatchIndex = dictCtx->hashTable[LZ4HC_hashPtr(ip)];
+        U32 dictMatchIndex = dictCtx->hashTable[LZ4HC_CTX_HASHPTR(dictCtx, ip)];
         assert(dictEndOffset <= 1 GB);
         matchIndex = dictMatchIndex + lowestMatchIndex - (U32)dictEndOffset;
         while (ipIndex - matchIndex <= LZ4_DISTANCE_MAX && nbAttempts--) {
@@ -1252,6 +1402,38 @@ static int LZ4HC_compress_optimal( LZ4HC_CCtx_internal* ctx,
     const dictCtx_directive dict,
     const HCfavor_e favorDecSpeed);
 
+#ifdef AOCL_LZ4HC_OPT
+static int AOCL_LZ4HC_compress_optimal(LZ4HC_CCtx_internal* ctx,
+    const char* const source, char* dst,
+    int* srcSizePtr, int dstCapacity,
+    int const nbSearches, size_t sufficient_len,
+    const limitedOutput_directive limit, int const fullUpdate,
+    const dictCtx_directive dict,
+    const HCfavor_e favorDecSpeed);
+#ifdef AOCL_LZ4_AVX2_OPT
+static int AOCL_LZ4HC_compress_optimal_avx2(LZ4HC_CCtx_internal* ctx,
+    const char* const source, char* dst,
+    int* srcSizePtr, int dstCapacity,
+    int const nbSearches, size_t sufficient_len,
+    const limitedOutput_directive limit, int const fullUpdate,
+    const dictCtx_directive dict,
+    const HCfavor_e favorDecSpeed);
+#endif
+#endif
+
+#ifdef AOCL_DYNAMIC_DISPATCHER
+static int (*LZ4HC_compress_optimal_fp)(LZ4HC_CCtx_internal* ctx,
+    const char* const source, char* dst,
+    int* srcSizePtr, int dstCapacity,
+    int const nbSearches, size_t sufficient_len,
+    const limitedOutput_directive limit, int const fullUpdate,
+    const dictCtx_directive dict,
+    const HCfavor_e favorDecSpeed) = LZ4HC_compress_optimal;
+
+// function pointer to variants of the LZ4HC_compress_optimal() function, used for integration
+// with the dynamic dispatcher.
+#endif
+
 
 LZ4_FORCE_INLINE int LZ4HC_compress_generic_internal (
     LZ4HC_CCtx_internal* const ctx,
@@ -1317,11 +1499,33 @@ LZ4_FORCE_INLINE int LZ4HC_compress_generic_internal (
 #endif
         } else {
             assert(cParam.strat == lz4opt);
+#ifdef AOCL_LZ4HC_OPT
+#ifdef AOCL_DYNAMIC_DISPATCHER
+            result = LZ4HC_compress_optimal_fp(ctx,
+                                src, dst, srcSizePtr, dstCapacity,
+                                cParam.nbSearches, cParam.targetLength, limit,
+                                cLevel == LZ4HC_CLEVEL_MAX,   /* ultra mode */
+                                dict, favor);
+#elif defined(AOCL_LZ4_AVX2_OPT)
+            result = AOCL_LZ4HC_compress_optimal_avx2(ctx,
+                                src, dst, srcSizePtr, dstCapacity,
+                                cParam.nbSearches, cParam.targetLength, limit,
+                                cLevel == LZ4HC_CLEVEL_MAX,   /* ultra mode */
+                                dict, favor);
+#else
+            result = AOCL_LZ4HC_compress_optimal(ctx,
+                                src, dst, srcSizePtr, dstCapacity,
+                                cParam.nbSearches, cParam.targetLength, limit,
+                                cLevel == LZ4HC_CLEVEL_MAX,   /* ultra mode */
+                                dict, favor);
+#endif
+#else
             result = LZ4HC_compress_optimal(ctx,
                                 src, dst, srcSizePtr, dstCapacity,
                                 cParam.nbSearches, cParam.targetLength, limit,
                                 cLevel == LZ4HC_CLEVEL_MAX,   /* ultra mode */
                                 dict, favor);
+#endif
         }
         if (result <= 0) ctx->dirty = 1;
         return result;
@@ -1452,6 +1656,46 @@ int LZ4_compress_HC_destSize(void* state, const char* source, char* dest, int* s
     return LZ4HC_compress_generic(&ctx->internal_donotuse, source, dest, sourceSizePtr, targetDestSize, cLevel, fillOutput);
 }
 
+#ifdef AOCL_LZ4HC_OPT
+int AOCL_LZ4HC_hashLogForSize(int srcSize)
+{
+    int hashLog = LZ4HC_HASH_LOG_MIN;
+    if (srcSize <= 0) return LZ4HC_HASH_LOG;
+    while (hashLog < LZ4HC_HASH_LOG && (1 << hashLog) < srcSize) hashLog++;
+    return hashLog;
+}
+
+/* Unlike LZ4_initStreamHC(), which clears the whole state, only the fields
+ * and the hash entries in use are initialized. Chain entries need no reset:
+ * the entry of a position is written when it is inserted, and only inserted
+ * positions are ever followed. */
+int AOCL_LZ4_compress_HC_extStateHC_sized(void* state, const char* src, char* dst, int srcSize, int dstCapacity, int compressionLevel, int hashLog)
+{
+    LZ4_streamHC_t* const streamPtr = (LZ4_streamHC_t*)state;
+    LZ4HC_CCtx_internal* ctx;
+    if(state==NULL || (src==NULL && srcSize!=0) || dst==NULL)
+        return -1;
+    if (!LZ4_isAligned(state, LZ4_streamHC_t_alignment())) return 0;
+    if (hashLog < LZ4HC_HASH_LOG_MIN) hashLog = LZ4HC_HASH_LOG_MIN;
+    if (hashLog > LZ4HC_HASH_LOG) hashLog = LZ4HC_HASH_LOG;
+
+    ctx = &streamPtr->internal_donotuse;
+    MEM_INIT(ctx->hashTable, 0, sizeof(ctx->hashTable[0]) << hashLog);
+    ctx->end = NULL;
+    ctx->base = NULL;
+    ctx->favorDecSpeed = 0;
+    ctx->dirty = 0;
+    ctx->hashLog = (LZ4_i8)hashLog;
+    ctx->dictCtx = NULL;
+    LZ4_setCompressionLevel(streamPtr, compressionLevel);
+    LZ4HC_init_internal(ctx, (const BYTE*)src);
+    if (dstCapacity < LZ4_compressBound(srcSize))
+        return LZ4HC_compress_generic (ctx, src, dst, &srcSize, dstCapacity, compressionLevel, limitedOutput);
+    else
+        return LZ4HC_compress_generic (ctx, src, dst, &srcSize, dstCapacity, compressionLevel, notLimited);
+}
+#endif
+
 
 
 /**************************************
@@ -2098,12 +2342,476 @@ _return_label:
      return retval;
 }
 
+#ifdef AOCL_LZ4HC_OPT
+/* ================================================
+ *  AOCL LZ4 Optimal parser
+ *  Produces the same sequences as LZ4HC_compress_optimal().
+ * ===============================================*/
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  define AOCL_LZ4HC_PREFETCH(ptr) _mm_prefetch((const char*)(ptr), _MM_HINT_T0)
+#elif defined(__GNUC__) || defined(__clang__)
+#  define AOCL_LZ4HC_PREFETCH(ptr) __builtin_prefetch((ptr), 0, 3)
+#else
+#  define AOCL_LZ4HC_PREFETCH(ptr) (void)(ptr)
+#endif
+
+/* Vector loads of the price table may read up to 7 entries past the last
+ * position of a match */
+#define AOCL_LZ4HC_OPT_TABLE_SIZE (LZ4_OPT_NUM + TRAILING_LITERALS + 8)
+
+/* Price table of the optimal parser, stored as separate arrays: the cost
+ * comparisons only touch the prices, which are then contiguous, and the
+ * reverse traversal only touches mlen and off. */
+typedef struct {
+    int price[AOCL_LZ4HC_OPT_TABLE_SIZE];
+    int off[AOCL_LZ4HC_OPT_TABLE_SIZE];
+    int mlen[AOCL_LZ4HC_OPT_TABLE_SIZE];
+    int litlen[AOCL_LZ4HC_OPT_TABLE_SIZE];
+} AOCL_LZ4HC_optTable_t;
+
+/* Part of LZ4HC_sequencePrice() which depends on the match length */
+LZ4_FORCE_INLINE int AOCL_LZ4HC_matchLengthPrice(int mlen)
+{
+    if (mlen >= (int)(ML_MASK+MINMATCH))
+        return 1 + ((mlen-(int)(ML_MASK+MINMATCH)) / 255);
+    return 0;
+}
+
+LZ4_FORCE_INLINE void AOCL_LZ4HC_setLiteral(AOCL_LZ4HC_optTable_t* opt, int pos, int litlen, int price)
+{
+    opt->mlen[pos] = 1;
+    opt->off[pos] = 0;
+    opt->litlen[pos] = litlen;
+    opt->price[pos] = price;
+}
+
+/* AOCL_LZ4HC_setMatchPrices() :
+ * Records the match of length matchML found at position cur for each length
+ * ml in [MINMATCH, matchML], when position cur+ml is past storeAbove or when
+ * basePrice plus the match length price improves on its current price by at
+ * least favor. This is the price update loop of LZ4HC_compress_optimal(). */
+LZ4_FORCE_INLINE void AOCL_LZ4HC_setMatchPrices(AOCL_LZ4HC_optTable_t* opt,
+    int cur, int matchML, int offset, int ll, int basePrice,
+    int storeAbove, int favor)
+{
+    int ml;
+    for (ml = MINMATCH; ml <= matchML; ml++) {
+        int const pos = cur + ml;
+        int const price = basePrice + AOCL_LZ4HC_matchLengthPrice(ml);
+        if (pos > storeAbove || price <= opt->price[pos] - favor) {
+            opt->mlen[pos] = ml;
+            opt->off[pos] = offset;
+            opt->litlen[pos] = ll;
+            opt->price[pos] = price;
+        }
+    }
+}
+
+#ifdef AOCL_LZ4_AVX2_OPT
+/* AVX2 variant of AOCL_LZ4HC_setMatchPrices(), handling 8 match lengths per
+ * iteration with masked stores */
+__attribute__((__target__("avx2"))) static void
+AOCL_LZ4HC_setMatchPrices_avx2(AOCL_LZ4HC_optTable_t* opt,
+    int cur, int matchML, int offset, int ll, int basePrice,
+    int storeAbove, int favor)
+{
+    __m256i const vBase = _mm256_set1_epi32(basePrice);
+    __m256i const vOff = _mm256_set1_epi32(offset);
+    __m256i const vLl = _mm256_set1_epi32(ll);
+    __m256i const vAbove = _mm256_set1_epi32(storeAbove - cur);
+    __m256i const vFavor = _mm256_set1_epi32(favor);
+    __m256i const vEnd = _mm256_set1_epi32(matchML + 1);
+    __m256i const vMlBase = _mm256_set1_epi32((int)(ML_MASK+MINMATCH));
+    __m256i const vDiv255 = _mm256_set1_epi32(0x8081);   /* x/255 == (x*0x8081)>>23 for x < 66299 */
+    __m256i const vOne = _mm256_set1_epi32(1);
+    __m256i vMl = _mm256_setr_epi32(MINMATCH, MINMATCH+1, MINMATCH+2, MINMATCH+3,
+                                    MINMATCH+4, MINMATCH+5, MINMATCH+6, MINMATCH+7);
+    int ml;
+    assert(matchML < LZ4_OPT_NUM);
+    for (ml = MINMATCH; ml <= matchML; ml += 8) {
+        int const pos = cur + ml;
+        /* length price : 1 + (ml-19)/255 for ml >= 19 */
+        __m256i const vLong = _mm256_cmpgt_epi32(vMl, _mm256_sub_epi32(vMlBase, vOne));
+        __m256i const vExtra = _mm256_add_epi32(vOne, _mm256_srli_epi32(
+            _mm256_mullo_epi32(_mm256_sub_epi32(vMl, vMlBase), vDiv255), 23));
+        __m256i const vPrice = _mm256_add_epi32(vBase, _mm256_and_si256(vLong, vExtra));
+        __m256i const vOld = _mm256_loadu_si256((const __m256i*)(opt->price + pos));
+        __m256i const vKeep = _mm256_andnot_si256(_mm256_cmpgt_epi32(vMl, vAbove),
+            _mm256_cmpgt_epi32(vPrice, _mm256_sub_epi32(vOld, vFavor)));
+        __m256i const vMask = _mm256_andnot_si256(vKeep, _mm256_cmpgt_epi32(vEnd, vMl));
+        _mm256_maskstore_epi32(opt->mlen + pos, vMask, vMl);
+        _mm256_maskstore_epi32(opt->off + pos, vMask, vOff);
+        _mm256_maskstore_epi32(opt->litlen + pos, vMask, vLl);
+        _mm256_maskstore_epi32(opt->price + pos, vMask, vPrice);
+        vMl = _mm256_add_epi32(vMl, _mm256_set1_epi32(8));
+    }
+}
+#endif
+
+/* Reads the head of the hash chain of ip and prefetches the data of its first
+ * candidate, ahead of the search at ip */
+LZ4_FORCE_INLINE void AOCL_LZ4HC_prefetchCandidate(const LZ4HC_CCtx_internal* ctx, const BYTE* ip)
+{
+    U32 const matchIndex = ctx->hashTable[LZ4HC_CTX_HASHPTR(ctx, ip)];
+    AOCL_LZ4HC_PREFETCH(ctx->base + matchIndex);
+}
+
+#ifdef AOCL_LZ4HC_RUN_PRESCAN
+/* Positions inside runs at least this long are not searched */
+#ifndef AOCL_LZ4HC_LONG_RUN
+#define AOCL_LZ4HC_LONG_RUN 64
+#endif
+
+/* AOCL_LZ4HC_runLength() :
+ * Pre-scan run before the chain search of ip. If the 4 bytes at ip repeat the
+ * 4 bytes before it, ip is inside a run of a pattern of length 1, 2 or 4,
+ * which matches at offset 4 up to the end of the run.
+ * @return : the length of that match, or 0 if ip is not inside a run.
+ * lowPtr is the lowest position the match may reference. */
+LZ4_FORCE_INLINE int AOCL_LZ4HC_runLength(const BYTE* const ip, const BYTE* const lowPtr,
+                                          const BYTE* const iHighLimit)
+{
+    U32 const pattern = LZ4_read32(ip);
+    if (ip < lowPtr + 4 || LZ4_read32(ip - 4) != pattern) return 0;
+    return (int)LZ4HC_COUNT_PATTERN(ip + 4, iHighLimit, pattern) + 4;
+}
+#endif
+
+/* AOCL_LZ4HC_compress_optimal_internal() :
+ * Same parsing as LZ4HC_compress_optimal(), with the price table stored as
+ * AOCL_LZ4HC_optTable_t. The price of a match is split into a part constant
+ * over the match, computed once, and AOCL_LZ4HC_matchLengthPrice(), so that
+ * the update over all its lengths can be vectorized when useAVX2 is set.
+ * The first candidate of the next position is prefetched while the current
+ * one is searched.
+ * With AOCL_LZ4HC_RUN_PRESCAN, a position inside a run of at least
+ * AOCL_LZ4HC_LONG_RUN bytes takes the match of the run in place of a chain
+ * search. The output then differs from LZ4HC_compress_optimal(). */
+LZ4_FORCE_INLINE int AOCL_LZ4HC_compress_optimal_internal(LZ4HC_CCtx_internal* ctx,
+                                    const char* const source,
+                                    char* dst,
+                                    int* srcSizePtr,
+                                    int dstCapacity,
+                                    int const nbSearches,
+                                    size_t sufficient_len,
+                                    const limitedOutput_directive limit,
+                                    int const fullUpdate,
+                                    const dictCtx_directive dict,
+                                    const HCfavor_e favorDecSpeed,
+                                    int const useAVX2)
+{
+    int retval = 0;
+#ifdef LZ4HC_HEAPMODE
+    AOCL_LZ4HC_optTable_t* const opt = (AOCL_LZ4HC_optTable_t*)ALLOC(sizeof(AOCL_LZ4HC_optTable_t));
+#else
+    AOCL_LZ4HC_optTable_t optTable;   /* ~64 KB, which is a bit large for stack... */
+    AOCL_LZ4HC_optTable_t* const opt = &optTable;
+#endif
+
+    const BYTE* ip = (const BYTE*) source;
+    const BYTE* anchor = ip;
+    const BYTE* const iend = ip + *srcSizePtr;
+    const BYTE* const mflimit = iend - MFLIMIT;
+    const BYTE* const matchlimit = iend - LASTLITERALS;
+    BYTE* op = (BYTE*) dst;
+    BYTE* opSaved = (BYTE*) dst;
+    BYTE* oend = op + dstCapacity;
+    int ovml = MINMATCH;  /* overflow - last sequence */
+    const BYTE* ovref = NULL;
+#ifdef AOCL_LZ4HC_RUN_PRESCAN
+    const BYTE* const prefixPtr = ctx->base + ctx->dictLimit;
+    int runML;
+#endif
+
+    /* init */
+#ifdef LZ4HC_HEAPMODE
+    if (opt == NULL) goto _return_label;
+#endif
+    DEBUGLOG(5, "AOCL_LZ4HC_compress_optimal(dst=%p, dstCapa=%u)", dst, (unsigned)dstCapacity);
+    *srcSizePtr = 0;
+    if (limit == fillOutput) oend -= LASTLITERALS;   /* Hack for support LZ4 format restriction */
+    if (sufficient_len >= LZ4_OPT_NUM) sufficient_len = LZ4_OPT_NUM-1;
+
+    /* Main Loop */
+    while (ip <= mflimit) {
+         int const llen = (int)(ip - anchor);
+         int best_mlen, best_off;
+         int cur, last_match_pos = 0;
+         LZ4HC_match_t firstMatch;
+
+         AOCL_LZ4HC_prefetchCandidate(ctx, ip + 1);
+#ifdef AOCL_LZ4HC_RUN_PRESCAN
+         /* offsets below 8 are not searched when favoring decompression speed */
+         runML = favorDecSpeed ? 0 : AOCL_LZ4HC_runLength(ip, prefixPtr, matchlimit);
+         if (runML >= AOCL_LZ4HC_LONG_RUN) {
+             firstMatch.len = runML;
+             firstMatch.off = 4;
+         } else
+#endif
+         firstMatch = LZ4HC_FindLongerMatch(ctx, ip, matchlimit, MINMATCH-1, nbSearches, dict, favorDecSpeed);
+         if (firstMatch.len==0) { ip++; continue; }
+
+         if ((size_t)firstMatch.len > sufficient_len) {
+             /* good enough solution : immediate encoding */
+             int const firstML = firstMatch.len;
+             const BYTE* const matchPos = ip - firstMatch.off;
+             opSaved = op;
+             if ( LZ4HC_encodeSequence(UPDATABLE(ip, op, anchor), firstML, matchPos, limit, oend) ) {  /* updates ip, op and anchor */
+                 ovml = firstML;
+                 ovref = matchPos;
+                 goto _dest_overflow;
+             }
+             continue;
+         }
+
+         /* set prices for first positions (literals) */
+         {   int rPos;
+             for (rPos = 0 ; rPos < MINMATCH ; rPos++)
+                 AOCL_LZ4HC_setLiteral(opt, rPos, llen + rPos, LZ4HC_literalsPrice(llen + rPos));
+         }
+         /* set prices using initial match */
+         assert(firstMatch.len < LZ4_OPT_NUM);   /* necessarily < sufficient_len < LZ4_OPT_NUM */
+         {   int const basePrice = 1 + 2 + LZ4HC_literalsPrice(llen);
+#ifdef AOCL_LZ4_AVX2_OPT
+             if (useAVX2)
+                 AOCL_LZ4HC_setMatchPrices_avx2(opt, 0, firstMatch.len, firstMatch.off, llen, basePrice, 0, 0);
+             else
+#endif
+                 AOCL_LZ4HC_setMatchPrices(opt, 0, firstMatch.len, firstMatch.off, llen, basePrice, 0, 0);
+         }
+         last_match_pos = firstMatch.len;
+         {   int addLit;
+             for (addLit = 1; addLit <= TRAILING_LITERALS; addLit ++)
+                 AOCL_LZ4HC_setLiteral(opt, last_match_pos+addLit, addLit,
+                                       opt->price[last_match_pos] + LZ4HC_literalsPrice(addLit));
+         }
+
+         /* check further positions */
+         for (cur = 1; cur < last_match_pos; cur++) {
+             const BYTE* const curPtr = ip + cur;
+             LZ4HC_match_t newMatch;
+
+             if (curPtr > mflimit) break;
+             if (fullUpdate) {
+                 /* not useful to search here if next position has same (or lower) cost */
+                 if ( (opt->price[cur+1] <= opt->price[cur])
+                   /* in some cases, next position has same cost, but cost rises sharply after, so a small match would still be beneficial */
+                   && (opt->price[cur+MINMATCH] < opt->price[cur] + 3/*min seq price*/) )
+                     continue;
+             } else {
+                 /* not useful to search here if next position has same (or lower) cost */
+                 if (opt->price[cur+1] <= opt->price[cur]) continue;
+             }
+
+             AOCL_LZ4HC_prefetchCandidate(ctx, curPtr + 1);
+#ifdef AOCL_LZ4HC_RUN_PRESCAN
+             runML = favorDecSpeed ? 0 : AOCL_LZ4HC_runLength(curPtr, prefixPtr, matchlimit);
+             if (runML >= AOCL_LZ4HC_LONG_RUN) {
+                 newMatch.len = runML;
+                 newMatch.off = 4;
+             } else
+#endif
+             if (fullUpdate)
+                 newMatch = LZ4HC_FindLongerMatch(ctx, curPtr, matchlimit, MINMATCH-1, nbSearches, dict, favorDecSpeed);
+             else
+                 /* only test matches of minimum length; slightly faster, but misses a few bytes */
+                 newMatch = LZ4HC_FindLongerMatch(ctx, curPtr, matchlimit, last_match_pos - cur, nbSearches, dict, favorDecSpeed);
+             if (!newMatch.len) continue;
+
+             if ( ((size_t)newMatch.len > sufficient_len)
+               || (newMatch.len + cur >= LZ4_OPT_NUM) ) {
+                 /* immediate encoding */
+                 best_mlen = newMatch.len;
+                 best_off = newMatch.off;
+                 last_match_pos = cur + 1;
+                 goto encode;
+             }
+
+             /* before match : set price with literals at beginning */
+             {   int const baseLitlen = opt->litlen[cur];
+                 int const basePrice = opt->price[cur] - LZ4HC_literalsPrice(baseLitlen);
+                 int litlen;
+                 for (litlen = 1; litlen < MINMATCH; litlen++) {
+                     int const price = basePrice + LZ4HC_literalsPrice(baseLitlen+litlen);
+                     int const pos = cur + litlen;
+                     if (price < opt->price[pos])
+                         AOCL_LZ4HC_setLiteral(opt, pos, baseLitlen+litlen, price);
+             }   }
+
+             /* set prices using match at position = cur */
+             {   int const matchML = newMatch.len;
+                 int const lastPos = cur + matchML;
+                 int const storeAbove = last_match_pos + TRAILING_LITERALS;
+                 int ll, basePrice;
+
+                 assert(cur + newMatch.len < LZ4_OPT_NUM);
+                 assert((U32)favorDecSpeed <= 1);
+                 if (opt->mlen[cur] == 1) {
+                     ll = opt->litlen[cur];
+                     basePrice = (cur > ll) ? opt->price[cur - ll] : 0;
+                 } else {
+                     ll = 0;
+                     basePrice = opt->price[cur];
+                 }
+                 basePrice += 1 + 2 + LZ4HC_literalsPrice(ll);
+
+                 /* the last position of the match extends the parsed range if it is stored */
+                 if ( (last_match_pos < lastPos)
+                   && (lastPos > storeAbove
+                    || basePrice + AOCL_LZ4HC_matchLengthPrice(matchML) <= opt->price[lastPos] - (int)favorDecSpeed) )
+                     last_match_pos = lastPos;
+#ifdef AOCL_LZ4_AVX2_OPT
+                 if (useAVX2)
+                     AOCL_LZ4HC_setMatchPrices_avx2(opt, cur, matchML, newMatch.off, ll, basePrice, storeAbove, (int)favorDecSpeed);
+                 else
+#endif
+                     AOCL_LZ4HC_setMatchPrices(opt, cur, matchML, newMatch.off, ll, basePrice, storeAbove, (int)favorDecSpeed);
+             }
+             /* complete following positions with literals */
+             {   int addLit;
+                 for (addLit = 1; addLit <= TRAILING_LITERALS; addLit ++)
+                     AOCL_LZ4HC_setLiteral(opt, last_match_pos+addLit, addLit,
+                                           opt->price[last_match_pos] + LZ4HC_literalsPrice(addLit));
+             }
+         }  /* for (cur = 1; cur <= last_match_pos; cur++) */
+
+         assert(last_match_pos < LZ4_OPT_NUM + TRAILING_LITERALS);
+         best_mlen = opt->mlen[last_match_pos];
+         best_off = opt->off[last_match_pos];
+         cur = last_match_pos - best_mlen;
+
+encode: /* cur, last_match_pos, best_mlen, best_off must be set */
+         assert(cur < LZ4_OPT_NUM);
+         assert(last_match_pos >= 1);  /* == 1 when only one candidate */
+         {   int candidate_pos = cur;
+             int selected_matchLength = best_mlen;
+             int selected_offset = best_off;
+             while (1) {  /* from end to beginning */
+                 int const next_matchLength = opt->mlen[candidate_pos];  /* can be 1, means literal */
+                 int const next_offset = opt->off[candidate_pos];
+                 opt->mlen[candidate_pos] = selected_matchLength;
+                 opt->off[candidate_pos] = selected_offset;
+                 selected_matchLength = next_matchLength;
+                 selected_offset = next_offset;
+                 if (next_matchLength > candidate_pos) break; /* last match elected, first match to encode */
+                 assert(next_matchLength > 0);  /* can be 1, means literal */
+                 candidate_pos -= next_matchLength;
+         }   }
+
+         /* encode all recorded sequences in order */
+         {   int rPos = 0;  /* relative position (to ip) */
+             while (rPos < last_match_pos) {
+                 int const ml = opt->mlen[rPos];
+                 int const offset = opt->off[rPos];
+                 if (ml == 1) { ip++; rPos++; continue; }  /* literal; note: can end up with several literals, in which case, skip them */
+                 rPos += ml;
+                 assert(ml >= MINMATCH);
+                 assert((offset >= 1) && (offset <= LZ4_DISTANCE_MAX));
+                 opSaved = op;
+                 if ( LZ4HC_encodeSequence(UPDATABLE(ip, op, anchor), ml, ip - offset, limit, oend) ) {  /* updates ip, op and anchor */
+                     ovml = ml;
+                     ovref = ip - offset;
+                     goto _dest_overflow;
+         }   }   }
+     }  /* while (ip <= mflimit) */
+
+_last_literals:
+     /* Encode Last Literals */
+     {   size_t lastRunSize = (size_t)(iend - anchor);  /* literals */
+         size_t llAdd = (lastRunSize + 255 - RUN_MASK) / 255;
+         size_t const totalSize = 1 + llAdd + lastRunSize;
+         if (limit == fillOutput) oend += LASTLITERALS;  /* restore correct value */
+         if (limit && (op + totalSize > oend)) {
+             if (limit == limitedOutput) { /* Check output limit */
+                retval = 0;
+                goto _return_label;
+             }
+             /* adapt lastRunSize to fill 'dst' */
+             lastRunSize  = (size_t)(oend - op) - 1 /*token*/;
+             llAdd = (lastRunSize + 256 - RUN_MASK) / 256;
+             lastRunSize -= llAdd;
+         }
+         ip = anchor + lastRunSize; /* can be != iend if limit==fillOutput */
+
+         if (lastRunSize >= RUN_MASK) {
+             size_t accumulator = lastRunSize - RUN_MASK;
+             *op++ = (RUN_MASK << ML_BITS);
+             for(; accumulator >= 255 ; accumulator -= 255) *op++ = 255;
+             *op++ = (BYTE) accumulator;
+         } else {
+             *op++ = (BYTE)(lastRunSize << ML_BITS);
+         }
+         memcpy(op, anchor, lastRunSize);
+         op += lastRunSize;
+     }
+
+     /* End */
+     *srcSizePtr = (int) (((const char*)ip) - source);
+     retval = (int) ((char*)op-dst);
+     goto _return_label;
+
+_dest_overflow:
+if (limit == fillOutput) {
+     /* Assumption : ip, anchor, ovml and ovref must be set correctly */
+     size_t const ll = (size_t)(ip - anchor);
+     size_t const ll_addbytes = (ll + 240) / 255;
+     size_t const ll_totalCost = 1 + ll_addbytes + ll;
+     BYTE* const maxLitPos = oend - 3; /* 2 for offset, 1 for token */
+     op = opSaved;  /* restore correct out pointer */
+     if (op + ll_totalCost <= maxLitPos) {
+         /* ll validated; now adjust match length */
+         size_t const bytesLeftForMl = (size_t)(maxLitPos - (op+ll_totalCost));
+         size_t const maxMlSize = MINMATCH + (ML_MASK-1) + (bytesLeftForMl * 255);
+         assert(maxMlSize < INT_MAX); assert(ovml >= 0);
+         if ((size_t)ovml > maxMlSize) ovml = (int)maxMlSize;
+         if ((oend + LASTLITERALS) - (op + ll_totalCost + 2) - 1 + ovml >= MFLIMIT) {
+             LZ4HC_encodeSequence(UPDATABLE(ip, op, anchor), ovml, ovref, notLimited, oend);
+     }   }
+     goto _last_literals;
+}
+_return_label:
+#ifdef LZ4HC_HEAPMODE
+     FREEMEM(opt);
+#endif
+     return retval;
+}
+
+static int AOCL_LZ4HC_compress_optimal(LZ4HC_CCtx_internal* ctx,
+    const char* const source, char* dst,
+    int* srcSizePtr, int dstCapacity,
+    int const nbSearches, size_t sufficient_len,
+    const limitedOutput_directive limit, int const fullUpdate,
+    const dictCtx_directive dict,
+    const HCfavor_e favorDecSpeed)
+{
+    return AOCL_LZ4HC_compress_optimal_internal(ctx, source, dst, srcSizePtr, dstCapacity,
+        nbSearches, sufficient_len, limit, fullUpdate, dict, favorDecSpeed, 0);
+}
+
+#ifdef AOCL_LZ4_AVX2_OPT
+__attribute__((__target__("avx2"))) static int AOCL_LZ4HC_compress_optimal_avx2(LZ4HC_CCtx_internal* ctx,
+    const char* const source, char* dst,
+    int* srcSizePtr, int dstCapacity,
+    int const nbSearches, size_t sufficient_len,
+    const limitedOutput_directive limit, int const fullUpdate,
+    const dictCtx_directive dict,
+    const HCfavor_e favorDecSpeed)
+{
+    return AOCL_LZ4HC_compress_optimal_internal(ctx, source, dst, srcSizePtr, dstCapacity,
+        nbSearches, sufficient_len, limit, fullUpdate, dict, favorDecSpeed, 1);
+}
+#endif
+#endif /* AOCL_LZ4HC_OPT */
+
 #ifdef AOCL_DYNAMIC_DISPATCHER
 static void aocl_register_lz4hc_fmv(int optOff, int optLevel) {
     if (optOff)
     {
         LZ4HC_countBack_fp = LZ4HC_countBack;
+        LZ4HC_countPattern_fp = LZ4HC_countPattern;
+        LZ4HC_reverseCountPattern_fp = LZ4HC_reverseCountPattern;
         LZ4HC_compress_hashChain_fp = LZ4HC_compress_hashChain;
+        LZ4HC_compress_optimal_fp = LZ4HC_compress_optimal;
     }
     else
     {
@@ -2112,10 +2820,31 @@ static void aocl_register_lz4hc_fmv(int optOff, int optLevel) {
         case 0://C version
         case 1://SSE version
         case 2://AVX version
+            LZ4HC_countBack_fp = AOCL_LZ4HC_countBack;
+            LZ4HC_countPattern_fp = LZ4HC_countPattern;
+            LZ4HC_reverseCountPattern_fp = LZ4HC_reverseCountPattern;
+            LZ4HC_compress_hashChain_fp = AOCL_LZ4HC_compress_hashChain;
+            LZ4HC_compress_optimal_fp = AOCL_LZ4HC_compress_optimal;
+            break;
         case 3://AVX2 version
         default://AVX512 and other versions
             LZ4HC_countBack_fp = AOCL_LZ4HC_countBack;
             LZ4HC_compress_hashChain_fp = AOCL_LZ4HC_compress_hashChain;
+#ifdef AOCL_LZ4_AVX2_OPT
+            LZ4HC_countPattern_fp = AOCL_LZ4HC_countPattern_avx2;
+            LZ4HC_reverseCountPattern_fp = AOCL_LZ4HC_reverseCountPattern_avx2;
+            LZ4HC_compress_optimal_fp = AOCL_LZ4HC_compress_optimal_avx2;
+#else
+            LZ4HC_countPattern_fp = LZ4HC_countPattern;
+            LZ4HC_reverseCountPattern_fp = LZ4HC_reverseCountPattern;
+            LZ4HC_compress_optimal_fp = AOCL_LZ4HC_compress_optimal;
+#endif
+#ifdef AOCL_LZ4_AVX512_OPT
+            if (optLevel >= 4) {
+                LZ4HC_countPattern_fp = AOCL_LZ4HC_countPattern_avx512;
+                LZ4HC_reverseCountPattern_fp = AOCL_LZ4HC_reverseCountPattern_avx512;
+            }
+#endif
             break;
         }
     }
@@ -163,6 +163,50 @@ LZ4LIB_API int LZ4_compress_HC_destSize(void* stateHC,
                                   const char* src, char* dst,
                                         int* srcSizePtr, int targetDstSize,
                                         int compressionLevel);
+
+#ifdef AOCL_LZ4HC_OPT
+/*!
+ *  @brief Hash table size suited to an input of `srcSize` bytes, for AOCL_LZ4_compress_HC_extStateHC_sized().
+ *
+ *  |Parameters|Direction|Description|
+ *  |:---------|:-------:|:----------|
+ *  | \b srcSize | in | Size of the input. 0 when unknown. |
+ *
+ *  @return log2 of the number of hash table entries: about one entry per input position,
+ *  between LZ4HC_HASH_LOG_MIN and LZ4HC_HASH_LOG. LZ4HC_HASH_LOG when `srcSize` is 0.
+ */
+LZ4LIB_API int AOCL_LZ4HC_hashLogForSize(int srcSize);
+
+/*!
+ *  @brief Same as LZ4_compress_HC_extStateHC(), but only uses the first 2^`hashLog` entries of the hash table of `state`.
+ *
+ *  |Parameters|Direction|Description|
+ *  |:---------|:-------:|:----------|
+ *  | \b stateHC          | in,out | It acts as a handle for compression. It does not need to be initialized. |
+ *  | \b src              |  in    | Source buffer, the data which you want to compress is copied/or pointed here.|
+ *  | \b dst              |  out   | Destination buffer, compressed data is kept here, memory should be allocated already.|
+ *  | \b srcSize          |  in    | Size of buffer `src`. Maximum supported value is LZ4_MAX_INPUT_SIZE.|
+ *  | \b dstCapacity      |  in    | Size of buffer `dst` (which must be already allocated).|
+ *  | \b compressionLevel |  in    | It is used to set the correct context level for compression. |
+ *  | \b hashLog          |  in    | log2 of the hash table entries to use, between LZ4HC_HASH_LOG_MIN and LZ4HC_HASH_LOG. |
+ *
+ *  @return
+ *  | Result | Description |
+ *  |:-------|:------------|
+ *  | success| The number of bytes written into `dst` |
+ *  | Fail   |  0, or -1 if `stateHC` or `dst` is NULL, or `src` is NULL with a nonzero `srcSize` |
+ *
+ *  @note Only the hash entries in use are cleared, and chain entries are only touched for the
+ *  positions of `src`. The memory touched by a call is then proportional to `srcSize` instead of
+ *  LZ4_sizeofStateHC(), which dominates the run time of small inputs.
+ *  AOCL_LZ4HC_hashLogForSize() gives a suitable `hashLog`; smaller values trade ratio for speed.
+ *  The output is a regular LZ4 block.
+ *  @note `state` size is provided by LZ4_sizeofStateHC().
+ */
+LZ4LIB_API int AOCL_LZ4_compress_HC_extStateHC_sized(void* stateHC, const char* src, char* dst,
+                                        int srcSize, int dstCapacity,
+                                        int compressionLevel, int hashLog);
+#endif
 /**
  * @}
 */
@@ -394,6 +438,14 @@ LZ4LIB_API int Test_LZ4HC_countBack(const LZ4_byte* const ip, const LZ4_byte* co
                     
 LZ4LIB_API int Test_AOCL_LZ4HC_countBack(const LZ4_byte* const ip, const LZ4_byte* const match,
                     const LZ4_byte* const iMin, const LZ4_byte* const mMin);
+
+LZ4LIB_API unsigned Test_LZ4HC_countPattern(const LZ4_byte* ip, const LZ4_byte* const iEnd, unsigned const pattern32);
+
+LZ4LIB_API unsigned Test_AOCL_LZ4HC_countPattern(const LZ4_byte* ip, const LZ4_byte* const iEnd, unsigned const pattern32);
+
+LZ4LIB_API unsigned Test_LZ4HC_reverseCountPattern(const LZ4_byte* ip, const LZ4_byte* const iLow, unsigned pattern);
+
+LZ4LIB_API unsigned Test_AOCL_LZ4HC_reverseCountPattern(const LZ4_byte* ip, const LZ4_byte* const iLow, unsigned pattern);
 #endif
 
 
@@ -417,6 +469,7 @@ LZ4LIB_API int Test_AOCL_LZ4HC_countBack(const LZ4_byte* const ip, const LZ4_byt
 #define LZ4HC_HASH_LOG 15
 #define LZ4HC_HASHTABLESIZE (1 << LZ4HC_HASH_LOG)
 #define LZ4HC_HASH_MASK (LZ4HC_HASHTABLESIZE - 1)
+#define LZ4HC_HASH_LOG_MIN 10
 
 
 typedef struct LZ4HC_CCtx_internal LZ4HC_CCtx_internal;
@@ -435,6 +488,7 @@ struct LZ4HC_CCtx_internal
     LZ4_i8    favorDecSpeed;   /**< Favor decompression speed if this flag set,
                                   otherwise, favor compression ratio */
     LZ4_i8    dirty;           /**< Stream has to be fully reset if this flag is set */
+    LZ4_i8    hashLog;         /**< log2 of the hash table entries in use, 0 for LZ4HC_HASH_LOG */
     const LZ4HC_CCtx_internal* dictCtx; /**< Current context of dictionary */
 };
 
@@ -1875,6 +1875,35 @@ bool RawUncompress(Source* compressed, char* uncompressed) {
 }
 #endif
 
+bool AOCL_RawUncompressSafe(const char* compressed, size_t compressed_length,
+                            char* uncompressed, size_t uncompressed_capacity,
+                            size_t* uncompressed_length, bool validate) {
+  // sanity checks ------------------------------------------------------------
+     size_t ulength;
+     if (uncompressed_length == NULL) return false;
+     if (!GetUncompressedLength(compressed, compressed_length, &ulength)) return false;
+     if (ulength > uncompressed_capacity) return false;
+     if (ulength != 0 && uncompressed == NULL) return false;
+  // sanity checks ------------------------------------------------------------
+
+  if (validate && !IsValidCompressedBuffer(compressed, compressed_length))
+    return false;
+
+  // The writers never go past the length read from the header, which fits.
+#ifdef AOCL_DYNAMIC_DISPATCHER
+  if (!SNAPPY_SAW_raw_uncompress_fp(compressed, compressed_length, uncompressed))
+    return false;
+#elif defined(AOCL_SNAPPY_OPT)
+  if (!AOCL_SAW_RawUncompress(compressed, compressed_length, uncompressed))
+    return false;
+#else
+  if (!SAW_RawUncompress(compressed, compressed_length, uncompressed))
+    return false;
+#endif
+  *uncompressed_length = ulength;
+  return true;
+}
+
 bool Uncompress(const char* compressed, size_t compressed_length,
                 std::string* uncompressed) {
   size_t ulength;
@@ -280,6 +280,39 @@ namespace snappy {
  SNAPPYLIB_API bool RawUncompress(const char* compressed, size_t compressed_length,
                      char* uncompressed);
 
+  /**
+   * @brief 
+   * Bounds-checked version of RawUncompress(), for compressed data that
+   * may not come from Compress(). The uncompressed length read from the
+   * header of "compressed[]" is checked against "uncompressed_capacity"
+   * before anything is written, and no byte past
+   * uncompressed[0..uncompressed_capacity-1] is ever written.
+   *
+   * With "validate", the whole of "compressed[]" is checked by
+   * IsValidCompressedBuffer() first, so that invalid data leaves
+   * "uncompressed" untouched. Without it, invalid data is still detected,
+   * but part of "uncompressed" may have been written.
+   *
+   *  |Parameters                |Direction| Description                                                     |
+   *  |:-------------------------|:-------:|:----------------------------------------------------------------|
+   *  | \b compressed            |  in     | This is a buffer which contains compressed data.                |
+   *  | \b compressed_length     |  in     | This is the length of the compressed buffer.                    |
+   *  | \b uncompressed          |  out    | Uncompressed data is stored in this buffer.                     |
+   *  | \b uncompressed_capacity |  in     | This is the size of the uncompressed buffer.                    |
+   *  | \b uncompressed_length   |  out    | Length of the uncompressed data, written only on success.       |
+   *  | \b validate              |  in     | Check the whole compressed buffer before decompressing it.      |
+   *
+   *  @return
+   *  |Result | Description                                                                            |
+   *  |:------|:---------------------------------------------------------------------------------------|
+   *  |Success|Returns \b true if successful.                                                          |
+   *  |Failure|Returns \b false if the data is corrupted, or does not fit in "uncompressed_capacity".  |
+   */
+
+ SNAPPYLIB_API bool AOCL_RawUncompressSafe(const char* compressed, size_t compressed_length,
+                     char* uncompressed, size_t uncompressed_capacity,
+                     size_t* uncompressed_length, bool validate);
+
   /**
    * @brief 
    * Given data from the byte source 'compressed' generated by calling
@@ -120,6 +120,9 @@ local block_state aocl_deflate_fast_v1(deflate_state *s, int flush);
 local block_state aocl_deflate_fast_v2(deflate_state *s, int flush);
 local block_state aocl_deflate_slow_v1(deflate_state *s, int flush);
 local block_state aocl_deflate_slow_v2(deflate_state *s, int flush);
+local block_state aocl_deflate_rle_v1(deflate_state *s, int flush);
+local block_state aocl_deflate_rle_v2(deflate_state *s, int flush);
+local block_state aocl_deflate_huff(deflate_state *s, int flush);
 extern block_state deflate_medium(deflate_state *s, int flush);
 #ifdef AOCL_ZLIB_DEFLATE_FAST_MODE_3
 block_state (*aocl_deflate_lvl1_fp)(deflate_state *s, int flush) = deflate_fast;
@@ -288,6 +291,7 @@ static int (*aocl_deflateSetDictionary_fp) (z_streamp strm, const Bytef *diction
 static void (*aocl_fill_window_fp) (deflate_state *s) = aocl_fill_window_v1;
 static block_state (*aocl_deflate_fast_fp)(deflate_state *s, int flush) = aocl_deflate_fast_v1;
 static block_state (*aocl_deflate_slow_fp)(deflate_state *s, int flush) = aocl_deflate_slow_v1;
+static block_state (*aocl_deflate_rle_fp)(deflate_state *s, int flush) = aocl_deflate_rle_v1;
 
 ZEXTERN char * ZEXPORT aocl_setup_deflate_fmv(int optOff, int optLevel, int insize,
     int level, int windowLog)
@@ -322,6 +326,11 @@ ZEXTERN char * ZEXPORT aocl_setup_deflate_fmv(int optOff, int optLevel, int insi
 #endif
     }
 
+    if (LIKELY(optOff == 0 && optLevel > 2))
+        aocl_deflate_rle_fp = aocl_deflate_rle_v2;
+    else
+        aocl_deflate_rle_fp = aocl_deflate_rle_v1;
+
     aocl_register_slide_hash_fmv(optOff, optLevel, slide_hash);
     aocl_register_longest_match_fmv(optOff, optLevel, longest_match);
     return NULL;
@@ -475,6 +484,10 @@ else
 #endif /* AOCL_ZLIB_DEFLATE_FAST_MODE_2 */
     s->strategy = strategy;
     s->method = (Byte)method;
+#ifdef AOCL_ZLIB_OPT
+    s->rsync_mask = 0;
+    s->rsync_min = 0;
+#endif
 
     return deflateReset(strm);
 }
@@ -595,7 +608,7 @@ int ZEXPORT deflateSetDictionary (strm, dictionary, dictLength)
 local int aocl_deflateSetDictionary_v1 (z_streamp strm, const Bytef *dictionary, uInt  dictLength)
 {
     deflate_state *s;
-    uInt str, n;
+    uInt n;
     int wrap;
     unsigned avail;
     z_const unsigned char *next;
@@ -631,17 +644,9 @@ local int aocl_deflateSetDictionary_v1 (z_streamp strm, const Bytef *dictionary,
     strm->next_in = (z_const Bytef *)dictionary;
     aocl_fill_window_v1(s);
     while (s->lookahead >= MIN_MATCH) {
-        str = s->strstart;
         n = s->lookahead - (MIN_MATCH-1);
-        do {
-            UPDATE_HASH(s, s->ins_h, s->window[str + MIN_MATCH-1]);
-#ifndef FASTEST
-            s->prev[str & s->w_mask] = s->head[s->ins_h];
-#endif
-            s->head[s->ins_h] = (Pos)str;
-            str++;
-        } while (--n);
-        s->strstart = str;
+        aocl_insert_string_v1(s, s->strstart, n);
+        s->strstart += n;
         s->lookahead = MIN_MATCH-1;
         aocl_fill_window_v1(s);
     }
@@ -661,7 +666,7 @@ __attribute__((__target__("avx"))) // uses SSE4.2 intrinsics
 local int aocl_deflateSetDictionary_v2 (z_streamp strm, const Bytef *dictionary, uInt  dictLength)
 {
     deflate_state *s;
-    uInt str, n;
+    uInt n;
     int wrap;
     unsigned avail;
     z_const unsigned char *next;
@@ -697,17 +702,9 @@ local int aocl_deflateSetDictionary_v2 (z_streamp strm, const Bytef *dictionary,
     strm->next_in = (z_const Bytef *)dictionary;
     aocl_fill_window_v2(s);
     while (s->lookahead >= MIN_MATCH) {
-        str = s->strstart;
         n = s->lookahead - (MIN_MATCH-1);
-        do {
-            UPDATE_HASH_CRC(s, s->ins_h, s->window[str + MIN_MATCH-1]);
-#ifndef FASTEST
-            s->prev[str & s->w_mask] = s->head[s->ins_h];
-#endif
-            s->head[s->ins_h] = (Pos)str;
-            str++;
-        } while (--n);
-        s->strstart = str;
+        aocl_insert_string_v2(s, s->strstart, n);
+        s->strstart += n;
         s->lookahead = MIN_MATCH-1;
         aocl_fill_window_v2(s);
     }
@@ -790,6 +787,14 @@ int ZEXPORT deflateResetKeep (strm)
         adler32(0L, Z_NULL, 0);
 #endif
     s->last_flush = Z_NO_FLUSH;
+#ifdef AOCL_ZLIB_OPT
+    s->rsync_hash = 0;
+    s->rsync_len = 0;
+    s->rsync_ahead = 0;
+    s->rsync_chunk = 0;
+    s->rsync_flushing = 0;
+    s->rsync_busy = 0;
+#endif
 
     _tr_init(s);
 
@@ -866,7 +871,11 @@ int ZEXPORT deflatePrime (strm, bits, value)
         put = Buf_size - s->bi_valid;
         if (put > bits)
             put = bits;
+#ifdef AOCL_ZLIB_OPT
+        s->bi_buf |= (uint64_t)(value & ((1 << put) - 1)) << s->bi_valid;
+#else
         s->bi_buf |= (ush)((value & ((1 << put) - 1)) << s->bi_valid);
+#endif
         s->bi_valid += put;
         _tr_flush_bits(s);
         value >>= put;
@@ -875,6 +884,35 @@ int ZEXPORT deflatePrime (strm, bits, value)
     return Z_OK;
 }
 
+/* ========================================================================= */
+int ZEXPORT aocl_deflateRsyncable(z_streamp strm, int bits)
+{
+#ifdef AOCL_ZLIB_OPT
+    deflate_state *s;
+
+    if (deflateStateCheck(strm) || (bits != 0 &&
+        (bits < RSYNC_MIN_BITS || bits > RSYNC_MAX_BITS)))
+        return Z_STREAM_ERROR;
+    s = strm->state;
+    if (bits == 0) {
+        s->rsync_mask = 0;
+        s->rsync_min = 0;
+    }
+    else {
+        /* the top bits of the hash depend on the most input bytes */
+        s->rsync_mask = ~(uint32_t)0 << (32 - bits);
+        s->rsync_min = (ulg)1 << (bits - 2);
+    }
+    s->rsync_ahead = 0;
+    return Z_OK;
+#else
+    /* rsyncable output is only available with AOCL optimizations */
+    if (deflateStateCheck(strm) || bits != 0)
+        return Z_STREAM_ERROR;
+    return Z_OK;
+#endif /* AOCL_ZLIB_OPT */
+}
+
 /* ========================================================================= */
 #ifdef ENABLE_STRICT_WARNINGS
 int ZEXPORT deflateParams(z_streamp strm, int level, int strategy)
@@ -1124,6 +1162,94 @@ local void flush_pending(strm)
                                 s->pending - (beg)); \
     } while (0)
 
+#ifdef AOCL_ZLIB_OPT
+/* ===========================================================================
+ * Rsyncable deflate(). A gear hash, h = 2 * h + g(byte), is rolled over the
+ * input; since every step shifts the oldest byte further out, its top bits
+ * depend only on the last 32 bytes. Where those bits are all zero, and at
+ * least rsync_min bytes after the previous boundary, the input is cut: the
+ * data up to the cut is compressed and ended with a sync flush, which
+ * terminates the pending match, closes the block and byte aligns the output.
+ * The compressed bytes after a boundary then only depend on the input from
+ * there on and the 32K window before it, so a local edit of the input only
+ * changes the output up to the first boundary past the edit and the window.
+ * The sync flush is kept going across calls until it completes, as deflate()
+ * requires, and input already scanned without a boundary is not rescanned.
+ */
+/* Gear value of a byte: the murmur3 finalizer spreads it over all 32 bits,
+   so the top bits of the hash stay uniform even on text. */
+local uint32_t rsync_gear(unsigned c)
+{
+    uint32_t x = ((uint32_t)c + 1) * 0x9E3779B1U;
+
+    x ^= x >> 16;
+    x *= 0x85EBCA6BU;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35U;
+    x ^= x >> 16;
+    return x;
+}
+
+local int aocl_deflate_rsyncable(z_streamp strm, int flush)
+{
+    deflate_state *s = strm->state;
+    int ret;
+
+    for (;;) {
+        if (!s->rsync_flushing) {
+            /* look for the next boundary in the input not scanned yet */
+            uInt n = s->rsync_ahead < strm->avail_in ? s->rsync_ahead : strm->avail_in;
+            uint32_t h = s->rsync_hash;
+            ulg len = s->rsync_len;
+            const Bytef *in = strm->next_in;
+
+            while (n < strm->avail_in) {
+                h = (h << 1) + rsync_gear(in[n]);
+                n++;
+                len++;
+                if ((h & s->rsync_mask) == 0 && len >= s->rsync_min) {
+                    s->rsync_flushing = 1;
+                    len = 0;
+                    break;
+                }
+            }
+            s->rsync_hash = h;
+            s->rsync_len = len;
+            if (!s->rsync_flushing) {
+                /* no boundary: compress it all as asked */
+                s->rsync_busy = 1;
+                ret = deflate(strm, flush);
+                s->rsync_busy = 0;
+                s->rsync_ahead = strm->avail_in;
+                return ret;
+            }
+            s->rsync_chunk = n;
+        }
+
+        /* compress up to the boundary and sync flush it, keeping the input
+           after it out of deflate()'s sight */
+        {
+            uInt rest = strm->avail_in - s->rsync_chunk;
+
+            strm->avail_in = s->rsync_chunk;
+            s->rsync_busy = 1;
+            ret = deflate(strm, Z_SYNC_FLUSH);
+            s->rsync_busy = 0;
+            s->rsync_chunk = strm->avail_in;
+            strm->avail_in += rest;
+        }
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+            return ret;
+        if (strm->avail_out == 0)
+            return Z_OK;            /* call again to complete the flush */
+        s->rsync_flushing = 0;
+        s->rsync_ahead = 0;
+        if (strm->avail_in == 0 && RANK(flush) <= RANK(Z_SYNC_FLUSH))
+            return Z_OK;            /* the boundary flush did it all */
+    }
+}
+#endif /* AOCL_ZLIB_OPT */
+
 /* ========================================================================= */
 #ifdef ENABLE_STRICT_WARNINGS
 int ZEXPORT deflate (z_streamp strm, int flush)
@@ -1147,6 +1273,10 @@ int ZEXPORT deflate (strm, flush)
         ERR_RETURN(strm, Z_STREAM_ERROR);
     }
     if (strm->avail_out == 0) ERR_RETURN(strm, Z_BUF_ERROR);
+#ifdef AOCL_ZLIB_OPT
+    if (s->rsync_mask && !s->rsync_busy)
+        return aocl_deflate_rsyncable(strm, flush);
+#endif
 
     old_flush = s->last_flush;
     s->last_flush = flush;
@@ -3026,11 +3156,12 @@ local block_state aocl_deflate_slow_v1(deflate_state *s, int flush)
              */
             s->lookahead -= s->prev_length-1;
             s->prev_length -= 2;
-            do {
-                if (++s->strstart <= max_insert) {
-                    INSERT_STRING(s, s->strstart, hash_head);
-                }
-            } while (--s->prev_length != 0);
+            if (s->strstart < max_insert)
+                aocl_insert_string_v1(s, s->strstart + 1,
+                    s->prev_length < max_insert - s->strstart ?
+                    s->prev_length : max_insert - s->strstart);
+            s->strstart += s->prev_length;
+            s->prev_length = 0;
             s->match_available = 0;
             s->match_length = MIN_MATCH-1;
             s->strstart++;
@@ -3154,11 +3285,12 @@ local block_state aocl_deflate_slow_v2(deflate_state *s, int flush)
              */
             s->lookahead -= s->prev_length-1;
             s->prev_length -= 2;
-            do {
-                if (++s->strstart <= max_insert) {
-                    INSERT_STRING_CRC(s, s->strstart, hash_head);
-                }
-            } while (--s->prev_length != 0);
+            if (s->strstart < max_insert)
+                aocl_insert_string_v2(s, s->strstart + 1,
+                    s->prev_length < max_insert - s->strstart ?
+                    s->prev_length : max_insert - s->strstart);
+            s->strstart += s->prev_length;
+            s->prev_length = 0;
             s->match_available = 0;
             s->match_length = MIN_MATCH-1;
             s->strstart++;
@@ -3218,6 +3350,7 @@ local block_state deflate_rle(s, flush)
     int flush;
 #endif /* ENABLE_STRICT_WARNINGS */
 {
+#ifndef AOCL_ZLIB_OPT
     int bflush;             /* set if current block must be flushed */
     uInt prev;              /* byte at distance one to match */
     Bytef *scan, *strend;   /* scan goes up to strend for length of run */
@@ -3281,6 +3414,15 @@ local block_state deflate_rle(s, flush)
     if (s->last_lit)
         FLUSH_BLOCK(s, 0);
     return block_done;
+#else
+#ifdef AOCL_DYNAMIC_DISPATCHER
+    return aocl_deflate_rle_fp(s, flush);
+#elif defined(AOCL_ZLIB_AVX2_OPT)
+    return aocl_deflate_rle_v2(s, flush);
+#else
+    return aocl_deflate_rle_v1(s, flush);
+#endif /* AOCL_DYNAMIC_DISPATCHER */
+#endif /* AOCL_ZLIB_OPT */
 }
 
 /* ===========================================================================
@@ -3295,6 +3437,7 @@ local block_state deflate_huff(s, flush)
     int flush;
 #endif /* ENABLE_STRICT_WARNINGS */
 {
+#ifndef AOCL_ZLIB_OPT
     int bflush;             /* set if current block must be flushed */
 
     for (;;) {
@@ -3324,4 +3467,232 @@ local block_state deflate_huff(s, flush)
     if (s->last_lit)
         FLUSH_BLOCK(s, 0);
     return block_done;
+#else
+    return aocl_deflate_huff(s, flush);
+#endif /* AOCL_ZLIB_OPT */
+}
+
+#ifdef AOCL_ZLIB_OPT
+#ifdef AOCL_ZLIB_AVX2_OPT
+#include <immintrin.h>
+#endif
+
+#ifdef HAVE_BUILTIN_CTZ
+#define aocl_ctz32(x) ((uInt)__builtin_ctz(x))
+#else
+local uInt aocl_ctz32(unsigned x)
+{
+    uInt n = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+}
+#endif
+
+/* ===========================================================================
+ * Tallies the n literals at buf as n _tr_tally_lit() would. The frequencies
+ * are counted in four interleaved tables first, so that a run of the same
+ * byte does not wait on the increment of a single counter.
+ * IN assertion: n <= s->lit_bufsize - 1 - s->last_lit
+ */
+local void aocl_tally_lits(deflate_state *s, const Bytef *buf, uInt n)
+{
+#ifdef ZLIB_DEBUG
+    int bflush;
+    while (n--) {
+        _tr_tally_lit(s, *buf++, bflush);
+    }
+    (void)bflush;
+#else
+    uInt i;
+
+    zmemcpy(s->l_buf + s->last_lit, buf, n);
+    zmemzero((Bytef *)(s->d_buf + s->last_lit), n * sizeof(ush));
+    s->last_lit += n;
+    if (n < 64) {
+        for (i = 0; i < n; i++)
+            s->dyn_ltree[buf[i]].Freq++;
+    } else {
+        /* n < lit_bufsize <= 32K, so the 16-bit counts cannot overflow */
+        ush freq[4][LITERALS];
+
+        zmemzero((Bytef *)freq, sizeof(freq));
+        for (i = 0; i + 4 <= n; i += 4) {
+            freq[0][buf[i]]++;
+            freq[1][buf[i + 1]]++;
+            freq[2][buf[i + 2]]++;
+            freq[3][buf[i + 3]]++;
+        }
+        for (; i < n; i++)
+            freq[0][buf[i]]++;
+        for (i = 0; i < LITERALS; i++)
+            s->dyn_ltree[i].Freq += freq[0][i] + freq[1][i] + freq[2][i] +
+                                    freq[3][i];
+    }
+#endif
+}
+
+/* ===========================================================================
+ * Returns the number of leading positions of p[0..n-1] that do not start a
+ * deflate_rle() match, i.e. the index of the first t with
+ * p[t-1] == p[t] == p[t+1] == p[t+2], or n if there is none.
+ * Reads p[-1] to p[n+1].
+ */
+local uInt aocl_rle_literals_v1(const Bytef *p, uInt n)
+{
+    uInt t = 0;
+
+    while (t + 16 <= n) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(p + t - 1));
+        __m128i b = _mm_loadu_si128((const __m128i *)(p + t));
+        __m128i c = _mm_loadu_si128((const __m128i *)(p + t + 1));
+        __m128i d = _mm_loadu_si128((const __m128i *)(p + t + 2));
+        unsigned m = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(a, b),
+                                        _mm_cmpeq_epi8(b, c)),
+                          _mm_cmpeq_epi8(c, d)));
+        if (m != 0)
+            return t + aocl_ctz32(m);
+        t += 16;
+    }
+    for (p += t; t < n; t++, p++)
+        if (p[-1] == p[0] && p[0] == p[1] && p[1] == p[2])
+            break;
+    return t;
+}
+
+/* ===========================================================================
+ * Returns the length of the run of bytes equal to p[-1] starting at p, at
+ * most MAX_MATCH. Reads p[-1] to p[MAX_MATCH-1].
+ */
+local uInt aocl_rle_run_v1(const Bytef *p)
+{
+    __m128i v = _mm_set1_epi8((char)p[-1]);
+    uInt len = 0;
+
+    while (len + 16 <= MAX_MATCH) {
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v,
+                         _mm_loadu_si128((const __m128i *)(p + len))));
+        if (m != 0xFFFF)
+            return len + aocl_ctz32(~m);
+        len += 16;
+    }
+    while (len < MAX_MATCH && p[len] == p[-1])
+        len++;
+    return len;
+}
+
+#ifdef AOCL_ZLIB_AVX2_OPT
+/* AVX2 version of aocl_rle_literals_v1() */
+__attribute__((__target__("avx2")))
+static inline uInt aocl_rle_literals_v2(const Bytef *p, uInt n)
+{
+    uInt t = 0;
+
+    while (t + 32 <= n) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(p + t - 1));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(p + t));
+        __m256i c = _mm256_loadu_si256((const __m256i *)(p + t + 1));
+        __m256i d = _mm256_loadu_si256((const __m256i *)(p + t + 2));
+        unsigned m = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(a, b),
+                                              _mm256_cmpeq_epi8(b, c)),
+                             _mm256_cmpeq_epi8(c, d)));
+        if (m != 0)
+            return t + aocl_ctz32(m);
+        t += 32;
+    }
+    return t + aocl_rle_literals_v1(p + t, n - t);
+}
+
+/* AVX2 version of aocl_rle_run_v1() */
+__attribute__((__target__("avx2")))
+static inline uInt aocl_rle_run_v2(const Bytef *p)
+{
+    __m256i v = _mm256_set1_epi8((char)p[-1]);
+    uInt len = 0;
+
+    while (len + 32 <= MAX_MATCH) {
+        unsigned m = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v,
+                         _mm256_loadu_si256((const __m256i *)(p + len))));
+        if (m != 0xFFFFFFFF)
+            return len + aocl_ctz32(~m);
+        len += 32;
+    }
+    while (len < MAX_MATCH && p[len] == p[-1])
+        len++;
+    return len;
+}
+#endif /* AOCL_ZLIB_AVX2_OPT */
+
+/* The template deflate_rle_x86.h generates deflate_rle() variants that find
+ * the literals up to the next run with RLE_LITERALS() and tally them at once,
+ * and measure the run with RLE_RUN() */
+#define DEFLATE_RLE_TARGET
+#define RLE_LITERALS aocl_rle_literals_v1
+#define RLE_RUN aocl_rle_run_v1
+#define DEFLATE_RLE_FAMILY aocl_deflate_rle_v1
+#include "deflate_rle_x86.h"
+#undef DEFLATE_RLE_TARGET
+#undef RLE_LITERALS
+#undef RLE_RUN
+#undef DEFLATE_RLE_FAMILY
+
+#ifdef AOCL_ZLIB_AVX2_OPT
+#define DEFLATE_RLE_TARGET __attribute__((__target__("avx2")))
+#define RLE_LITERALS aocl_rle_literals_v2
+#define RLE_RUN aocl_rle_run_v2
+#define DEFLATE_RLE_FAMILY aocl_deflate_rle_v2
+#include "deflate_rle_x86.h"
+#undef DEFLATE_RLE_TARGET
+#undef RLE_LITERALS
+#undef RLE_RUN
+#undef DEFLATE_RLE_FAMILY
+#else
+local block_state aocl_deflate_rle_v2(deflate_state *s, int flush)
+{
+    return aocl_deflate_rle_v1(s, flush);
+}
+#endif /* AOCL_ZLIB_AVX2_OPT */
+
+/* ===========================================================================
+ * Same as deflate_huff(), but tallies all the literals the lookahead and the
+ * current block allow at once with aocl_tally_lits().
+ */
+local block_state aocl_deflate_huff(deflate_state *s, int flush)
+{
+    uInt n;
+
+    s->match_length = 0;
+    for (;;) {
+        /* Make sure that we have a literal to write. */
+        if (s->lookahead == 0) {
+            fill_window(s);
+            if (s->lookahead == 0) {
+                if (flush == Z_NO_FLUSH)
+                    return need_more;
+                break;      /* flush the current block */
+            }
+        }
+
+        /* Output as many literal bytes as fit in the block */
+        n = s->lit_bufsize - 1 - s->last_lit;
+        if (n > s->lookahead)
+            n = s->lookahead;
+        aocl_tally_lits(s, s->window + s->strstart, n);
+        s->lookahead -= n;
+        s->strstart += n;
+        if (s->last_lit == s->lit_bufsize - 1) FLUSH_BLOCK(s, 0);
+    }
+    s->insert = 0;
+    if (flush == Z_FINISH) {
+        FLUSH_BLOCK(s, 1);
+        return finish_done;
+    }
+    if (s->last_lit)
+        FLUSH_BLOCK(s, 0);
+    return block_done;
 }
+#endif /* AOCL_ZLIB_OPT */
@@ -49,8 +49,21 @@
 #define MAX_BITS 15
 /* All codes must not exceed MAX_BITS bits */
 
+#ifdef AOCL_ZLIB_OPT
+#define Buf_size 64
+/* size of bit buffer in bi_buf. Codes are accumulated 64 bits at a time and
+ * written out with a single 8-byte store.
+ */
+#else
 #define Buf_size 16
 /* size of bit buffer in bi_buf */
+#endif
+
+#ifdef AOCL_ZLIB_OPT
+#define RSYNC_MIN_BITS  8
+#define RSYNC_MAX_BITS 24
+/* range of log2 of the average distance between rsyncable boundaries */
+#endif
 
 #define INIT_STATE    42    /* zlib header -> BUSY_STATE */
 #ifdef GZIP
@@ -258,7 +271,11 @@ typedef struct internal_state {
     ulg bits_sent;      /* bit length of compressed data sent mod 2^32 */
 #endif
 
+#ifdef AOCL_ZLIB_OPT
+    uint64_t bi_buf;
+#else
     ush bi_buf;
+#endif
     /* Output buffer. bits are inserted starting at the bottom (least
      * significant bits).
      */
@@ -274,6 +291,18 @@ typedef struct internal_state {
      * updated to the new high water mark.
      */
 
+#ifdef AOCL_ZLIB_OPT
+    /* rsyncable output, see aocl_deflateRsyncable() */
+    uint32_t rsync_mask;  /* boundary where hash & mask == 0, 0 if disabled */
+    uint32_t rsync_hash;  /* rolling hash of the input scanned so far */
+    ulg rsync_min;        /* minimum distance between two boundaries */
+    ulg rsync_len;        /* bytes scanned since the last boundary */
+    uInt rsync_ahead;     /* bytes at next_in scanned without a boundary */
+    uInt rsync_chunk;     /* bytes at next_in up to the pending boundary */
+    int rsync_flushing;   /* true while the boundary is being flushed */
+    int rsync_busy;       /* true inside deflate() called by the wrapper */
+#endif
+
 } FAR deflate_state;
 
 /* Output a byte on the stream.
@@ -424,6 +453,98 @@ extern uint32_t mask;
 #endif /* FASTEST */
 #endif /* AOCL_ZLIB_AVX_OPT */
 
+#ifdef AOCL_ZLIB_OPT
+#include <emmintrin.h>
+#if MIN_MATCH != 3
+#  error aocl_insert_string_v1() assumes MIN_MATCH == 3
+#endif
+/* ===========================================================================
+ * Insert the count strings starting at str into the hash chains, in order, as
+ * count INSERT_STRING2() calls would, and leave ins_h at the hash of the last
+ * one. UPDATE_HASH() shifts out all but the last MIN_MATCH bytes, so the
+ * hashes of 8 strings are computed at once from the window, without the
+ * serial dependency through ins_h; hash_bits <= 16, so 16 bit lanes suffice.
+ * Only the head/prev updates, where the strings of a run share a chain, are
+ * made one at a time.
+ * IN assertion: count > 0.
+ */
+static inline void aocl_insert_string_v1(deflate_state *s, uInt str, uInt count)
+{
+    const __m128i hmask = _mm_set1_epi16((short)s->hash_mask);
+    const __m128i shift1 = _mm_cvtsi32_si128((int)s->hash_shift);
+    const __m128i shift2 = _mm_cvtsi32_si128((int)(2 * s->hash_shift));
+    const __m128i zero = _mm_setzero_si128();
+    Posf *head = s->head;
+#ifndef FASTEST
+    Posf *prev = s->prev;
+    uInt wmask = s->w_mask;
+#endif
+    ush h[8];
+    uInt i, n = 0;
+
+    while (count) {
+        const Bytef *w = s->window + str;
+
+        n = count < 8 ? count : 8;
+        if (LIKELY(str + 10 <= s->window_size)) {
+            __m128i b0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)w), zero);
+            __m128i b1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(w + 1)), zero);
+            __m128i b2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(w + 2)), zero);
+            __m128i hv = _mm_xor_si128(_mm_xor_si128(_mm_sll_epi16(b0, shift2),
+                                                     _mm_sll_epi16(b1, shift1)), b2);
+            _mm_storeu_si128((__m128i *)h, _mm_and_si128(hv, hmask));
+        }
+        else {
+            /* end of the window: do not load past it */
+            for (i = 0; i < n; i++)
+                h[i] = (ush)((((uInt)w[i] << (2 * s->hash_shift)) ^
+                              ((uInt)w[i + 1] << s->hash_shift) ^ w[i + 2]) &
+                             s->hash_mask);
+        }
+        for (i = 0; i < n; i++) {
+#ifndef FASTEST
+            prev[(str + i) & wmask] = head[h[i]];
+#endif
+            head[h[i]] = (Pos)(str + i);
+        }
+        str += n;
+        count -= n;
+    }
+    s->ins_h = h[n - 1];
+}
+
+#ifdef AOCL_ZLIB_AVX_OPT
+/* ===========================================================================
+ * Same as aocl_insert_string_v1() for the UPDATE_HASH_CRC() hash. The CRC of
+ * each string does not depend on the previous one, so the loop only keeps the
+ * table pointers and masks in registers and lets the CRCs overlap on their own.
+ */
+__attribute__((__target__("avx"))) // uses SSE4.2 intrinsics
+static inline void aocl_insert_string_v2(deflate_state *s, uInt str, uInt count)
+{
+    const uint32_t hmask = s->hash_mask;
+    const uint32_t kmask = mask;
+    Posf *head = s->head;
+#ifndef FASTEST
+    Posf *prev = s->prev;
+    uInt wmask = s->w_mask;
+#endif
+    const Bytef *w = s->window + str;
+    uint32_t h = 0;
+    uInt i;
+
+    for (i = 0; i < count; i++) {
+        h = _mm_crc32_u32(0, *(const unsigned *)(w + i) & kmask) & hmask;
+#ifndef FASTEST
+        prev[(str + i) & wmask] = head[h];
+#endif
+        head[h] = (Pos)(str + i);
+    }
+    s->ins_h = h;
+}
+#endif /* AOCL_ZLIB_AVX_OPT */
+#endif /* AOCL_ZLIB_OPT */
+
 /* ===========================================================================
  * Flush the current block, with given end-of-file flag.
  * IN assertion: strstart is set to the end of the current match.
@@ -458,6 +579,16 @@ extern uint32_t mask;
     put_byte(s, (uch)((ush)(w) >> 8)); \
 }
 
+/* ===========================================================================
+ * Output a 64-bit value LSB first on the stream.
+ * IN assertion: there is enough room in pendingBuf.
+ */
+#define put_uint64(s, w) { \
+    uint64_t w64 = (w); \
+    zmemcpy(s->pending_buf + s->pending, &w64, 8); \
+    s->pending += 8; \
+}
+
 #ifndef ZLIB_DEBUG
 #  define send_code(s, c, tree) send_bits(s, tree[c].Code, tree[c].Len)
    /* Send a code of the given tree. c and tree must not have side effects */
@@ -469,31 +600,32 @@ extern uint32_t mask;
 #endif
 /* ===========================================================================
  * Send a value on a given number of bits.
- * IN assertion: length <= 16 and value fits in length bits.
+ * IN assertion: length < 64 and value fits in length bits.
  */
 #ifdef ZLIB_DEBUG
-local void send_bits      OF((deflate_state *s, int value, int length));
+local void send_bits      OF((deflate_state *s, uint64_t value, int length));
 
 local void send_bits(s, value, length)
     deflate_state *s;
-    int value;  /* value to send */
-    int length; /* number of bits */
+    uint64_t value;  /* value to send */
+    int length;      /* number of bits */
 {
-    Tracevv((stderr," l %2d v %4x ", length, value));
-    Assert(length > 0 && length <= 15, "invalid length");
+    Tracevv((stderr," l %2d v %4llx ", length, (unsigned long long)value));
+    Assert(length > 0 && length < (int)Buf_size, "invalid length");
     s->bits_sent += (ulg)length;
 
     /* If not enough room in bi_buf, use (valid) bits from bi_buf and
-     * (16 - bi_valid) bits from value, leaving (width - (16-bi_valid))
-     * unused bits in value.
+     * (64 - bi_valid) bits from value, leaving (width - (64-bi_valid))
+     * unused bits in value. bi_valid is never 64 here, so the shifts
+     * below are always defined.
      */
-    if (s->bi_valid > (int)Buf_size - length) {
-        s->bi_buf |= (ush)value << s->bi_valid;
-        put_short(s, s->bi_buf);
-        s->bi_buf = (ush)value >> (Buf_size - s->bi_valid);
+    if (s->bi_valid + length >= (int)Buf_size) {
+        s->bi_buf |= value << s->bi_valid;
+        put_uint64(s, s->bi_buf);
+        s->bi_buf = value >> (Buf_size - s->bi_valid);
         s->bi_valid += length - Buf_size;
     } else {
-        s->bi_buf |= (ush)value << s->bi_valid;
+        s->bi_buf |= value << s->bi_valid;
         s->bi_valid += length;
     }
 }
@@ -501,14 +633,14 @@ local void send_bits(s, value, length)
 
 #define send_bits(s, value, length) \
 { int len = length;\
-  if (s->bi_valid > (int)Buf_size - len) {\
-    int val = (int)value;\
-    s->bi_buf |= (ush)val << s->bi_valid;\
-    put_short(s, s->bi_buf);\
-    s->bi_buf = (ush)val >> (Buf_size - s->bi_valid);\
+  uint64_t val = (uint64_t)(value);\
+  if (s->bi_valid + len >= (int)Buf_size) {\
+    s->bi_buf |= val << s->bi_valid;\
+    put_uint64(s, s->bi_buf);\
+    s->bi_buf = val >> (Buf_size - s->bi_valid);\
     s->bi_valid += len - Buf_size;\
   } else {\
-    s->bi_buf |= (ush)(value) << s->bi_valid;\
+    s->bi_buf |= val << s->bi_valid;\
     s->bi_valid += len;\
   }\
 }
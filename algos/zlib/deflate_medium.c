@@ -72,17 +72,14 @@ static void aocl_insert_match_v1(deflate_state *s, struct match match)
      */
     if (match.match_length <= 16* s->max_insert_length &&
         s->lookahead >= MIN_MATCH) {
-        match.match_length--; /* string at strstart already in table */
-        do {
-            match.strstart++;
-            if (LIKELY(match.strstart >= match.orgstart)) {
-                INSERT_STRING2(s, match.strstart);
-            }
-            /* strstart never exceeds WSIZE-MAX_MATCH, so there are
-            * always MIN_MATCH bytes ahead.
-            */
-        } while (--match.match_length != 0);
-        match.strstart++;
+        /* the strings at strstart and before orgstart are already in table */
+        uInt first = match.strstart + 1;
+        uInt end = match.strstart + match.match_length;
+
+        if (first < match.orgstart)
+            first = match.orgstart;
+        if (first < end)
+            aocl_insert_string_v1(s, first, end - first);
     } else {
         match.strstart += match.match_length;
         match.match_length = 0;
@@ -128,17 +125,14 @@ static void aocl_insert_match_v2(deflate_state *s, struct match match)
      */
     if (match.match_length <= 16* s->max_insert_length &&
         s->lookahead >= MIN_MATCH) {
-        match.match_length--; /* string at strstart already in table */
-        do {
-            match.strstart++;
-            if (LIKELY(match.strstart >= match.orgstart)) {
-                INSERT_STRING_CRC2(s, match.strstart);
-            }
-        /* strstart never exceeds WSIZE-MAX_MATCH, so there are
-            * always MIN_MATCH bytes ahead.
-            */
-        } while (--match.match_length != 0);
-        match.strstart++;
+        /* the strings at strstart and before orgstart are already in table */
+        uInt first = match.strstart + 1;
+        uInt end = match.strstart + match.match_length;
+
+        if (first < match.orgstart)
+            first = match.orgstart;
+        if (first < end)
+            aocl_insert_string_v2(s, first, end - first);
     } else {
         match.strstart += match.match_length;
         match.match_length = 0;
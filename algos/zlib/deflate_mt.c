@@ -0,0 +1,355 @@
+/* deflate_mt.c -- parallel compression of a memory buffer
+ * Copyright (C) 2023, Advanced Micro Devices. All rights reserved.
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+/*
+ *  ALGORITHM
+ *
+ *      The input is split into fixed size blocks which are compressed
+ *      independently as raw deflate data, in the same way as pigz. Every block
+ *      but the first is primed with the 32K of input preceding it as a preset
+ *      dictionary, so matches may still reach back across block boundaries and
+ *      the ratio stays close to that of a single stream. Every block but the
+ *      last ends with a sync flush, which byte aligns it without setting the
+ *      last block bit. The blocks can then simply be concatenated behind a zlib
+ *      or gzip header. The check value of each block is computed on the worker
+ *      and merged in order with adler32_combine() or crc32_combine().
+ *
+ *      numThreads - 1 workers are started once and take blocks from a queue
+ *      of 2 * numThreads slots; the calling thread appends the blocks to the
+ *      output in order, compressing queued blocks itself while it waits, and
+ *      refills each slot once its block is appended. This bounds the scratch
+ *      memory to 2 * numThreads compressed blocks, and keeps the workers busy
+ *      when blocks take unequal time.
+ */
+
+#include "zutil.h"
+#include "zthread.h"
+
+#define MT_DICT_SIZE        32768
+#define MT_MIN_BLOCK_SIZE   (128 * 1024)
+#define MT_MAX_BLOCK_SIZE   (1024 * 1024)
+#define MT_DEFAULT_BLOCK    MT_MIN_BLOCK_SIZE
+#define MT_GZIP_HEADER_SIZE 10
+#define MT_GZIP_TRAILER_SIZE 8
+
+typedef struct {
+    const Bytef *dict;      /* input preceding the block, or Z_NULL */
+    uInt dictLen;
+    const Bytef *in;        /* block input */
+    uInt inLen;
+    Bytef *out;             /* scratch output of outCap bytes */
+    uLong outCap;
+    uLong outLen;           /* raw deflate bytes produced */
+    uLong check;            /* adler32 or crc32 of the block input */
+    int level;
+    int gzip;
+    int last;               /* finish the stream instead of sync flushing */
+    int ret;                /* Z_OK on success */
+    int done;               /* compressed, under the pool mutex */
+} mt_block;
+
+typedef struct {
+    z_mutex mutex;
+    z_cond todo;            /* a block was queued, or stop was set */
+    z_cond done;            /* a block was compressed */
+    mt_block *slots;        /* block n is in slots[n % nSlots] */
+    uLong nSlots;
+    uLong queued;           /* blocks queued so far */
+    uLong taken;            /* blocks taken by a thread so far */
+    int stop;
+} mt_pool;
+
+local uLong mt_block_size(uLong blockSize)
+{
+    if (blockSize == 0)
+        return MT_DEFAULT_BLOCK;
+    if (blockSize < MT_MIN_BLOCK_SIZE)
+        return MT_MIN_BLOCK_SIZE;
+    if (blockSize > MT_MAX_BLOCK_SIZE)
+        return MT_MAX_BLOCK_SIZE;
+    return blockSize;
+}
+
+/* Raw deflate bound of one block: compressBound() without the zlib wrapper,
+   plus the empty stored block appended by the sync flush. */
+local uLong mt_block_bound(uLong len)
+{
+    return compressBound(len) + 5;
+}
+
+local void mt_deflate_block(mt_block *b)
+{
+    z_stream strm;
+    int err;
+
+    zmemzero(&strm, sizeof(strm));
+    err = deflateInit2(&strm, b->level, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL,
+                       Z_DEFAULT_STRATEGY);
+    if (err != Z_OK) {
+        b->ret = err;
+        return;
+    }
+    if (b->dictLen)
+        err = deflateSetDictionary(&strm, b->dict, b->dictLen);
+    if (err == Z_OK) {
+        strm.next_in = (z_const Bytef *)b->in;
+        strm.avail_in = b->inLen;
+        strm.next_out = b->out;
+        strm.avail_out = (uInt)b->outCap;
+        err = deflate(&strm, b->last ? Z_FINISH : Z_SYNC_FLUSH);
+        if (b->last)
+            err = err == Z_STREAM_END ? Z_OK : Z_BUF_ERROR;
+        else if (err == Z_OK && strm.avail_out == 0)
+            err = Z_BUF_ERROR; /* flush may not have completed */
+    }
+    b->outLen = strm.total_out;
+    deflateEnd(&strm);
+
+    if (b->gzip)
+        b->check = crc32(crc32(0L, Z_NULL, 0), b->in, b->inLen);
+    else
+        b->check = adler32(adler32(0L, Z_NULL, 0), b->in, b->inLen);
+    b->ret = err;
+}
+
+/* Set up block n of the input, to be compressed into out. */
+local void mt_block_init(mt_block *b, const Bytef *source, uLong sourceLen,
+                         uLong blockSize, uLong nBlocks, uLong n, Bytef *out,
+                         uLong outCap, int level, int gzip)
+{
+    uLong start = n * blockSize;
+    uLong len = sourceLen - start < blockSize ? sourceLen - start : blockSize;
+
+    b->dictLen = (uInt)(start < MT_DICT_SIZE ? start : MT_DICT_SIZE);
+    b->dict = source + start - b->dictLen;
+    b->in = source + start;
+    b->inLen = (uInt)len;
+    b->out = out;
+    b->outCap = outCap;
+    b->outLen = 0;
+    b->level = level;
+    b->gzip = gzip;
+    b->last = (n + 1 == nBlocks);
+    b->ret = Z_OK;
+    b->done = 0;
+}
+
+/* Compress the next queued block, called and returning with the pool mutex
+   held. */
+local void mt_pool_run_one(mt_pool *pool)
+{
+    mt_block *b = &pool->slots[pool->taken++ % pool->nSlots];
+
+    z_mutex_unlock(&pool->mutex);
+    mt_deflate_block(b);
+    z_mutex_lock(&pool->mutex);
+    b->done = 1;
+    z_cond_broadcast(&pool->done);
+}
+
+local void mt_worker(void *arg)
+{
+    mt_pool *pool = (mt_pool *)arg;
+
+    z_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (pool->taken == pool->queued && !pool->stop)
+            z_cond_wait(&pool->todo, &pool->mutex);
+        if (pool->stop)
+            break;
+        mt_pool_run_one(pool);
+    }
+    z_mutex_unlock(&pool->mutex);
+}
+
+/* ========================================================================= */
+uLong ZEXPORT aocl_compressBound_mt(uLong sourceLen, uLong blockSize)
+{
+    uLong nBlocks;
+
+    blockSize = mt_block_size(blockSize);
+    nBlocks = sourceLen == 0 ? 1 : (sourceLen + blockSize - 1) / blockSize;
+    return sourceLen + nBlocks * (mt_block_bound(blockSize) - blockSize) +
+           MT_GZIP_HEADER_SIZE + MT_GZIP_TRAILER_SIZE;
+}
+
+/* ========================================================================= */
+int ZEXPORT aocl_compress2_mt(Bytef *dest, uLongf *destLen,
+                              const Bytef *source, uLong sourceLen,
+                              int level, int windowBits,
+                              int numThreads, uLong blockSize)
+{
+    mt_pool pool;
+    z_thread *threads;
+    Bytef *scratch;
+    uLong left, check, total, blockBound, nBlocks, n;
+    int gzip, i, started = 0, err = Z_OK;
+
+    if (dest == Z_NULL || destLen == Z_NULL || (source == Z_NULL && sourceLen))
+        return Z_STREAM_ERROR;
+    if (level == Z_DEFAULT_COMPRESSION)
+        level = 6;
+    if (level < 0 || level > 9)
+        return Z_STREAM_ERROR;
+    if (windowBits == MAX_WBITS)
+        gzip = 0;
+    else if (windowBits == MAX_WBITS + 16)
+        gzip = 1;
+    else
+        return Z_STREAM_ERROR;
+    if (numThreads < 1)
+        numThreads = 1;
+
+    blockSize = mt_block_size(blockSize);
+    nBlocks = sourceLen == 0 ? 1 : (sourceLen + blockSize - 1) / blockSize;
+    if ((uLong)numThreads > nBlocks)
+        numThreads = (int)nBlocks;
+    blockBound = mt_block_bound(blockSize);
+
+    pool.nSlots = 2 * (uLong)numThreads < nBlocks ? 2 * (uLong)numThreads : nBlocks;
+    pool.slots = (mt_block *)malloc(pool.nSlots * sizeof(mt_block));
+    threads = (z_thread *)malloc(numThreads * sizeof(z_thread));
+    scratch = (Bytef *)malloc(pool.nSlots * blockBound);
+    if (pool.slots == Z_NULL || threads == Z_NULL || scratch == Z_NULL) {
+        free(pool.slots);
+        free(threads);
+        free(scratch);
+        return Z_MEM_ERROR;
+    }
+    z_mutex_init(&pool.mutex);
+    z_cond_init(&pool.todo);
+    z_cond_init(&pool.done);
+    pool.queued = 0;
+    pool.taken = 0;
+    pool.stop = 0;
+
+    left = *destLen;
+    total = 0;
+
+    /* stream header */
+    if (gzip) {
+        if (left < MT_GZIP_HEADER_SIZE) {
+            err = Z_BUF_ERROR;
+            goto done;
+        }
+        dest[0] = 0x1f;
+        dest[1] = 0x8b;
+        dest[2] = Z_DEFLATED;
+        dest[3] = 0;                                /* flags */
+        dest[4] = dest[5] = dest[6] = dest[7] = 0;  /* mtime */
+        dest[8] = level == 9 ? 2 : (level < 2 ? 4 : 0);
+        dest[9] = OS_CODE;
+        total = MT_GZIP_HEADER_SIZE;
+        check = crc32(0L, Z_NULL, 0);
+    }
+    else {
+        uInt header = (Z_DEFLATED + ((MAX_WBITS - 8) << 4)) << 8;
+        uInt level_flags = level < 2 ? 0 : (level < 6 ? 1 : (level == 6 ? 2 : 3));
+
+        if (left < 2) {
+            err = Z_BUF_ERROR;
+            goto done;
+        }
+        header |= (level_flags << 6);
+        header += 31 - (header % 31);
+        dest[0] = (Bytef)(header >> 8);
+        dest[1] = (Bytef)(header & 0xff);
+        total = 2;
+        check = adler32(0L, Z_NULL, 0);
+    }
+
+    /* queue the first blocks, then start the workers; if a thread cannot be
+       created, the others and the calling thread do its share */
+    for (n = 0; n < pool.nSlots; n++)
+        mt_block_init(&pool.slots[n], source, sourceLen, blockSize, nBlocks, n,
+                      scratch + n * blockBound, blockBound, level, gzip);
+    pool.queued = pool.nSlots;
+    for (i = 1; i < numThreads; i++) {
+        if (!z_thread_create(&threads[started], mt_worker, &pool))
+            break;
+        started++;
+    }
+
+    /* append the blocks in order */
+    for (n = 0; n < nBlocks && err == Z_OK; n++) {
+        mt_block *b = &pool.slots[n % pool.nSlots];
+
+        z_mutex_lock(&pool.mutex);
+        while (!b->done) {
+            if (pool.taken < pool.queued)
+                mt_pool_run_one(&pool);
+            else
+                z_cond_wait(&pool.done, &pool.mutex);
+        }
+        z_mutex_unlock(&pool.mutex);
+
+        if (b->ret != Z_OK) {
+            err = b->ret;
+            break;
+        }
+        if (left - total < b->outLen) {
+            err = Z_BUF_ERROR;
+            break;
+        }
+        zmemcpy(dest + total, b->out, (uInt)b->outLen);
+        total += b->outLen;
+        check = gzip ? crc32_combine(check, b->check, (z_off_t)b->inLen)
+                     : adler32_combine(check, b->check, (z_off_t)b->inLen);
+
+        /* reuse the slot for the next block that is not queued yet */
+        if (n + pool.nSlots < nBlocks) {
+            mt_block_init(b, source, sourceLen, blockSize, nBlocks, n + pool.nSlots,
+                          b->out, blockBound, level, gzip);
+            z_mutex_lock(&pool.mutex);
+            pool.queued++;
+            z_cond_broadcast(&pool.todo);
+            z_mutex_unlock(&pool.mutex);
+        }
+    }
+
+    /* stream trailer */
+    if (err == Z_OK) {
+        if (gzip) {
+            if (left - total < MT_GZIP_TRAILER_SIZE) {
+                err = Z_BUF_ERROR;
+                goto done;
+            }
+            dest[total++] = (Bytef)(check & 0xff);
+            dest[total++] = (Bytef)((check >> 8) & 0xff);
+            dest[total++] = (Bytef)((check >> 16) & 0xff);
+            dest[total++] = (Bytef)((check >> 24) & 0xff);
+            dest[total++] = (Bytef)(sourceLen & 0xff);
+            dest[total++] = (Bytef)((sourceLen >> 8) & 0xff);
+            dest[total++] = (Bytef)((sourceLen >> 16) & 0xff);
+            dest[total++] = (Bytef)((sourceLen >> 24) & 0xff);
+        }
+        else {
+            if (left - total < 4) {
+                err = Z_BUF_ERROR;
+                goto done;
+            }
+            dest[total++] = (Bytef)((check >> 24) & 0xff);
+            dest[total++] = (Bytef)((check >> 16) & 0xff);
+            dest[total++] = (Bytef)((check >> 8) & 0xff);
+            dest[total++] = (Bytef)(check & 0xff);
+        }
+        *destLen = total;
+    }
+
+done:
+    z_mutex_lock(&pool.mutex);
+    pool.stop = 1;
+    z_cond_broadcast(&pool.todo);
+    z_mutex_unlock(&pool.mutex);
+    for (i = 0; i < started; i++)
+        z_thread_join(&threads[i]);
+    z_cond_destroy(&pool.done);
+    z_cond_destroy(&pool.todo);
+    z_mutex_destroy(&pool.mutex);
+    free(pool.slots);
+    free(threads);
+    free(scratch);
+    return err;
+}
@@ -34,19 +34,18 @@ local inline long compare258(z_const unsigned char *z_const src0,
 local inline void quick_send_bits(deflate_state *z_const s, z_const int value,
         z_const int length)
 {
-    unsigned code, out, w, b;
+    uint64_t out;
+    unsigned w, b;
 
-    out = s->bi_buf;
-    w = s->bi_valid;
+    /* bi_valid < 8 on entry (see static_emit_tree()), so the new code
+     * always fits in the 64-bit buffer */
+    out = s->bi_buf | ((uint64_t)value << s->bi_valid);
+    w = s->bi_valid + length;
 
-    code = value << s->bi_valid;
-    out |= code;
-    w += length;
-
-    if (s->pending + 4 >= s->pending_buf_size)
+    if (s->pending + 8 >= s->pending_buf_size)
         flush_pending_fp(s->strm);
 
-    *(unsigned *)(s->pending_buf + s->pending) = out;
+    zmemcpy(s->pending_buf + s->pending, &out, 8);
 
     b = w >> 3;
     s->pending += b;
@@ -83,6 +82,8 @@ local void static_emit_tree(deflate_state *z_const s,
 
     last = flush == Z_FINISH ? 1 : 0;
     send_bits(s, (STATIC_TREES<<1)+ last, 3);
+    /* leave less than 8 bits in bi_buf for quick_send_bits() */
+    flush_pending_fp(s->strm);
 }
 
 
@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) 2023, Advanced Micro Devices. All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// This header file is a template for deflate_rle() multiversion, application should not use it directly
+/* ===========================================================================
+ * Same as deflate_rle(), but while more than MAX_MATCH bytes of lookahead are
+ * left, the literals up to the next run are tallied at once and the run is
+ * measured with SIMD compares. The emitted symbols are the same as with
+ * deflate_rle().
+ */
+DEFLATE_RLE_TARGET
+local block_state DEFLATE_RLE_FAMILY(deflate_state *s, int flush)
+{
+    int bflush;             /* set if current block must be flushed */
+    uInt prev;              /* byte at distance one to match */
+    Bytef *scan, *strend;   /* scan goes up to strend for length of run */
+    uInt n, lits;
+
+    for (;;) {
+        /* Make sure that we always have enough lookahead, except
+         * at the end of the input file. We need MAX_MATCH bytes
+         * for the longest run, plus one for the unrolled loop.
+         */
+        if (s->lookahead <= MAX_MATCH) {
+            fill_window(s);
+            if (s->lookahead <= MAX_MATCH && flush == Z_NO_FLUSH) {
+                return need_more;
+            }
+            if (s->lookahead == 0) break; /* flush the current block */
+        }
+
+        s->match_length = 0;
+        if (s->lookahead > MAX_MATCH && s->strstart > 0) {
+            /* Each position before strstart + n keeps more than MAX_MATCH
+             * bytes of lookahead, so no run is cut short by it. n is also
+             * kept within the room left in the current block.
+             */
+            n = s->lookahead - MAX_MATCH;
+            if (n > s->lit_bufsize - 1 - s->last_lit)
+                n = s->lit_bufsize - 1 - s->last_lit;
+            scan = s->window + s->strstart;
+            lits = RLE_LITERALS(scan, n);
+            if (lits != 0) {
+                aocl_tally_lits(s, scan, lits);
+                s->lookahead -= lits;
+                s->strstart += lits;
+            }
+            if (lits < n) {
+                s->match_length = RLE_RUN(scan + lits);
+                check_match(s, s->strstart, s->strstart - 1, s->match_length);
+                _tr_tally_dist(s, 1, s->match_length - MIN_MATCH, bflush);
+                s->lookahead -= s->match_length;
+                s->strstart += s->match_length;
+                s->match_length = 0;
+            }
+            bflush = (s->last_lit == s->lit_bufsize - 1);
+        } else {
+            /* End of the input or first byte: one symbol as deflate_rle() */
+            if (s->lookahead >= MIN_MATCH && s->strstart > 0) {
+                scan = s->window + s->strstart - 1;
+                prev = *scan;
+                if (prev == *++scan && prev == *++scan && prev == *++scan) {
+                    strend = s->window + s->strstart + MAX_MATCH;
+                    do {
+                    } while (prev == *++scan && prev == *++scan &&
+                             prev == *++scan && prev == *++scan &&
+                             prev == *++scan && prev == *++scan &&
+                             prev == *++scan && prev == *++scan &&
+                             scan < strend);
+                    s->match_length = MAX_MATCH - (uInt)(strend - scan);
+                    if (s->match_length > s->lookahead)
+                        s->match_length = s->lookahead;
+                }
+                Assert(scan <= s->window+(uInt)(s->window_size-1), "wild scan");
+            }
+
+            if (s->match_length >= MIN_MATCH) {
+                check_match(s, s->strstart, s->strstart - 1, s->match_length);
+                _tr_tally_dist(s, 1, s->match_length - MIN_MATCH, bflush);
+                s->lookahead -= s->match_length;
+                s->strstart += s->match_length;
+                s->match_length = 0;
+            } else {
+                Tracevv((stderr,"%c", s->window[s->strstart]));
+                _tr_tally_lit (s, s->window[s->strstart], bflush);
+                s->lookahead--;
+                s->strstart++;
+            }
+        }
+        if (bflush) FLUSH_BLOCK(s, 0);
+    }
+    s->insert = 0;
+    if (flush == Z_FINISH) {
+        FLUSH_BLOCK(s, 1);
+        return finish_done;
+    }
+    if (s->last_lit)
+        FLUSH_BLOCK(s, 0);
+    return block_done;
+}
@@ -156,6 +156,20 @@
    twice this must be able to fit in an unsigned type) */
 #define GZBUFSIZE 8192
 
+#ifdef AOCL_ZLIB_OPT
+/* pipelined i/o, requested with 'p' in the gzopen() mode: gzread() maps the
+   input file instead of copying it through the input buffer, and gzwrite()
+   writes out each full output buffer on a background thread.  Unless
+   gzbuffer() sets a size, these files use the larger GZPIPEBUFSIZE buffers,
+   which cut the number of read()/write() calls and give inflate()/deflate()
+   longer runs per call. */
+#  define GZPIPEBUFSIZE 131072
+#  if !defined(_WIN32)
+#    define AOCL_GZ_MMAP
+#  endif
+#  define AOCL_GZ_ASYNC
+#endif
+
 /* gzip modes, also provide a little integrity check on the passed structure */
 #define GZ_NONE 0
 #define GZ_READ 7247
@@ -199,6 +213,13 @@ typedef struct {
     char *msg;              /* error message */
         /* zlib inflate or deflate stream */
     z_stream strm;          /* stream structure in-place (not a pointer) */
+#ifdef AOCL_ZLIB_OPT
+        /* pipelined i/o */
+    int pipe;               /* true if 'p' was given in the mode */
+    unsigned char *map;     /* mapping of the input file, or NULL */
+    z_off64_t map_len;      /* length of the mapping, -1 if it failed */
+    voidp async;            /* background writer state, or NULL */
+#endif
 } gz_state;
 typedef gz_state FAR *gz_statep;
 
@@ -236,3 +257,13 @@ unsigned ZLIB_INTERNAL gz_intmax OF((void));
 #define AOCL_READ_GZ read
 #define AOCL_WRITE_GZ write
 #endif
+
+#if defined(_WIN32) && !defined(__BORLANDC__) && !defined(__MINGW32__)
+#  define LSEEK _lseeki64
+#else
+#if defined(_LARGEFILE64_SOURCE) && _LFS64_LARGEFILE-0
+#  define LSEEK lseek64
+#else
+#  define LSEEK lseek
+#endif
+#endif
@@ -6,16 +6,6 @@
 
 #include "gzguts.h"
 
-#if defined(_WIN32) && !defined(__BORLANDC__) && !defined(__MINGW32__)
-#  define LSEEK _lseeki64
-#else
-#if defined(_LARGEFILE64_SOURCE) && _LFS64_LARGEFILE-0
-#  define LSEEK lseek64
-#else
-#  define LSEEK lseek
-#endif
-#endif
-
 /* Local functions */
 local void gz_reset OF((gz_statep));
 local gzFile gz_open OF((const void *, int, const char *));
@@ -133,6 +123,12 @@ local gzFile gz_open(path, fd, mode)
     state->level = Z_DEFAULT_COMPRESSION;
     state->strategy = Z_DEFAULT_STRATEGY;
     state->direct = 0;
+#ifdef AOCL_ZLIB_OPT
+    state->pipe = 0;
+    state->map = NULL;
+    state->map_len = 0;
+    state->async = NULL;
+#endif
     while (*mode) {
         if (*mode >= '0' && *mode <= '9')
             state->level = *mode - '0';
@@ -179,6 +175,11 @@ local gzFile gz_open(path, fd, mode)
             case 'T':
                 state->direct = 1;
                 break;
+#ifdef AOCL_ZLIB_OPT
+            case 'p':
+                state->pipe = 1;
+                break;
+#endif
             default:        /* could consider as an error, but just ignore */
                 ;
             }
@@ -190,6 +191,10 @@ local gzFile gz_open(path, fd, mode)
         free(state);
         return NULL;
     }
+#ifdef AOCL_ZLIB_OPT
+    if (state->pipe)
+        state->want = GZPIPEBUFSIZE;
+#endif
 
     /* can't force transparent read */
     if (state->mode == GZ_READ) {
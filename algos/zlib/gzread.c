@@ -6,8 +6,17 @@
 
 #include "gzguts.h"
 
+#ifdef AOCL_GZ_MMAP
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 /* Local functions */
 local int gz_load OF((gz_statep, unsigned char *, unsigned, unsigned *));
+#ifdef AOCL_GZ_MMAP
+local int gz_map_avail OF((gz_statep));
+#endif
 local int gz_avail OF((gz_statep));
 local int gz_look OF((gz_statep));
 local int gz_decomp OF((gz_statep));
@@ -51,6 +60,69 @@ local int gz_load(state, buf, len, have)
     return 0;
 }
 
+#ifdef AOCL_GZ_MMAP
+/* Provide the next state->size bytes of the input file to inflate() straight
+   from a read-only mapping of the file, with no copy through state->in.  The
+   file is mapped on first use.  The file offset is moved past the bytes handed
+   out, so gzoffset(), gzseek() and the read() path all see the same position,
+   and the kernel is asked to start reading the chunk after this one while it
+   is being decompressed.  Return 1 if input was provided, 0 if the caller
+   should use read() instead (not a regular file, mapping failed, or past the
+   mapped length), or -1 on error. */
+#ifdef ENABLE_STRICT_WARNINGS
+local int gz_map_avail(gz_statep state)
+#else
+local int gz_map_avail(state)
+    gz_statep state;
+#endif /* ENABLE_STRICT_WARNINGS */
+{
+    z_off64_t pos, next;
+    z_streamp strm = &(state->strm);
+
+    if (state->map == NULL) {
+        struct stat st;
+        void *map;
+
+        if (state->map_len == -1)
+            return 0;
+        state->map_len = -1;
+        if (fstat(state->fd, &st) == -1 || !S_ISREG(st.st_mode) ||
+            st.st_size <= 0 || (z_off64_t)(size_t)st.st_size != st.st_size)
+            return 0;
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE,
+                   state->fd, 0);
+        if (map == MAP_FAILED)
+            return 0;
+        madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+        state->map = (unsigned char *)map;
+        state->map_len = st.st_size;
+    }
+
+    pos = LSEEK(state->fd, 0, SEEK_CUR);
+    if (pos == -1 || pos >= state->map_len)
+        return 0;
+    next = state->map_len - pos > state->size ? pos + state->size :
+                                                state->map_len;
+    if (LSEEK(state->fd, next, SEEK_SET) == -1) {
+        gz_error(state, Z_ERRNO, zstrerror());
+        return -1;
+    }
+    strm->next_in = state->map + pos;
+    strm->avail_in = (unsigned)(next - pos);
+
+    /* prefetch the following chunk */
+    if (next < state->map_len) {
+        z_off64_t page = next & ~(z_off64_t)(sysconf(_SC_PAGESIZE) - 1);
+        z_off64_t len = state->map_len - page;
+
+        if (len > (z_off64_t)state->size)
+            len = state->size;
+        madvise(state->map + page, (size_t)len, MADV_WILLNEED);
+    }
+    return 1;
+}
+#endif /* AOCL_GZ_MMAP */
+
 /* Load up input buffer and set eof flag if last data loaded -- return -1 on
    error, 0 otherwise.  Note that the eof flag is set when the end of the input
    file is reached, even though there may be unused data in the buffer.  Once
@@ -70,6 +142,16 @@ local int gz_avail(state)
 
     if (state->err != Z_OK && state->err != Z_BUF_ERROR)
         return -1;
+#ifdef AOCL_GZ_MMAP
+    /* pipelined: once in a gzip stream, inflate straight from the mapping */
+    if (state->pipe && state->how == GZIP && state->eof == 0 &&
+        strm->avail_in == 0) {
+        int ret = gz_map_avail(state);
+
+        if (ret != 0)
+            return ret == -1 ? -1 : 0;
+    }
+#endif
     if (state->eof == 0) {
         if (strm->avail_in) {       /* copy what's there to the start */
             unsigned char *p = state->in;
@@ -706,6 +788,10 @@ int ZEXPORT gzclose_r(file)
         free(state->out);
         free(state->in);
     }
+#ifdef AOCL_GZ_MMAP
+    if (state->map != NULL)
+        munmap(state->map, (size_t)state->map_len);
+#endif
     err = state->err == Z_BUF_ERROR ? Z_BUF_ERROR : Z_OK;
     gz_error(state, Z_OK, NULL);
     free(state->path);
@@ -6,12 +6,171 @@
 
 #include "gzguts.h"
 
+#ifdef AOCL_GZ_ASYNC
+#  include "zthread.h"
+#endif
+
 /* Local functions */
 local int gz_init OF((gz_statep));
 local int gz_comp OF((gz_statep, int));
 local int gz_zero OF((gz_statep, z_off64_t));
 local z_size_t gz_write OF((gz_statep, voidpc, z_size_t));
 
+#ifdef AOCL_GZ_ASYNC
+/* Background writer for pipelined output.  Each gzFile opened for writing in
+   'p' mode has one writer thread, started by gz_init() and stopped by
+   gzclose_w().  When the output buffer fills up, it is handed to the thread,
+   which writes it to the file while deflate() carries on in a second buffer.
+   At most one write is in flight.  Flushes and gzclose() wait for it and write
+   synchronously, and an error from a background write is reported by the next
+   gz_comp() call. */
+typedef struct {
+    int fd;                 /* file to write to */
+    z_mutex mutex;          /* protects buf, len, err and stop */
+    z_cond cond;            /* buf was handed over or written, or stop set */
+    unsigned char *buf;     /* data to write, NULL when the thread is idle */
+    unsigned len;
+    int err;                /* errno of a failed write, or 0 */
+    int stop;               /* true to end the thread once idle */
+    unsigned char *spare;   /* the output buffer not in use by deflate() */
+    z_thread thread;
+} gz_writer;
+
+/* Write len bytes from buf to fd, looping on partial writes.  Return 0 on
+   success or errno on failure. */
+local int gz_write_all(int fd, unsigned char *buf, unsigned len)
+{
+    int writ;
+    unsigned put, max = ((unsigned)-1 >> 2) + 1;
+
+    while (len) {
+        put = len > max ? max : len;
+        writ = AOCL_WRITE_GZ(fd, buf, put);
+        if (writ < 0)
+            return errno ? errno : EIO;
+        buf += writ;
+        len -= (unsigned)writ;
+    }
+    return 0;
+}
+
+/* Writer thread: write each buffer handed over until stopped. */
+local void gz_writer_run(void *arg)
+{
+    gz_writer *w = (gz_writer *)arg;
+    int err;
+
+    z_mutex_lock(&w->mutex);
+    for (;;) {
+        while (w->buf == NULL && !w->stop)
+            z_cond_wait(&w->cond, &w->mutex);
+        if (w->buf == NULL)
+            break;
+        z_mutex_unlock(&w->mutex);
+        err = gz_write_all(w->fd, w->buf, w->len);
+        z_mutex_lock(&w->mutex);
+        if (w->err == 0)
+            w->err = err;
+        w->buf = NULL;
+        z_cond_broadcast(&w->cond);
+    }
+    z_mutex_unlock(&w->mutex);
+}
+
+/* Start the writer thread of state.  If it cannot be started, leave
+   state->async NULL to write synchronously. */
+local void gz_async_start(gz_statep state)
+{
+    gz_writer *w = (gz_writer *)malloc(sizeof(gz_writer));
+    unsigned char *spare = (unsigned char *)malloc(state->want);
+
+    if (w == NULL || spare == NULL) {
+        free(spare);
+        free(w);
+        return;
+    }
+    w->fd = state->fd;
+    w->buf = NULL;
+    w->err = 0;
+    w->stop = 0;
+    w->spare = spare;
+    z_mutex_init(&w->mutex);
+    z_cond_init(&w->cond);
+    if (!z_thread_create(&w->thread, gz_writer_run, w)) {
+        z_cond_destroy(&w->cond);
+        z_mutex_destroy(&w->mutex);
+        free(spare);
+        free(w);
+        return;
+    }
+    state->async = w;
+}
+
+/* Wait for the write in flight, if any.  Return -1 if it failed, else 0. */
+local int gz_async_wait(gz_statep state)
+{
+    gz_writer *w = (gz_writer *)state->async;
+    int err;
+
+    z_mutex_lock(&w->mutex);
+    while (w->buf != NULL)
+        z_cond_wait(&w->cond, &w->mutex);
+    err = w->err;
+    w->err = 0;
+    z_mutex_unlock(&w->mutex);
+    if (err) {
+        errno = err;
+        gz_error(state, Z_ERRNO, zstrerror());
+        return -1;
+    }
+    return 0;
+}
+
+/* Hand the pending output to the writer thread and give deflate() the spare
+   buffer.  Return -1 if the previous write failed, else 0. */
+local int gz_async_put(gz_statep state)
+{
+    gz_writer *w = (gz_writer *)state->async;
+    z_streamp strm = &(state->strm);
+    unsigned char *full = state->out;
+
+    if (gz_async_wait(state) == -1)
+        return -1;
+    z_mutex_lock(&w->mutex);
+    w->len = (unsigned)(strm->next_out - state->x.next);
+    w->buf = state->x.next;
+    z_cond_broadcast(&w->cond);
+    z_mutex_unlock(&w->mutex);
+
+    state->out = w->spare;
+    w->spare = full;
+    strm->avail_out = state->size;
+    strm->next_out = state->out;
+    state->x.next = state->out;
+    return 0;
+}
+
+/* Wait for the write in flight, stop the writer thread and free it.  Return
+   -1 if the last write failed, else 0. */
+local int gz_async_end(gz_statep state)
+{
+    gz_writer *w = (gz_writer *)state->async;
+    int ret = gz_async_wait(state);
+
+    z_mutex_lock(&w->mutex);
+    w->stop = 1;
+    z_cond_broadcast(&w->cond);
+    z_mutex_unlock(&w->mutex);
+    z_thread_join(&w->thread);
+    z_cond_destroy(&w->cond);
+    z_mutex_destroy(&w->mutex);
+    free(w->spare);
+    free(w);
+    state->async = NULL;
+    return ret;
+}
+#endif /* AOCL_GZ_ASYNC */
+
 /* Initialize state for writing a gzip file.  Mark initialization by setting
    state->size to non-zero.  Return -1 on a memory allocation failure, or 0 on
    success. */
@@ -55,6 +214,13 @@ local int gz_init(state)
             return -1;
         }
         strm->next_in = NULL;
+
+#ifdef AOCL_GZ_ASYNC
+        /* pipelined output needs a second buffer and the writer thread --
+           without them, just write synchronously */
+        if (state->pipe)
+            gz_async_start(state);
+#endif
     }
 
     /* mark state as initialized */
@@ -113,6 +279,20 @@ local int gz_comp(state, flush)
            doing Z_FINISH then don't write until we get to Z_STREAM_END */
         if (strm->avail_out == 0 || (flush != Z_NO_FLUSH &&
             (flush != Z_FINISH || ret == Z_STREAM_END))) {
+#ifdef AOCL_GZ_ASYNC
+            if (state->async != NULL) {
+                /* overlap writing a full buffer with compressing the next
+                   one, but complete all writes before a flush returns */
+                if (flush == Z_NO_FLUSH || (flush == Z_FINISH &&
+                                            ret != Z_STREAM_END)) {
+                    if (gz_async_put(state) == -1)
+                        return -1;
+                    goto compress;
+                }
+                if (gz_async_wait(state) == -1)
+                    return -1;
+            }
+#endif
             while (strm->next_out > state->x.next) {
                 put = strm->next_out - state->x.next > (int)max ? max :
                       (unsigned)(strm->next_out - state->x.next);
@@ -131,6 +311,9 @@ local int gz_comp(state, flush)
         }
 
         /* compress */
+#ifdef AOCL_GZ_ASYNC
+compress:
+#endif
         have = strm->avail_out;
         ret = deflate(strm, flush);
         if (ret == Z_STREAM_ERROR) {
@@ -699,6 +882,10 @@ int ZEXPORT gzclose_w(file)
     /* flush, free memory, and close file */
     if (gz_comp(state, Z_FINISH) == -1)
         ret = state->err;
+#ifdef AOCL_GZ_ASYNC
+    if (state->async != NULL && gz_async_end(state) == -1)
+        ret = state->err;
+#endif
     if (state->size) {
         if (!state->direct) {
             (void)deflateEnd(&(state->strm));
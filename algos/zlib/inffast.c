@@ -291,6 +291,14 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
             state->mode = TYPE;
             break;
         }
+#ifdef AOCL_ZLIB_OPT
+        else if (op == INFLATE64_LEN_OP) {      /* Deflate64 long length */
+            state->length = (unsigned)(here.val);
+            state->extra = 16;
+            state->mode = LENEXT;
+            break;
+        }
+#endif
         else {
             strm->msg = (char *)"invalid literal/length code";
             state->mode = BAD;
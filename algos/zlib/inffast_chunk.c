@@ -10,6 +10,9 @@
 #include "inflate.h"
 #include "inffast_chunk.h"
 #include "chunkcopy.h"
+#ifdef AOCL_ZLIB_AVX2_OPT
+#include <immintrin.h>
+#endif
 #ifdef AOCL_ZLIB_SSE2_OPT
 #ifdef ASMINF
 #  pragma message("Assembler code may have bugs -- use at your own risk")
@@ -326,6 +329,12 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
             state->mode = TYPE;
             break;
         }
+        else if (op == INFLATE64_LEN_OP) {      /* Deflate64 long length */
+            state->length = (unsigned)(here->val);
+            state->extra = 16;
+            state->mode = LENEXT;
+            break;
+        }
         else {
             strm->msg = (char *)"invalid literal/length code";
             state->mode = BAD;
@@ -363,5 +372,367 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
    - Larger unrolled copy loops (three is about right)
    - Moving len -= 3 statement into middle of loop
  */
+#ifdef AOCL_ZLIB_AVX2_OPT
+/*
+   inflate_fast_chunk_avx2() is inflate_fast_chunk_() with two changes:
+
+   - Length/literal codes are looked up in state->mlit, a copy of the root of
+     the length/literal table indexed by INFLATE_MLIT_BITS input bits, which
+     is built the first time a block is decoded here. Where the first code is
+     a literal, the entry instead holds that literal together with the next
+     one when both codes fit in the index bits, so pairs of short literals
+     take one lookup and one 2-byte store.
+   - Matches within the current output are copied 32 bytes at a time. For
+     distances below 16 the repeating pattern is built once with a byte
+     shuffle and stored in 32-byte steps that are a multiple of the period.
+
+   Both may write a few bytes beyond the decoded output, which is covered by
+   the larger INFLATE_FAST_MIN_OUTPUT margin defined in inffast_chunk.h.
+ */
+
+/* A state->mlit entry with a zero low byte (op == 0) holds literals, any
+   other entry is the root table code for its index. */
+#define MLIT_IS_LIT(e)  (((e) & 0xff) == 0)
+#define MLIT_BITS(e)    (((e) >> 8) & 15)       /* input bits used */
+#define MLIT_COUNT(e)   ((((e) >> 12) & 1) + 1) /* number of literals */
+#define MLIT_LITS(e)    ((uint16_t)((e) >> 16)) /* first in low byte */
+
+typedef char mlit_code_size[sizeof(code) == sizeof(uint32_t) ? 1 : -1];
+
+local void inflate_build_mlit(struct inflate_state FAR *state)
+{
+    code const FAR *lcode = state->lencode;
+    unsigned lmask = (1U << state->lenbits) - 1;
+    unsigned i;
+
+    for (i = 0; i < (1U << INFLATE_MLIT_BITS); i++) {
+        code here = lcode[i & lmask];
+        uint32_t entry;
+
+        if (here.op == 0) {
+            /* the second code is only trusted if it lies completely within
+               the index bits not taken by the first one */
+            code next = lcode[(i >> here.bits) & lmask];
+            unsigned used = here.bits;
+            unsigned pair = next.op == 0 &&
+                            used + next.bits <= INFLATE_MLIT_BITS;
+
+            if (pair)
+                used += next.bits;
+            entry = ((uint32_t)(pair ? next.val : 0) << 24) |
+                    ((uint32_t)here.val << 16) | (pair << 12) | (used << 8);
+        }
+        else {
+            Z_BUILTIN_MEMCPY(&entry, &here, sizeof(entry));
+        }
+        state->mlit[i] = entry;
+    }
+    state->mlitbits = INFLATE_MLIT_BITS;
+}
+
+/* Row d repeats the byte indices 0..d-1, to splat a period d pattern */
+static const uint8_t chunkset_avx2_perm[16][32] __attribute__((aligned(32))) = {
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    {  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1,  0,  1 },
+    {  0,  1,  2,  0,  1,  2,  0,  1,  2,  0,  1,  2,  0,  1,  2,  0,  1,  2,  0,  1,  2,  0,  1,  2,  0,  1,  2,  0,  1,  2,  0,  1 },
+    {  0,  1,  2,  3,  0,  1,  2,  3,  0,  1,  2,  3,  0,  1,  2,  3,  0,  1,  2,  3,  0,  1,  2,  3,  0,  1,  2,  3,  0,  1,  2,  3 },
+    {  0,  1,  2,  3,  4,  0,  1,  2,  3,  4,  0,  1,  2,  3,  4,  0,  1,  2,  3,  4,  0,  1,  2,  3,  4,  0,  1,  2,  3,  4,  0,  1 },
+    {  0,  1,  2,  3,  4,  5,  0,  1,  2,  3,  4,  5,  0,  1,  2,  3,  4,  5,  0,  1,  2,  3,  4,  5,  0,  1,  2,  3,  4,  5,  0,  1 },
+    {  0,  1,  2,  3,  4,  5,  6,  0,  1,  2,  3,  4,  5,  6,  0,  1,  2,  3,  4,  5,  6,  0,  1,  2,  3,  4,  5,  6,  0,  1,  2,  3 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  0,  1,  2,  3,  4,  5,  6,  7,  0,  1,  2,  3,  4,  5,  6,  7,  0,  1,  2,  3,  4,  5,  6,  7 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  0,  1,  2,  3,  4,  5,  6,  7,  8,  0,  1,  2,  3,  4,  5,  6,  7,  8,  0,  1,  2,  3,  4 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  0,  1 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11,  0,  1,  2,  3,  4,  5,  6,  7 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12,  0,  1,  2,  3,  4,  5 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13,  0,  1,  2,  3 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,  0,  1 }
+};
+
+/* Largest multiple of d not above 32: the store step for a period d pattern */
+static const uint8_t chunkset_avx2_step[16] = {
+    0, 32, 32, 30, 32, 30, 30, 28, 32, 27, 30, 22, 24, 26, 28, 30
+};
+
+/*
+ * Copy len bytes from dist bytes back in the output. len is non-zero and it
+ * is OK to write up to 31 bytes beyond out + len.
+ */
+__attribute__((__target__("avx2")))
+static inline unsigned char FAR* chunkcopy_lapped_avx2(
+    unsigned char FAR* out,
+    unsigned dist,
+    unsigned len) {
+    if (dist < 16) {
+        unsigned char FAR* end = out + len;
+        const unsigned step = chunkset_avx2_step[dist];
+        __m256i v = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128((const __m128i*)(out - dist)));
+        v = _mm256_shuffle_epi8(v,
+            _mm256_load_si256((const __m256i*)chunkset_avx2_perm[dist]));
+        do {
+            _mm256_storeu_si256((__m256i*)out, v);
+            out += step;
+        } while (out < end);
+        return end;
+    }
+    if (dist < 32) {
+        return chunkcopy_core(out, out - dist, len);
+    }
+    else {
+        const unsigned char FAR* from = out - dist;
+        const unsigned bump = ((len - 1) & 31) + 1;
+        _mm256_storeu_si256((__m256i*)out,
+                            _mm256_loadu_si256((const __m256i*)from));
+        out += bump;
+        from += bump;
+        len -= bump;
+        while (len > 0) {
+            _mm256_storeu_si256((__m256i*)out,
+                                _mm256_loadu_si256((const __m256i*)from));
+            out += 32;
+            from += 32;
+            len -= 32;
+        }
+        return out;
+    }
+}
+
+__attribute__((__target__("avx2")))
+void ZLIB_INTERNAL inflate_fast_chunk_avx2(z_streamp strm, unsigned start)
+{
+    struct inflate_state FAR *state;
+    z_const unsigned char FAR *in;      /* local strm->next_in */
+    z_const unsigned char FAR *last;    /* have enough input while in < last */
+    unsigned char FAR *out;     /* local strm->next_out */
+    unsigned char FAR *beg;     /* inflate()'s initial strm->next_out */
+    unsigned char FAR *end;     /* while out < end, enough space available */
+    unsigned char FAR *limit;   /* safety limit for chunky copies */
+#ifdef INFLATE_STRICT
+    unsigned dmax;              /* maximum distance from zlib header */
+#endif
+    unsigned wsize;             /* window size or zero if not using window */
+    unsigned whave;             /* valid bytes in the window */
+    unsigned wnext;             /* window write index */
+    unsigned char FAR *window;  /* allocated sliding window, if wsize != 0 */
+    inflate_holder_t hold;      /* local strm->hold */
+    unsigned bits;              /* local strm->bits */
+    code const FAR *lcode;      /* local strm->lencode */
+    code const FAR *dcode;      /* local strm->distcode */
+    const uint32_t FAR *mlit;   /* local state->mlit */
+    unsigned mmask;             /* mask for multi-literal table */
+    unsigned dmask;             /* mask for first level of distance codes */
+    code here;                  /* retrieved table entry */
+    uint32_t entry;             /* retrieved multi-literal entry */
+    unsigned op;                /* code bits, operation, extra bits, or */
+                                /*  window position, window bytes to copy */
+    unsigned len;               /* match length, unused bytes */
+    unsigned dist;              /* match distance */
+    unsigned char FAR *from;    /* where to copy match from */
+    /* copy state to local variables */
+    state = (struct inflate_state FAR *)strm->state;
+    if (state->mlitbits == 0)
+        inflate_build_mlit(state);
+    in = strm->next_in;
+    last = in + (strm->avail_in - (INFLATE_FAST_MIN_INPUT - 1));
+    out = strm->next_out;
+    beg = out - (start - strm->avail_out);
+    end = out + (strm->avail_out - (INFLATE_FAST_MIN_OUTPUT - 1));
+    limit = out + strm->avail_out;
+#ifdef INFLATE_STRICT
+    dmax = state->dmax;
+#endif
+    wsize = state->wsize;
+    whave = state->whave;
+    wnext = (state->wnext == 0 && whave >= wsize) ? wsize : state->wnext;
+    window = state->window;
+    hold = state->hold;
+    bits = state->bits;
+    lcode = state->lencode;
+    dcode = state->distcode;
+    mlit = state->mlit;
+    mmask = (1U << INFLATE_MLIT_BITS) - 1;
+    dmask = (1U << state->distbits) - 1;
+    /* decode literals and length/distances until end-of-block or not enough
+       input data or output space */
+    do {
+        REFILL();
+        /* up to two lookups of a literal pair, 2 * INFLATE_MLIT_BITS input
+           bits, leave the same budget as inflate_fast_chunk_() for a match */
+        entry = mlit[hold & mmask];
+        if (MLIT_IS_LIT(entry)) {
+            uint16_t lits = MLIT_LITS(entry);
+            Tracevv((stderr, "inflate:         %u literal(s)\n",
+                    MLIT_COUNT(entry)));
+            Z_BUILTIN_MEMCPY(out, &lits, sizeof(lits));
+            out += MLIT_COUNT(entry);
+            hold >>= MLIT_BITS(entry);
+            bits -= MLIT_BITS(entry);
+            entry = mlit[hold & mmask];
+            if (MLIT_IS_LIT(entry)) {
+                lits = MLIT_LITS(entry);
+                Tracevv((stderr, "inflate:    2nd  %u literal(s)\n",
+                        MLIT_COUNT(entry)));
+                Z_BUILTIN_MEMCPY(out, &lits, sizeof(lits));
+                out += MLIT_COUNT(entry);
+                hold >>= MLIT_BITS(entry);
+                bits -= MLIT_BITS(entry);
+                continue;
+            }
+        }
+        Z_BUILTIN_MEMCPY(&here, &entry, sizeof(here));
+      dolen:
+        op = (unsigned)(here.bits);
+        hold >>= op;
+        bits -= op;
+        op = (unsigned)(here.op);
+        if (op == 0) {                          /* literal */
+            Tracevv((stderr, here.val >= 0x20 && here.val < 0x7f ?
+                    "inflate:         literal '%c'\n" :
+                    "inflate:         literal 0x%02x\n", here.val));
+            *out++ = (unsigned char)(here.val);
+        }
+        else if (op & 16) {                     /* length base */
+            len = (unsigned)(here.val);
+            op &= 15;                           /* number of extra bits */
+            if (op) {
+                len += (unsigned)hold & ((1U << op) - 1);
+                hold >>= op;
+                bits -= op;
+            }
+            Tracevv((stderr, "inflate:         length %u\n", len));
+            here = dcode[hold & dmask];
+          dodist:
+            op = (unsigned)(here.bits);
+            hold >>= op;
+            bits -= op;
+            op = (unsigned)(here.op);
+            if (op & 16) {                      /* distance base */
+                dist = (unsigned)(here.val);
+                op &= 15;                       /* number of extra bits */
+                if (bits < op) {
+                    REFILL();
+                }
+                dist += (unsigned)hold & ((1U << op) - 1);
+#ifdef INFLATE_STRICT
+                if (dist > dmax) {
+                    strm->msg = (char *)"invalid distance too far back";
+                    state->mode = BAD;
+                    break;
+                }
+#endif
+                hold >>= op;
+                bits -= op;
+                Tracevv((stderr, "inflate:         distance %u\n", dist));
+                op = (unsigned)(out - beg);     /* max distance in output */
+                if (dist > op) {                /* see if copy from window */
+                    op = dist - op;             /* distance back in window */
+                    if (op > whave) {
+                        if (state->sane) {
+                            strm->msg =
+                                (char *)"invalid distance too far back";
+                            state->mode = BAD;
+                            break;
+                        }
+#ifdef INFLATE_ALLOW_INVALID_DISTANCE_TOOFAR_ARRR
+                        if (len <= op - whave) {
+                            do {
+                                *out++ = 0;
+                            } while (--len);
+                            continue;
+                        }
+                        len -= op - whave;
+                        do {
+                            *out++ = 0;
+                        } while (--op > whave);
+                        if (op == 0) {
+                            from = out - dist;
+                            do {
+                                *out++ = *from++;
+                            } while (--len);
+                            continue;
+                        }
+#endif
+                    }
+                    from = window;
+                    if (wnext >= op) {          /* contiguous in window */
+                        from += wnext - op;
+                    }
+                    else {                      /* wrap around window */
+                        op -= wnext;
+                        from += wsize - op;
+                        if (op < len) {         /* some from end of window */
+                            len -= op;
+                            out = chunkcopy_safe(out, from, op, limit);
+                            from = window;      /* more from start of window */
+                            op = wnext;
+                        }
+                    }
+                    if (op < len) {             /* still need some from output */
+                        out = chunkcopy_safe(out, from, op, limit);
+                        len -= op;
+                        out = chunkunroll_relaxed(out, &dist, &len);
+                        out = chunkcopy_safe_ugly(out, dist, len, limit);
+                    } else {
+                        out = chunkcopy_safe(out, from, len, limit);
+                    }
+                }
+                else {
+                    /* Whole reference is in range of current output, and
+                       there is room for 31 bytes of overrun past it. */
+                    out = chunkcopy_lapped_avx2(out, dist, len);
+                }
+            }
+            else if ((op & 64) == 0) {          /* 2nd level distance code */
+                here = dcode[here.val + (hold & ((1U << op) - 1))];
+                goto dodist;
+            }
+            else {
+                strm->msg = (char *)"invalid distance code";
+                state->mode = BAD;
+                break;
+            }
+        }
+        else if ((op & 64) == 0) {              /* 2nd level length code */
+            here = lcode[here.val + (hold & ((1U << op) - 1))];
+            goto dolen;
+        }
+        else if (op & 32) {                     /* end-of-block */
+            Tracevv((stderr, "inflate:         end of block\n"));
+            state->mode = TYPE;
+            break;
+        }
+        else if (op == INFLATE64_LEN_OP) {      /* Deflate64 long length */
+            state->length = (unsigned)(here.val);
+            state->extra = 16;
+            state->mode = LENEXT;
+            break;
+        }
+        else {
+            strm->msg = (char *)"invalid literal/length code";
+            state->mode = BAD;
+            break;
+        }
+    } while (in < last && out < end);
+    /* return unused bytes (on entry, bits < 8, so in won't go too far back) */
+    len = bits >> 3;
+    in -= len;
+    bits -= len << 3;
+    hold &= (1U << bits) - 1;
+    /* update state and return */
+    strm->next_in = in;
+    strm->next_out = out;
+    strm->avail_in = (unsigned)(in < last ?
+        (INFLATE_FAST_MIN_INPUT - 1) + (last - in) :
+        (INFLATE_FAST_MIN_INPUT - 1) - (in - last));
+    strm->avail_out = (unsigned)(out < end ?
+        (INFLATE_FAST_MIN_OUTPUT - 1) + (end - out) :
+        (INFLATE_FAST_MIN_OUTPUT - 1) - (out - end));
+    state->hold = hold;
+    state->bits = bits;
+    Assert((state->hold >> state->bits) == 0, "invalid input data state");
+}
+#endif /* AOCL_ZLIB_AVX2_OPT */
 #endif /* !ASMINF */
 #endif /* AOCL_ZLIB_SSE2_OPT */
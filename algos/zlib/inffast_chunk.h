@@ -34,7 +34,17 @@
 #undef INFLATE_FAST_MIN_INPUT
 #define INFLATE_FAST_MIN_INPUT 15
 #undef INFLATE_FAST_MIN_OUTPUT
+#ifdef AOCL_ZLIB_AVX2_OPT
+/* inflate_fast_chunk_avx2() may output 4 literals from two literal pair
+   lookups ahead of a 258 byte match, and its short-distance pattern copy may
+   write up to 31 bytes beyond the end of the match: 4 + 258 + 31 = 293. */
+#define INFLATE_FAST_MIN_OUTPUT 293
+#else
 #define INFLATE_FAST_MIN_OUTPUT 260
 #endif
+#endif
 void ZLIB_INTERNAL inflate_fast_chunk_ OF((z_streamp strm, unsigned start));
+#ifdef AOCL_ZLIB_AVX2_OPT
+void ZLIB_INTERNAL inflate_fast_chunk_avx2 OF((z_streamp strm, unsigned start));
+#endif
 #endif /* AOCL_ZLIB_SSE2_OPT */
@@ -102,6 +102,9 @@
 /* function prototypes */
 local int inflateStateCheck OF((z_streamp strm));
 local void fixedtables OF((struct inflate_state FAR *state));
+#ifdef AOCL_ZLIB_OPT
+local void fixedtables64 OF((struct inflate_state FAR *state));
+#endif
 local int updatewindow OF((z_streamp strm, const unsigned char FAR *end,
                            unsigned copy));
 #ifdef BUILDFIXED
@@ -153,10 +156,17 @@ z_streamp strm;
     state->last = 0;
     state->havedict = 0;
     state->dmax = 32768U;
+#ifdef AOCL_ZLIB_OPT
+    if (state->deflate64)
+        state->dmax = 65536U;
+#endif
     state->head = Z_NULL;
     state->hold = 0;
     state->bits = 0;
     state->lencode = state->distcode = state->next = state->codes;
+#ifdef AOCL_ZLIB_AVX2_OPT
+    state->mlitbits = 0;
+#endif
     state->sane = 1;
     state->back = -1;
     Tracev((stderr, "inflate: reset\n"));
@@ -219,6 +229,9 @@ int windowBits;
     /* update state and reset the rest of it */
     state->wrap = wrap;
     state->wbits = (unsigned)windowBits;
+#ifdef AOCL_ZLIB_OPT
+    state->deflate64 = 0;
+#endif
     return inflateReset(strm);
 }
 
@@ -282,6 +295,37 @@ int stream_size;
     return inflateInit2_(strm, DEF_WBITS, version, stream_size);
 }
 
+#ifdef ENABLE_STRICT_WARNINGS
+int ZEXPORT aocl_inflateDeflate64(z_streamp strm)
+#else
+int ZEXPORT aocl_inflateDeflate64(strm)
+z_streamp strm;
+#endif /* ENABLE_STRICT_WARNINGS */
+{
+#ifdef AOCL_ZLIB_OPT
+    struct inflate_state FAR *state;
+
+    if (inflateStateCheck(strm)) return Z_STREAM_ERROR;
+    state = (struct inflate_state FAR *)strm->state;
+
+    /* Deflate64 is only found raw in zip entries, and the window size must be
+       settled before the first inflate() call */
+    if (state->wrap != 0 || state->mode != HEAD)
+        return Z_STREAM_ERROR;
+    if (state->window != Z_NULL && state->wbits != 16) {
+        ZFREE(strm, state->window);
+        state->window = Z_NULL;
+    }
+    state->wbits = 16;
+    state->deflate64 = 1;
+    return inflateReset(strm);
+#else
+    /* Deflate64 is only available with AOCL optimizations */
+    (void)strm;
+    return Z_STREAM_ERROR;
+#endif /* AOCL_ZLIB_OPT */
+}
+
 #ifdef ENABLE_STRICT_WARNINGS
 int ZEXPORT inflatePrime(z_streamp strm, int bits, int value)
 #else
@@ -362,7 +406,53 @@ struct inflate_state FAR *state;
     state->lenbits = 9;
     state->distcode = distfix;
     state->distbits = 5;
+#ifdef AOCL_ZLIB_AVX2_OPT
+    state->mlitbits = 0;
+#endif
+}
+
+#ifdef AOCL_ZLIB_OPT
+/*
+   Build the fixed code tables of Deflate64 in state->codes.  They differ from
+   the static ones above in the meaning of length code 285 and the validity of
+   distance codes 30 and 31, and are rebuilt for every fixed block, which is
+   rare enough in Deflate64 streams not to matter.
+ */
+#ifdef ENABLE_STRICT_WARNINGS
+local void fixedtables64(struct inflate_state FAR *state)
+#else
+local void fixedtables64(state)
+struct inflate_state FAR *state;
+#endif /* ENABLE_STRICT_WARNINGS */
+{
+    unsigned sym, bits;
+
+    /* literal/length table */
+    sym = 0;
+    while (sym < 144) state->lens[sym++] = 8;
+    while (sym < 256) state->lens[sym++] = 9;
+    while (sym < 280) state->lens[sym++] = 7;
+    while (sym < 288) state->lens[sym++] = 8;
+    state->next = state->codes;
+    state->lencode = (const code FAR *)(state->next);
+    bits = 9;
+    inflate_table(LENS64, state->lens, 288, &(state->next), &(bits),
+                  state->work);
+    state->lenbits = bits;
+
+    /* distance table */
+    sym = 0;
+    while (sym < 32) state->lens[sym++] = 5;
+    state->distcode = (const code FAR *)(state->next);
+    bits = 5;
+    inflate_table(DISTS64, state->lens, 32, &(state->next), &(bits),
+                  state->work);
+    state->distbits = bits;
+#ifdef AOCL_ZLIB_AVX2_OPT
+    state->mlitbits = 0;
+#endif
 }
+#endif /* AOCL_ZLIB_OPT */
 
 #ifdef MAKEFIXED
 #include <stdio.h>
@@ -993,6 +1083,11 @@ int flush;
                 state->mode = STORED;
                 break;
             case 1:                             /* fixed block */
+#ifdef AOCL_ZLIB_OPT
+                if (state->deflate64)
+                    fixedtables64(state);
+                else
+#endif
                 fixedtables(state);
                 Tracev((stderr, "inflate:     fixed codes block%s\n",
                         state->last ? " (last)" : ""));
@@ -1055,7 +1150,7 @@ int flush;
             state->ncode = BITS(4) + 4;
             DROPBITS(4);
 #ifndef PKZIP_BUG_WORKAROUND
-            if (state->nlen > 286 || state->ndist > 30) {
+            if (state->nlen > 286 || state->ndist > INFLATE_MAX_NDIST(state)) {
                 strm->msg = (char *)"too many length or distance symbols";
                 state->mode = BAD;
                 break;
@@ -1149,8 +1244,11 @@ int flush;
             state->next = state->codes;
             state->lencode = (const code FAR *)(state->next);
             state->lenbits = 9;
-            ret = inflate_table(LENS, state->lens, state->nlen, &(state->next),
-                                &(state->lenbits), state->work);
+#ifdef AOCL_ZLIB_AVX2_OPT
+            state->mlitbits = 0;
+#endif
+            ret = inflate_table(INFLATE_LENS(state), state->lens, state->nlen,
+                                &(state->next), &(state->lenbits), state->work);
             if (ret) {
                 strm->msg = (char *)"invalid literal/lengths set";
                 state->mode = BAD;
@@ -1158,8 +1256,9 @@ int flush;
             }
             state->distcode = (const code FAR *)(state->next);
             state->distbits = 6;
-            ret = inflate_table(DISTS, state->lens + state->nlen, state->ndist,
-                            &(state->next), &(state->distbits), state->work);
+            ret = inflate_table(INFLATE_DISTS(state), state->lens + state->nlen,
+                            state->ndist, &(state->next), &(state->distbits),
+                            state->work);
             if (ret) {
                 strm->msg = (char *)"invalid distances set";
                 state->mode = BAD;
@@ -1177,6 +1276,8 @@ int flush;
                 RESTORE();
 #ifdef AOCL_DYNAMIC_DISPATCHER
                 inflate_fast_fp(strm, out);
+#elif defined(AOCL_ZLIB_AVX2_OPT)
+                inflate_fast_chunk_avx2(strm, out);
 #else
                 inflate_fast_chunk_(strm, out);
 #endif
@@ -1224,6 +1325,13 @@ int flush;
                 state->mode = TYPE;
                 break;
             }
+#ifdef AOCL_ZLIB_OPT
+            if (here.op == INFLATE64_LEN_OP) {  /* only in Deflate64 tables */
+                state->extra = 16;
+                state->mode = LENEXT;
+                break;
+            }
+#endif
             if (here.op & 64) {
                 strm->msg = (char *)"invalid literal/length code";
                 state->mode = BAD;
@@ -1888,7 +1996,12 @@ ZEXTERN char * ZEXPORT aocl_setup_inflate_fmv(int optOff, int optLevel, int insi
     if(LIKELY(optOff == 0 && optLevel > 0))
     {
         updatewindow_fp = aocl_updatewindow;
-        inflate_fast_fp = inflate_fast_chunk_;
+#ifdef AOCL_ZLIB_AVX2_OPT
+        if (optLevel >= 3)
+            inflate_fast_fp = inflate_fast_chunk_avx2;
+        else
+#endif
+            inflate_fast_fp = inflate_fast_chunk_;
     }
     else
     {
@@ -16,6 +16,13 @@
 #  define GUNZIP
 #endif
 
+#ifdef AOCL_ZLIB_AVX2_OPT
+/* Index bits of the multi-literal table. Must not be less than the root
+   length/literal table bits (9), and two lookups plus a length/distance pair
+   must fit in the 56 bits after a refill (see inffast_chunk.c). */
+#define INFLATE_MLIT_BITS 10
+#endif
+
 /* Possible inflate modes between inflate() calls */
 typedef enum {
     HEAD = 16180,   /* i: waiting for magic header */
@@ -78,7 +85,8 @@ typedef enum {
  */
 
 /* State maintained between inflate() calls -- approximately 7K bytes, not
-   including the allocated sliding window, which is up to 32K bytes. */
+   including the allocated sliding window, which is up to 32K bytes (64K for
+   Deflate64). */
 struct inflate_state {
     z_streamp strm;             /* pointer back to this zlib stream */
     inflate_mode mode;          /* current inflate mode */
@@ -122,4 +130,29 @@ struct inflate_state {
     int sane;                   /* if false, allow invalid distance too far */
     int back;                   /* bits back of last unprocessed length/lit */
     unsigned was;               /* initial length of match */
+#ifdef AOCL_ZLIB_AVX2_OPT
+        /* multi-literal table for inflate_fast_chunk_avx2(). Its 4K (1024 x 4
+           bytes) is rebuilt for every block and shares the L1 cache with the
+           window and codes[], so it is indexed by one bit more than the 9 bit
+           root table: enough to pair the short literal codes of text. It lives
+           here, rather than in its own allocation, so inflateCopy() and
+           inflateEnd() need no change. */
+    unsigned mlitbits;          /* index bits for mlit, 0 if not built yet */
+    uint32_t mlit[1U << INFLATE_MLIT_BITS]; /* root codes or literal pairs */
+#endif
+#ifdef AOCL_ZLIB_OPT
+    int deflate64;              /* true for Deflate64 (aocl_inflateDeflate64()) */
+#endif
 };
+
+/* Code table types and distance code count of the stream being inflated.
+   Deflate64 adds a 16 extra bit length code and distance codes 30 and 31. */
+#ifdef AOCL_ZLIB_OPT
+#  define INFLATE_LENS(state)       ((state)->deflate64 ? LENS64 : LENS)
+#  define INFLATE_DISTS(state)      ((state)->deflate64 ? DISTS64 : DISTS)
+#  define INFLATE_MAX_NDIST(state)  ((state)->deflate64 ? 32U : 30U)
+#else
+#  define INFLATE_LENS(state)       LENS
+#  define INFLATE_DISTS(state)      DISTS
+#  define INFLATE_MAX_NDIST(state)  30U
+#endif
@@ -76,6 +76,23 @@ unsigned short FAR *work;
         16, 16, 16, 16, 17, 17, 18, 18, 19, 19, 20, 20, 21, 21, 22, 22,
         23, 23, 24, 24, 25, 25, 26, 26, 27, 27,
         28, 28, 29, 29, 64, 64};
+#ifdef AOCL_ZLIB_OPT
+    static const unsigned short lbase64[31] = { /* Deflate64 codes 257..285 */
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 3, 0, 0};
+    static const unsigned short lext64[31] = { /* Deflate64 codes 257..285 */
+        16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 18, 18, 18, 18,
+        19, 19, 19, 19, 20, 20, 20, 20, 21, 21, 21, 21, INFLATE64_LEN_OP,
+        77, 202};
+    static const unsigned short dbase64[32] = { /* Deflate64 codes 0..31 */
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+        8193, 12289, 16385, 24577, 32769, 49153};
+    static const unsigned short dext64[32] = { /* Deflate64 codes 0..31 */
+        16, 16, 16, 16, 17, 17, 18, 18, 19, 19, 20, 20, 21, 21, 22, 22,
+        23, 23, 24, 24, 25, 25, 26, 26, 27, 27,
+        28, 28, 29, 29, 30, 30};
+#endif
 
     /*
        Process a set of code lengths to create a canonical Huffman code.  The
@@ -193,6 +210,20 @@ unsigned short FAR *work;
         extra = lext;
         match = 257;
         break;
+#ifdef AOCL_ZLIB_OPT
+    case LENS64:                /* sized and checked as LENS from here on */
+        base = lbase64;
+        extra = lext64;
+        match = 257;
+        type = LENS;
+        break;
+    case DISTS64:               /* sized and checked as DISTS from here on */
+        base = dbase64;
+        extra = dext64;
+        match = 0;
+        type = DISTS;
+        break;
+#endif
     default:    /* DISTS */
         base = dbase;
         extra = dext;
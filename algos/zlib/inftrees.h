@@ -33,7 +33,10 @@ typedef struct {
     0001eeee - length or distance, eeee is the number of extra bits
     01100000 - end of block
     01000000 - invalid code
+    11000000 - Deflate64 length code 285: base 3 with 16 extra bits, which do
+               not fit in eeee.  The fast decoders leave it to inflate().
  */
+#define INFLATE64_LEN_OP 192
 
 /* Maximum size of the dynamic table.  The maximum number of code structures is
    1444, which is the sum of 852 for literal/length codes and 592 for distance
@@ -47,13 +50,22 @@ typedef struct {
    changed, then these maximum sizes would be need to be recalculated and
    updated. */
 #define ENOUGH_LENS 852
+#ifdef AOCL_ZLIB_OPT
+/* "enough 32 6 15" for the 32 distance codes of Deflate64 returns 594 */
+#define ENOUGH_DISTS 594
+#else
 #define ENOUGH_DISTS 592
+#endif
 #define ENOUGH (ENOUGH_LENS+ENOUGH_DISTS)
 
 /* Type of code to build for inflate_table() */
 typedef enum {
     CODES,
     LENS,
+#ifdef AOCL_ZLIB_OPT
+    LENS64,     /* Deflate64 literal/length codes */
+    DISTS64,    /* Deflate64 distance codes */
+#endif
     DISTS
 } codetype;
 
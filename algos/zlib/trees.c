@@ -188,6 +188,74 @@ local void gen_trees_header OF((void));
     put_byte(s, (uch)((ush)(w) >> 8)); \
 }
 
+#ifdef AOCL_ZLIB_OPT
+/* ===========================================================================
+ * Output a 64-bit value LSB first on the stream.
+ * IN assertion: there is enough room in pendingBuf.
+ */
+#define put_uint64(s, w) { \
+    uint64_t w64 = (w); \
+    zmemcpy(s->pending_buf + s->pending, &w64, 8); \
+    s->pending += 8; \
+}
+
+/* ===========================================================================
+ * Send a value on a given number of bits.
+ * IN assertion: length < 64 and value fits in length bits.
+ */
+#ifdef ZLIB_DEBUG
+local void send_bits      OF((deflate_state *s, uint64_t value, int length));
+
+#ifdef ENABLE_STRICT_WARNINGS
+local void send_bits
+(
+    deflate_state *s,
+    uint64_t value, /* value to send */
+    int length      /* number of bits */
+)
+#else
+local void send_bits(s, value, length)
+    deflate_state *s;
+    uint64_t value;  /* value to send */
+    int length;      /* number of bits */
+#endif /* ENABLE_STRICT_WARNINGS */
+{
+    Tracevv((stderr," l %2d v %4llx ", length, (unsigned long long)value));
+    Assert(length > 0 && length < (int)Buf_size, "invalid length");
+    s->bits_sent += (ulg)length;
+
+    /* If not enough room in bi_buf, use (valid) bits from bi_buf and
+     * (64 - bi_valid) bits from value, leaving (width - (64-bi_valid))
+     * unused bits in value. bi_valid is never 64 here, so the shifts
+     * below are always defined.
+     */
+    if (s->bi_valid + length >= (int)Buf_size) {
+        s->bi_buf |= value << s->bi_valid;
+        put_uint64(s, s->bi_buf);
+        s->bi_buf = value >> (Buf_size - s->bi_valid);
+        s->bi_valid += length - Buf_size;
+    } else {
+        s->bi_buf |= value << s->bi_valid;
+        s->bi_valid += length;
+    }
+}
+#else /* !ZLIB_DEBUG */
+
+#define send_bits(s, value, length) \
+{ int len = length;\
+  uint64_t val = (uint64_t)(value);\
+  if (s->bi_valid + len >= (int)Buf_size) {\
+    s->bi_buf |= val << s->bi_valid;\
+    put_uint64(s, s->bi_buf);\
+    s->bi_buf = val >> (Buf_size - s->bi_valid);\
+    s->bi_valid += len - Buf_size;\
+  } else {\
+    s->bi_buf |= val << s->bi_valid;\
+    s->bi_valid += len;\
+  }\
+}
+#endif /* ZLIB_DEBUG */
+#else /* !AOCL_ZLIB_OPT */
 /* ===========================================================================
  * Send a value on a given number of bits.
  * IN assertion: length <= 16 and value fits in length bits.
@@ -243,6 +311,7 @@ local void send_bits(s, value, length)
   }\
 }
 #endif /* ZLIB_DEBUG */
+#endif /* AOCL_ZLIB_OPT */
 #endif /* AOCL_ZLIB_DEFLATE_FAST_MODE_3 */
 
 /* the arguments must not have side effects */
@@ -1215,7 +1284,66 @@ local void compress_block(s, ltree, dtree)
     unsigned lx = 0;    /* running index in l_buf */
     unsigned code;      /* the code to send */
     int extra;          /* number of extra bits to send */
+#ifdef AOCL_ZLIB_OPT
+    uint64_t bits;      /* codes gathered for a single send_bits() */
+    int nbits;          /* number of bits in bits */
+    int n;
+    uint32_t lcode[MAX_MATCH-MIN_MATCH+1]; /* length code + extra bits */
+    uch lcode_bits[MAX_MATCH-MIN_MATCH+1]; /* bit length of lcode[] */
+
+    /* Combine each match length's code with its extra bits once per block */
+    for (n = 0; n <= MAX_MATCH-MIN_MATCH; n++) {
+        code = _length_code[n];
+        extra = extra_lbits[code];
+        lcode[n] = ltree[code+LITERALS+1].Code;
+        if (extra != 0)
+            lcode[n] |= (uint32_t)(n - base_length[code]) <<
+                        ltree[code+LITERALS+1].Len;
+        lcode_bits[n] = (uch)(ltree[code+LITERALS+1].Len + extra);
+    }
+
+    /* Codes are gathered in a 64-bit value and sent with one send_bits():
+     * up to 4 literals (4*15 bits), or a whole match with its length code,
+     * distance code and their extra bits (15+5+15+13 bits).
+     */
+    if (s->last_lit != 0) do {
+        dist = s->d_buf[lx];
+        lc = s->l_buf[lx++];
+        if (dist == 0) {
+            bits = ltree[lc].Code;
+            nbits = ltree[lc].Len;
+            Tracecv(isgraph(lc), (stderr," '%c' ", lc));
+            for (n = 1; n < 4 && lx < s->last_lit && s->d_buf[lx] == 0; n++) {
+                lc = s->l_buf[lx++];
+                bits |= (uint64_t)ltree[lc].Code << nbits;
+                nbits += ltree[lc].Len;
+                Tracecv(isgraph(lc), (stderr," '%c' ", lc));
+            }
+        } else {
+            /* Here, lc is the match length - MIN_MATCH */
+            bits = lcode[lc];
+            nbits = lcode_bits[lc];
+            dist--; /* dist is now the match distance - 1 */
+            code = d_code(dist);
+            Assert (code < D_CODES, "bad d_code");
+
+            bits |= (uint64_t)dtree[code].Code << nbits;
+            nbits += dtree[code].Len;
+            extra = extra_dbits[code];
+            if (extra != 0) {
+                dist -= (unsigned)base_dist[code];
+                bits |= (uint64_t)dist << nbits; /* extra distance bits */
+                nbits += extra;
+            }
+        } /* literal or match pair ? */
+        send_bits(s, bits, nbits);
+
+        /* Check that the overlay between pending_buf and d_buf+l_buf is ok: */
+        Assert((uInt)(s->pending) < s->lit_bufsize + 2*lx,
+               "pendingBuf overflow");
 
+    } while (lx < s->last_lit);
+#else
     if (s->last_lit != 0) do {
         dist = s->d_buf[lx];
         lc = s->l_buf[lx++];
@@ -1248,6 +1376,7 @@ local void compress_block(s, ltree, dtree)
                "pendingBuf overflow");
 
     } while (lx < s->last_lit);
+#endif /* AOCL_ZLIB_OPT */
 
     send_code(s, END_BLOCK, ltree);
 }
@@ -1333,6 +1462,13 @@ local void bi_flush(s)
     deflate_state *s;
 #endif /* ENABLE_STRICT_WARNINGS */
 {
+#ifdef AOCL_ZLIB_OPT
+    while (s->bi_valid >= 8) {
+        put_byte(s, (Byte)s->bi_buf);
+        s->bi_buf >>= 8;
+        s->bi_valid -= 8;
+    }
+#else
     if (s->bi_valid == 16) {
         put_short(s, s->bi_buf);
         s->bi_buf = 0;
@@ -1342,6 +1478,7 @@ local void bi_flush(s)
         s->bi_buf >>= 8;
         s->bi_valid -= 8;
     }
+#endif /* AOCL_ZLIB_OPT */
 }
 
 /* ===========================================================================
@@ -1362,11 +1499,19 @@ void ZLIB_INTERNAL bi_windup(s)
     deflate_state *s;
 #endif /* ENABLE_STRICT_WARNINGS */
 {
+#ifdef AOCL_ZLIB_OPT
+    while (s->bi_valid > 0) {
+        put_byte(s, (Byte)s->bi_buf);
+        s->bi_buf >>= 8;
+        s->bi_valid -= 8;
+    }
+#else
     if (s->bi_valid > 8) {
         put_short(s, s->bi_buf);
     } else if (s->bi_valid > 0) {
         put_byte(s, (Byte)s->bi_buf);
     }
+#endif /* AOCL_ZLIB_OPT */
     s->bi_buf = 0;
     s->bi_valid = 0;
 #ifdef ZLIB_DEBUG
@@ -915,6 +915,34 @@ ZEXTERN int ZEXPORT deflateTune OF((z_streamp strm,
                                     int nice_length,
                                     int max_chain));
 
+/**
+  @brief AOCL-Compression defined function that makes the deflate output rsyncable.
+
+  A rolling hash is computed over the input, and at the content-defined
+  points where it matches, deflate() ends the current block with a sync
+  flush, as with gzip --rsyncable. The output after such a boundary depends
+  only on the input from there on and on the 32K window before it. A small
+  change to the input therefore changes the compressed data only locally,
+  and rsync or a deduplicating store can reuse the rest. Each boundary costs
+  a new block header plus the 4 or 5 bytes of the sync flush, which is not
+  included in deflateBound().
+
+  It can be called after deflateInit() or deflateInit2() or deflateReset(),
+  before the first call of deflate().
+
+  |Parameters|Direction|Description|
+  |:---------|:-------:|:----------|
+  | \b strm  | in,out  | It works as a handle for compression, refer @ref z_stream_s for more info.|
+  | \b bits  | in      | 0 to disable, otherwise the boundaries are on average 2^bits bytes apart, and at least 2^(bits-2). The valid range is 8 to 24; 12 gives the 4K spacing of gzip --rsyncable.|
+
+  @return
+  |Result          | Description  |
+  |:---------------|:-------------|
+  | Z_OK           | If success. |
+  | Z_STREAM_ERROR | For an invalid deflate stream or bits value. |
+*/
+ZEXTERN int ZEXPORT aocl_deflateRsyncable OF((z_streamp strm, int bits));
+
 /**
   @brief This function returns an upper bound on the compressed size after deflation of sourceLen bytes. 
 
@@ -1232,6 +1260,32 @@ ZEXTERN int ZEXPORT inflateReset OF((z_streamp strm));
 ZEXTERN int ZEXPORT inflateReset2 OF((z_streamp strm,
                                       int windowBits));
 
+/**
+  @brief This function switches a raw inflate stream to Deflate64, the
+  "enhanced deflate" method 9 of zip archives.
+
+  Deflate64 is deflate with a 64K window, distance codes 30 and 31 for
+  distances up to 65536, and length code 285 carrying 16 extra bits for
+  lengths of 3 to 65538.  inflate() decodes such streams with the same fast
+  path as deflate and allocates a 64K window for them.  inflateReset() keeps
+  the setting, while inflateReset2() returns the stream to plain deflate.
+
+  It must be called after inflateInit2() with a negative windowBits, or after
+  inflateReset(), before inflateSetDictionary() and the first call of
+  inflate().
+
+  |Parameters|Direction|Description|
+  |:---------|:-------:|:----------|
+  | \b strm  |  in,out |It works as a handle for decompression, refer @ref z_stream_s for more info.|
+
+  @return
+  |Result          | Description |
+  |:---------------|:------------|
+  | Z_OK           | If success  |
+  | Z_STREAM_ERROR | If the stream state is inconsistent, the stream is not raw, inflate() was already called, or the library was built without AOCL optimizations. |
+*/
+ZEXTERN int ZEXPORT aocl_inflateDeflate64 OF((z_streamp strm));
+
 /**
   @brief This function inserts bits in the inflate input stream.  
 
@@ -1620,6 +1674,57 @@ ZEXTERN int ZEXPORT compress2 OF((Bytef *dest,   uLongf *destLen,
 */
 ZEXTERN uLong ZEXPORT compressBound OF((uLong sourceLen));
 
+/**
+  @brief AOCL-Compression defined parallel compress2(). The source buffer is split
+  into blocks that are deflated concurrently on up to numThreads threads. Each
+  block is primed with the last 32K of the preceding input as a preset dictionary
+  and, except for the last one, ends with a sync flush, so the blocks concatenate
+  into a single zlib or gzip stream that any standard inflater can decode. The
+  per-block check values are merged with adler32_combine() or crc32_combine().
+
+  |Parameters|Direction|Description|
+  |:---------|:-------:|:----------|
+  | \b dest  | in,out |The compressed data is stored in this buffer.|
+  | \b destLen |in,out | Upon entry, destLen is the total size of the destination buffer, which must be at least the value returned by aocl_compressBound_mt(sourceLen, blockSize).  Upon exit, destLen is the actual size of the compressed data.|
+  | \b source |in | It is the buffer where the data we want to compress resides.|
+  | \b sourceLen| in |Length of source buffer to be compressed.|
+  | \b level | in |The compression level, with the same meaning as in compress2().|
+  | \b windowBits | in |MAX_WBITS for a zlib stream or MAX_WBITS + 16 for a gzip stream. Other values are not supported.|
+  | \b numThreads | in |Number of threads to use, including the calling thread. Values below 2 compress the blocks on the calling thread. If a thread cannot be created, the blocks are shared among the others.|
+  | \b blockSize | in |Uncompressed size of each block. 0 selects the default of 128K; other values are clamped to the range 128K to 1M.|
+
+
+  @return
+  |Result         | Description |
+  |:--------------|:------------|
+  |Z_OK           | If success. |
+  |Z_MEM_ERROR    | If there was not enough memory. |
+  |Z_BUF_ERROR    | If there was not enough room in the output buffer. |
+  |Z_STREAM_ERROR | If the level or windowBits parameter is invalid. |
+*/
+ZEXTERN int ZEXPORT aocl_compress2_mt OF((Bytef *dest,   uLongf *destLen,
+                                          const Bytef *source, uLong sourceLen,
+                                          int level, int windowBits,
+                                          int numThreads, uLong blockSize));
+
+/**
+  @brief It returns an upper bound on the compressed size after
+  aocl_compress2_mt() on sourceLen bytes with the given blockSize.
+
+  |Parameters    |Direction|Description|
+  |:-------------|:-------:|:----------|
+  | \b sourceLen |    in   | Length of source buffer to be compressed.|
+  | \b blockSize |    in   | Block size passed to aocl_compress2_mt().|
+
+
+  @return
+  |Result | Description |
+  |:------|:------------|
+  |Success| Returns an upper bound on the compressed size after aocl_compress2_mt() on sourceLen bytes, for both zlib and gzip output. |
+
+*/
+ZEXTERN uLong ZEXPORT aocl_compressBound_mt OF((uLong sourceLen, uLong blockSize));
+
 /**
   @brief This function decompresses the source buffer into the destination buffer.  
 
@@ -1760,7 +1865,8 @@ ZEXTERN gzFile ZEXPORT gzdopen OF((int fd, const char *mode));
 /**
   @brief Use this function to set the internal buffer size used by this library's functions.
 
-  The default buffer size is 8192 bytes.  This function must be called after
+  The default buffer size is 8192 bytes, or 128K bytes for files opened
+  in the AOCL "p" mode.  This function must be called after
   gzopen() or gzdopen(), and before any other calls that read or write the
   file.  The buffer memory allocation is always deferred to the first read or
   write.  Three times that size in buffer space is allocated.  A larger buffer
@@ -2918,6 +3024,7 @@ ZEXTERN int ZEXPORT gzgetc_ OF((gzFile file));  /* backward compatibility */
   |    ^     |   ^     | "+" will result in an error, since reading and writing to the same gzip file is not supported. |
   |    ^     |   ^     | The addition of "x" when writing will create the file exclusively, which fails if the file already exists. |
   |    ^     |   ^     | On systems that support it, the addition of "e" when reading or writing will set the flag to close the file on an execve() call. |
+  |    ^     |   ^     | With AOCL optimizations, the addition of "p" requests pipelined i/o.  When reading, the gzip data of a regular file is decompressed straight from a read-only mapping of the file (not on Windows), and the next buffer of the file is prefetched while the current one is decompressed.  The file must not be truncated while it is mapped.  When writing, each full output buffer is written by a background thread while the next one is compressed.  gzflush() and gzclose() still wait for all data to be written, but an error from a background write is only reported by the next call that compresses data, and gzoffset() does not count the buffer being written. |
 
     These functions, as well as gzip, will read and decode a sequence of gzip
   streams in a file.  The append function of gzopen() can be used to create
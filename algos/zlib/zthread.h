@@ -0,0 +1,104 @@
+/* zthread.h -- internal threads, mutexes and condition variables
+ * Copyright (C) 2023, Advanced Micro Devices. All rights reserved.
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+/* WARNING: this file should *not* be used by applications. It is
+   part of the implementation of the compression library and is
+   subject to change. Applications should only use zlib.h.
+ */
+
+/* Thin wrappers over Win32 and POSIX threads for the workers of
+   aocl_compress2_mt() and the background writer of gzip files opened in 'p'
+   mode.  On POSIX systems the library then links with pthread. */
+
+#ifndef ZTHREAD_H
+#define ZTHREAD_H
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#endif
+
+#if defined(_WIN32)
+typedef CRITICAL_SECTION z_mutex;
+typedef CONDITION_VARIABLE z_cond;
+#else
+typedef pthread_mutex_t z_mutex;
+typedef pthread_cond_t z_cond;
+#endif
+
+typedef struct {
+#if defined(_WIN32)
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+    void (*func)(void *);   /* run on the thread with arg */
+    void *arg;
+} z_thread;
+
+#if defined(_WIN32)
+static DWORD WINAPI z_thread_run(LPVOID t)
+{
+    ((z_thread *)t)->func(((z_thread *)t)->arg);
+    return 0;
+}
+
+/* Start func(arg) on a new thread, t must stay in place until it is joined.
+   Return 1 on success, 0 if the thread could not be created. */
+static inline int z_thread_create(z_thread *t, void (*func)(void *), void *arg)
+{
+    t->func = func;
+    t->arg = arg;
+    t->handle = CreateThread(NULL, 0, z_thread_run, t, 0, NULL);
+    return t->handle != NULL;
+}
+
+static inline void z_thread_join(z_thread *t)
+{
+    WaitForSingleObject(t->handle, INFINITE);
+    CloseHandle(t->handle);
+}
+
+static inline void z_mutex_init(z_mutex *m) { InitializeCriticalSection(m); }
+static inline void z_mutex_destroy(z_mutex *m) { DeleteCriticalSection(m); }
+static inline void z_mutex_lock(z_mutex *m) { EnterCriticalSection(m); }
+static inline void z_mutex_unlock(z_mutex *m) { LeaveCriticalSection(m); }
+static inline void z_cond_init(z_cond *c) { InitializeConditionVariable(c); }
+static inline void z_cond_destroy(z_cond *c) { (void)c; }
+static inline void z_cond_wait(z_cond *c, z_mutex *m) { SleepConditionVariableCS(c, m, INFINITE); }
+static inline void z_cond_broadcast(z_cond *c) { WakeAllConditionVariable(c); }
+#else
+static void *z_thread_run(void *t)
+{
+    ((z_thread *)t)->func(((z_thread *)t)->arg);
+    return NULL;
+}
+
+/* Start func(arg) on a new thread, t must stay in place until it is joined.
+   Return 1 on success, 0 if the thread could not be created. */
+static inline int z_thread_create(z_thread *t, void (*func)(void *), void *arg)
+{
+    t->func = func;
+    t->arg = arg;
+    return pthread_create(&t->handle, NULL, z_thread_run, t) == 0;
+}
+
+static inline void z_thread_join(z_thread *t)
+{
+    pthread_join(t->handle, NULL);
+}
+
+static inline void z_mutex_init(z_mutex *m) { pthread_mutex_init(m, NULL); }
+static inline void z_mutex_destroy(z_mutex *m) { pthread_mutex_destroy(m); }
+static inline void z_mutex_lock(z_mutex *m) { pthread_mutex_lock(m); }
+static inline void z_mutex_unlock(z_mutex *m) { pthread_mutex_unlock(m); }
+static inline void z_cond_init(z_cond *c) { pthread_cond_init(c, NULL); }
+static inline void z_cond_destroy(z_cond *c) { pthread_cond_destroy(c); }
+static inline void z_cond_wait(z_cond *c, z_mutex *m) { pthread_cond_wait(c, m); }
+static inline void z_cond_broadcast(z_cond *c) { pthread_cond_broadcast(c); }
+#endif
+
+#endif /* ZTHREAD_H */
@@ -17,8 +17,27 @@
 #include "../common/mem.h"             /* U32, BYTE, etc. */
 #include "../common/debug.h"           /* assert, DEBUGLOG */
 #include "../common/error_private.h"   /* ERROR */
+#include "../common/compiler.h"        /* TARGET_ATTRIBUTE */
+#include "../zstd.h"                   /* AOCL_ZSTD_OPT */
 #include "hist.h"
 
+#if defined(AOCL_ZSTD_OPT) && (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(_M_X64))
+#  define AOCL_HIST_AVX2_OPT
+#  include <immintrin.h>
+#endif
+
+#ifdef AOCL_HIST_AVX2_OPT
+#  ifdef AOCL_DYNAMIC_DISPATCHER
+static int aoclHistAvx2 = 0;  /* set by aocl_register_hist_fmv() */
+#    define HIST_USE_AVX2 aoclHistAvx2
+#  elif defined(__AVX2__)
+#    define HIST_USE_AVX2 1
+#  else
+#    define HIST_USE_AVX2 0
+#  endif
+#endif
+
 
 /* --- Error management --- */
 unsigned HIST_isError(size_t code) { return ERR_isError(code); }
@@ -55,6 +74,94 @@ unsigned HIST_count_simple(unsigned* count, unsigned* maxSymbolValuePtr,
 
 typedef enum { trustInput, checkMaxSymbolValue } HIST_checkInput_e;
 
+#ifdef AOCL_HIST_AVX2_OPT
+/* Largest input for which the 16-bit counters of
+ * HIST_count_parallel_wksp_avx2() cannot overflow. */
+#define HIST_AVX2_MAX_SRC_SIZE ((size_t)1 << 18)
+
+/* HIST_count_parallel_wksp_avx2() :
+ * AVX2 variant of HIST_count_parallel_wksp().
+ * Input is read 16 bytes at a time and spread over 8 interleaved tables of
+ * 16-bit counters, which still fit in HIST_WKSP_SIZE. Spreading each byte
+ * lane to its own table breaks the store-to-load dependency that limits the
+ * 4-table version on long runs and heavily skewed data.
+ * Tables are then merged and the largest count found with vector adds/max.
+ * `sourceSize` must be > 0 and <= HIST_AVX2_MAX_SRC_SIZE. */
+TARGET_ATTRIBUTE("avx2")
+static size_t HIST_count_parallel_wksp_avx2(
+                                unsigned* count, unsigned* maxSymbolValuePtr,
+                                const void* source, size_t sourceSize,
+                                HIST_checkInput_e check,
+                                U32* const workSpace)
+{
+    const BYTE* ip = (const BYTE*)source;
+    const BYTE* const iend = ip+sourceSize;
+    size_t const countSize = (*maxSymbolValuePtr + 1) * sizeof(*count);
+    U16* const Counting = (U16*)workSpace;   /* 8 tables of 256 U16 */
+    U32 total[256];
+    unsigned max;
+
+    assert(sourceSize > 0 && sourceSize <= HIST_AVX2_MAX_SRC_SIZE);
+    ZSTD_memset(Counting, 0, 8*256*sizeof(U16));
+
+    /* by stripes of 16 bytes */
+    while (ip + 16 <= iend) {
+        U64 const a = MEM_readLE64(ip);
+        U64 const b = MEM_readLE64(ip+8);
+        ip += 16;
+        Counting[0*256 + (BYTE) a     ]++;
+        Counting[1*256 + (BYTE)(a>>8) ]++;
+        Counting[2*256 + (BYTE)(a>>16)]++;
+        Counting[3*256 + (BYTE)(a>>24)]++;
+        Counting[4*256 + (BYTE)(a>>32)]++;
+        Counting[5*256 + (BYTE)(a>>40)]++;
+        Counting[6*256 + (BYTE)(a>>48)]++;
+        Counting[7*256 +        (a>>56)]++;
+        Counting[0*256 + (BYTE) b     ]++;
+        Counting[1*256 + (BYTE)(b>>8) ]++;
+        Counting[2*256 + (BYTE)(b>>16)]++;
+        Counting[3*256 + (BYTE)(b>>24)]++;
+        Counting[4*256 + (BYTE)(b>>32)]++;
+        Counting[5*256 + (BYTE)(b>>40)]++;
+        Counting[6*256 + (BYTE)(b>>48)]++;
+        Counting[7*256 +        (b>>56)]++;
+    }
+
+    /* finish last symbols */
+    while (ip<iend) Counting[*ip++]++;
+
+    /* merge 8 tables, widening to 32 bits */
+    {   __m256i vmax = _mm256_setzero_si256();
+        U32 s;
+        for (s=0; s<256; s+=8) {
+            __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(Counting + 0*256 + s)));
+            v = _mm256_add_epi32(v, _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(Counting + 1*256 + s))));
+            v = _mm256_add_epi32(v, _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(Counting + 2*256 + s))));
+            v = _mm256_add_epi32(v, _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(Counting + 3*256 + s))));
+            v = _mm256_add_epi32(v, _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(Counting + 4*256 + s))));
+            v = _mm256_add_epi32(v, _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(Counting + 5*256 + s))));
+            v = _mm256_add_epi32(v, _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(Counting + 6*256 + s))));
+            v = _mm256_add_epi32(v, _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(Counting + 7*256 + s))));
+            _mm256_storeu_si256((__m256i*)(total + s), v);
+            vmax = _mm256_max_epu32(vmax, v);
+        }
+        /* horizontal max */
+        {   __m128i m = _mm_max_epu32(_mm256_castsi256_si128(vmax), _mm256_extracti128_si256(vmax, 1));
+            m = _mm_max_epu32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+            m = _mm_max_epu32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+            max = (unsigned)_mm_cvtsi128_si32(m);
+    }   }
+
+    {   unsigned maxSymbolValue = 255;
+        while (!total[maxSymbolValue]) maxSymbolValue--;
+        if (check && maxSymbolValue > *maxSymbolValuePtr) return ERROR(maxSymbolValue_tooSmall);
+        *maxSymbolValuePtr = maxSymbolValue;
+        ZSTD_memcpy(count, total, countSize);
+    }
+    return (size_t)max;
+}
+#endif /* AOCL_HIST_AVX2_OPT */
+
 /* HIST_count_parallel_wksp() :
  * store histogram into 4 intermediate tables, recombined at the end.
  * this design makes better use of OoO cpus,
@@ -85,6 +192,10 @@ static size_t HIST_count_parallel_wksp(
         *maxSymbolValuePtr = 0;
         return 0;
     }
+#ifdef AOCL_HIST_AVX2_OPT
+    if (HIST_USE_AVX2 && sourceSize <= HIST_AVX2_MAX_SRC_SIZE)
+        return HIST_count_parallel_wksp_avx2(count, maxSymbolValuePtr, source, sourceSize, check, workSpace);
+#endif
     ZSTD_memset(workSpace, 0, 4*256*sizeof(unsigned));
 
     /* by stripes of 16 bytes */
@@ -163,6 +274,36 @@ size_t HIST_count_wksp(unsigned* count, unsigned* maxSymbolValuePtr,
     return HIST_countFast_wksp(count, maxSymbolValuePtr, source, sourceSize, workSpace, workSpaceSize);
 }
 
+#ifdef AOCL_DYNAMIC_DISPATCHER
+void aocl_register_hist_fmv(int optOff, int optLevel)
+{
+#ifdef AOCL_HIST_AVX2_OPT
+    if (optOff)
+    {
+        //Unoptimized C version
+        aoclHistAvx2 = 0;
+    }
+    else
+    {
+        switch (optLevel)
+        {
+        case 0://C version
+        case 1://SSE version
+        case 2://AVX version
+            aoclHistAvx2 = 0;
+            break;
+        case 3://AVX2 version
+        default://AVX512 and other versions
+            aoclHistAvx2 = 1;
+            break;
+        }
+    }
+#else
+    (void)optOff; (void)optLevel;
+#endif
+}
+#endif
+
 #ifndef ZSTD_NO_UNUSED_FUNCTIONS
 /* fast variant (unsafe : won't check if src contains values beyond count[] limit) */
 size_t HIST_countFast(unsigned* count, unsigned* maxSymbolValuePtr,
@@ -73,3 +73,11 @@ size_t HIST_countFast_wksp(unsigned* count, unsigned* maxSymbolValuePtr,
  */
 unsigned HIST_count_simple(unsigned* count, unsigned* maxSymbolValuePtr,
                            const void* src, size_t srcSize);
+
+#ifdef AOCL_DYNAMIC_DISPATCHER
+/*! aocl_register_hist_fmv() :
+ *  Selects the histogram variant used by HIST_count_wksp() and HIST_countFast_wksp().
+ *  optLevel >= 3 (AVX2 and above) enables the AVX2 counting path, unless optOff is set.
+ */
+void aocl_register_hist_fmv(int optOff, int optLevel);
+#endif
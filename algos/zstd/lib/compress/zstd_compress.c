@@ -853,11 +853,11 @@ size_t ZSTD_CCtxParams_setParameter(ZSTD_CCtx_params* CCtxParams,
 #endif
 
     case ZSTD_c_rsyncable :
-#ifndef ZSTD_MULTITHREAD
+#if !defined(ZSTD_MULTITHREAD) && !defined(AOCL_ZSTD_OPT)
         RETURN_ERROR_IF(value!=0, parameter_unsupported, "not compiled with multithreading");
         return 0;
 #else
-        FORWARD_IF_ERROR(ZSTD_cParam_clampBounds(ZSTD_c_overlapLog, &value), "");
+        FORWARD_IF_ERROR(ZSTD_cParam_clampBounds(ZSTD_c_rsyncable, &value), "");
         CCtxParams->rsyncable = value;
         return CCtxParams->rsyncable;
 #endif
@@ -1022,7 +1022,7 @@ size_t ZSTD_CCtxParams_getParameter(
         break;
 #endif
     case ZSTD_c_rsyncable :
-#ifndef ZSTD_MULTITHREAD
+#if !defined(ZSTD_MULTITHREAD) && !defined(AOCL_ZSTD_OPT)
         RETURN_ERROR(parameter_unsupported, "not compiled with multithreading");
 #else
         *value = CCtxParams->rsyncable;
@@ -5653,10 +5653,113 @@ static size_t ZSTD_CCtx_init_compressStream2(ZSTD_CCtx* cctx,
         cctx->outBuffContentSize = cctx->outBuffFlushedSize = 0;
         cctx->streamStage = zcss_load;
         cctx->frameEnded = 0;
+#ifdef AOCL_ZSTD_OPT
+        RETURN_ERROR_IF(params.rsyncable && cctx->appliedParams.inBufferMode == ZSTD_bm_stable,
+                        parameter_unsupported,
+                        "rsyncable mode requires a buffered input without workers");
+        ZSTD_memset(&cctx->rsync, 0, sizeof(cctx->rsync));
+        cctx->rsync.hash = ZSTD_rollingHash_compute(cctx->rsync.window, ZSTD_RSYNC_LENGTH);
+        cctx->rsync.hitMask = ((U64)1 << ZSTD_RSYNC_LOG) - 1;
+        cctx->rsync.primePower = ZSTD_rollingHash_primePower(ZSTD_RSYNC_LENGTH);
+#endif
     }
     return 0;
 }
 
+#ifdef AOCL_ZSTD_OPT
+/* ZSTD_rsyncConsume() :
+ * Slide the window of the rolling hash over the nbBytes consumed at ip. */
+static void ZSTD_rsyncConsume(ZSTD_rsyncState_t* rs, const BYTE* ip, size_t nbBytes)
+{
+    if (nbBytes >= ZSTD_RSYNC_LENGTH) {
+        ZSTD_memcpy(rs->window, ip + nbBytes - ZSTD_RSYNC_LENGTH, ZSTD_RSYNC_LENGTH);
+    } else {
+        ZSTD_memmove(rs->window, rs->window + nbBytes, ZSTD_RSYNC_LENGTH - nbBytes);
+        ZSTD_memcpy(rs->window + ZSTD_RSYNC_LENGTH - nbBytes, ip, nbBytes);
+    }
+}
+
+/* ZSTD_compressStream_rsyncable() :
+ * Single-threaded rsyncable mode. The input is scanned with the rolling hash
+ * of the last ZSTD_RSYNC_LENGTH bytes, as zstdmt does. Where its low
+ * ZSTD_RSYNC_LOG bits are all set, and at least a quarter of the average
+ * distance has passed since the previous sync point, the input is cut : the
+ * bytes up to the cut are flushed, and the next
+ * block starts with fresh entropy statistics. Sync points thus depend on the
+ * content only, and a local change of the input only changes the compressed
+ * output up to the next one.
+ * Bytes scanned but not yet consumed are remembered in rsync.ahead, so the
+ * caller must present the unconsumed input again on the next call. The bytes
+ * before input->pos are kept in rsync.window, as the caller may move them.
+ * @return : same as ZSTD_compressStream2() */
+static size_t ZSTD_compressStream_rsyncable(ZSTD_CCtx* cctx,
+                                            ZSTD_outBuffer* output,
+                                            ZSTD_inBuffer* input,
+                                            ZSTD_EndDirective endOp)
+{
+    ZSTD_rsyncState_t* const rs = &cctx->rsync;
+    size_t const minLen = (size_t)1 << (ZSTD_RSYNC_LOG - 2);
+    for (;;) {
+        size_t const ipos = input->pos;
+        size_t remaining;
+        if (!rs->flushing) {
+            const BYTE* const ip = (const BYTE*)input->src + ipos;
+            size_t const avail = input->size - ipos;
+            U64 const primePower = rs->primePower;
+            U64 const hitMask = rs->hitMask;
+            U64 hash = rs->hash;
+            size_t len = rs->len;
+            size_t n = rs->ahead;
+            while (n < avail) {
+                BYTE const toRemove = n < ZSTD_RSYNC_LENGTH ? rs->window[n] : ip[n - ZSTD_RSYNC_LENGTH];
+                hash = ZSTD_rollingHash_rotate(hash, toRemove, ip[n], primePower);
+                n++;
+                len++;
+                if ((hash & hitMask) == hitMask && len >= minLen) {
+                    rs->flushing = 1;
+                    break;
+                }
+            }
+            rs->hash = hash;
+            rs->ahead = n;
+            if (!rs->flushing) {
+                /* no sync point in the available input */
+                rs->len = len;
+                FORWARD_IF_ERROR( ZSTD_compressStream_generic(cctx, output, input, endOp) , "");
+                ZSTD_rsyncConsume(rs, ip, input->pos - ipos);
+                rs->ahead -= input->pos - ipos;
+                return cctx->outBuffContentSize - cctx->outBuffFlushedSize;
+            }
+            rs->len = 0;
+            rs->cut = n;
+        }
+        /* hide the input after the sync point, and flush up to it */
+        {   ZSTD_inBuffer section = { input->src, ipos + rs->cut, ipos };
+            FORWARD_IF_ERROR( ZSTD_compressStream_generic(cctx, output, &section, ZSTD_e_flush) , "");
+            ZSTD_rsyncConsume(rs, (const BYTE*)input->src + ipos, section.pos - ipos);
+            input->pos = section.pos;
+            rs->cut -= section.pos - ipos;
+            rs->ahead -= section.pos - ipos;
+        }
+        remaining = cctx->outBuffContentSize - cctx->outBuffFlushedSize;
+        if (rs->cut != 0 || remaining != 0)
+            return remaining ? remaining : 1;   /* output buffer full */
+        rs->flushing = 0;
+        /* The decoder keeps its repcodes across blocks, so only the entropy
+         * statistics can be dropped; stale repcodes are replaced after a few
+         * sequences anyway. */
+        {   ZSTD_entropyCTables_t* const entropy = &cctx->blockState.prevCBlock->entropy;
+            entropy->huf.repeatMode = HUF_repeat_none;
+            entropy->fse.offcode_repeatMode = FSE_repeat_none;
+            entropy->fse.matchlength_repeatMode = FSE_repeat_none;
+            entropy->fse.litlength_repeatMode = FSE_repeat_none;
+        }
+        if (input->pos == input->size && endOp != ZSTD_e_end)
+            return 0;
+    }
+}
+#endif
+
 size_t ZSTD_compressStream2( ZSTD_CCtx* cctx,
                              ZSTD_outBuffer* output,
                              ZSTD_inBuffer* input,
@@ -5723,6 +5826,14 @@ size_t ZSTD_compressStream2( ZSTD_CCtx* cctx,
         ZSTD_setBufferExpectations(cctx, output, input);
         return flushMin;
     }
+#endif
+#ifdef AOCL_ZSTD_OPT
+    if (cctx->appliedParams.rsyncable) {
+        size_t const remaining = ZSTD_compressStream_rsyncable(cctx, output, input, endOp);
+        FORWARD_IF_ERROR(remaining, "ZSTD_compressStream_rsyncable failed");
+        ZSTD_setBufferExpectations(cctx, output, input);
+        return remaining;
+    }
 #endif
     FORWARD_IF_ERROR( ZSTD_compressStream_generic(cctx, output, input, endOp) , "");
     DEBUGLOG(5, "completed ZSTD_compressStream2");
@@ -5755,6 +5866,11 @@ size_t ZSTD_compress2(ZSTD_CCtx* cctx,
     ZSTD_CCtx_reset(cctx, ZSTD_reset_session_only);
     /* Enable stable input/output buffers. */
     cctx->requestedParams.inBufferMode = ZSTD_bm_stable;
+#ifdef AOCL_ZSTD_OPT
+    /* rsyncable mode cuts the input at sync points, which needs buffering */
+    if (cctx->requestedParams.rsyncable)
+        cctx->requestedParams.inBufferMode = ZSTD_bm_buffered;
+#endif
     cctx->requestedParams.outBufferMode = ZSTD_bm_stable;
     {   size_t oPos = 0;
         size_t iPos = 0;
@@ -6481,6 +6597,7 @@ static void aocl_register_zstd_compress_fmv(int optOff, int optLevel)
             break;
         }
     }
+    aocl_register_hist_fmv(optOff, optLevel);
 }
 /* AOCL-Compression setup API for invoking Dynamic dispatcher for compression
 * */
@@ -343,6 +343,24 @@ typedef enum {
     ZSTDb_buffered
 } ZSTD_buffered_policy_e;
 
+#ifdef AOCL_ZSTD_OPT
+/* State of the single-threaded rsyncable mode : the rolling hash of the last
+ * ZSTD_RSYNC_LENGTH input bytes selects sync points, as in zstdmt, where the
+ * stream is flushed and the entropy statistics are reset. */
+#define ZSTD_RSYNC_LOG 20   /* average distance between sync points */
+#define ZSTD_RSYNC_LENGTH 32
+typedef struct {
+    U64 hash;
+    U64 hitMask;
+    U64 primePower;
+    BYTE window[ZSTD_RSYNC_LENGTH];   /* input preceding input->pos, zeros at frame start */
+    size_t len;       /* bytes scanned since the last sync point */
+    size_t ahead;     /* bytes at input->pos already scanned */
+    size_t cut;       /* bytes at input->pos up to the pending sync point */
+    int flushing;     /* a sync point was found and is being flushed */
+} ZSTD_rsyncState_t;
+#endif
+
 struct ZSTD_CCtx_s {
     ZSTD_compressionStage_e stage;
     int cParamsChanged;                  /* == 1 if cParams(except wlog) or compression level are changed in requestedParams. Triggers transmission of new params to ZSTDMT (if available) then reset to 0. */
@@ -404,6 +422,11 @@ struct ZSTD_CCtx_s {
     ZSTDMT_CCtx* mtctx;
 #endif
 
+#ifdef AOCL_ZSTD_OPT
+    /* Single-threaded rsyncable mode */
+    ZSTD_rsyncState_t rsync;
+#endif
+
     /* Tracing */
 #if ZSTD_TRACE
     ZSTD_TraceCtx traceCtx;
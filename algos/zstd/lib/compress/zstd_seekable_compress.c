@@ -0,0 +1,406 @@
+/**
+ * Copyright (C) 2023, Advanced Micro Devices. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*-*************************************
+*  Dependencies
+***************************************/
+#include "../common/zstd_deps.h"   /* ZSTD_memcpy */
+#include "../common/mem.h"         /* MEM_writeLE32 */
+#define ZSTD_STATIC_LINKING_ONLY
+#include "../zstd.h"
+#include "../common/zstd_internal.h"  /* XXH64, ZSTD_customMalloc, RETURN_ERROR_IF */
+#include "../zstd_seekable.h"
+
+
+/*-*************************************
+*  Seek table log
+***************************************/
+typedef struct {
+    U32 cSize;
+    U32 dSize;
+    U32 checksum;
+} ZSTD_seekable_frameLogEntry;
+
+typedef struct {
+    ZSTD_seekable_frameLogEntry* entries;
+    U32 size;
+    U32 capacity;
+    int checksumFlag;
+
+    /* progress of ZSTD_seekable_writeSeekTable(), the output may be too
+     * small to hold the whole seek table in a single call */
+    U32 seekTablePos;
+    U32 seekTableIndex;
+} ZSTD_seekable_frameLog;
+
+struct ZSTD_seekable_CStream_s {
+    ZSTD_CStream* cstream;
+    ZSTD_seekable_frameLog framelog;
+
+    U32 frameCSize;
+    U32 frameDSize;
+
+    XXH64_state_t xxhState;
+
+    U32 maxFrameSize;
+
+    int writingSeekTable;
+};
+
+static size_t ZSTD_seekable_frameLog_init(ZSTD_seekable_frameLog* fl)
+{
+    /* start small, the log is grown geometrically as frames are added */
+    fl->capacity = 16;
+    fl->entries = (ZSTD_seekable_frameLogEntry*)ZSTD_customMalloc(
+            sizeof(ZSTD_seekable_frameLogEntry) * fl->capacity, ZSTD_defaultCMem);
+    RETURN_ERROR_IF(fl->entries == NULL, memory_allocation, "");
+    fl->size = 0;
+    fl->checksumFlag = 0;
+    fl->seekTablePos = 0;
+    fl->seekTableIndex = 0;
+    return 0;
+}
+
+static void ZSTD_seekable_frameLog_free(ZSTD_seekable_frameLog* fl)
+{
+    ZSTD_customFree(fl->entries, ZSTD_defaultCMem);
+    fl->entries = NULL;
+}
+
+static size_t ZSTD_seekable_logFrame(ZSTD_seekable_frameLog* fl,
+                                     U32 cSize, U32 dSize, U32 checksum)
+{
+    RETURN_ERROR_IF(fl->size == ZSTD_SEEKABLE_MAXFRAMES, frameIndex_tooLarge, "");
+
+    if (fl->size == fl->capacity) {
+        U32 const newCapacity = fl->capacity * 2;
+        ZSTD_seekable_frameLogEntry* const newEntries =
+            (ZSTD_seekable_frameLogEntry*)ZSTD_customMalloc(
+                sizeof(ZSTD_seekable_frameLogEntry) * newCapacity, ZSTD_defaultCMem);
+        RETURN_ERROR_IF(newEntries == NULL, memory_allocation, "");
+        ZSTD_memcpy(newEntries, fl->entries,
+                    sizeof(ZSTD_seekable_frameLogEntry) * fl->size);
+        ZSTD_customFree(fl->entries, ZSTD_defaultCMem);
+        fl->entries = newEntries;
+        fl->capacity = newCapacity;
+    }
+
+    fl->entries[fl->size].cSize = cSize;
+    fl->entries[fl->size].dSize = dSize;
+    fl->entries[fl->size].checksum = checksum;
+    fl->size++;
+    return 0;
+}
+
+static size_t ZSTD_seekable_seekTableSize(const ZSTD_seekable_frameLog* fl)
+{
+    size_t const sizePerFrame = 8 + (fl->checksumFlag ? 4 : 0);
+    return ZSTD_SKIPPABLEHEADERSIZE + sizePerFrame * fl->size + ZSTD_seekTableFooterSize;
+}
+
+/* Writes the part of `value` that falls into the output window.
+ * `offset` is the logical position of `value` in the seek table. */
+static size_t ZSTD_seekable_stwrite32(ZSTD_seekable_frameLog* fl,
+                                      ZSTD_outBuffer* output, U32 value, U32 offset)
+{
+    if (fl->seekTablePos < offset + 4) {
+        BYTE tmp[4];
+        size_t const lenWrite = MIN(output->size - output->pos,
+                                    offset + 4 - fl->seekTablePos);
+        MEM_writeLE32(tmp, value);
+        ZSTD_memcpy((BYTE*)output->dst + output->pos,
+                    tmp + (fl->seekTablePos - offset), lenWrite);
+        output->pos += lenWrite;
+        fl->seekTablePos += (U32)lenWrite;
+
+        if (lenWrite < 4) return ZSTD_seekable_seekTableSize(fl) - fl->seekTablePos;
+    }
+    return 0;
+}
+
+/* Serializes the seek table as a skippable frame. Resumable: returns the
+ * number of bytes still to write when `output` is full, 0 when done. */
+static size_t ZSTD_seekable_writeSeekTable(ZSTD_seekable_frameLog* fl, ZSTD_outBuffer* output)
+{
+    size_t const sizePerFrame = 8 + (fl->checksumFlag ? 4 : 0);
+    size_t const seekTableLen = ZSTD_seekable_seekTableSize(fl);
+
+    FORWARD_IF_ERROR(ZSTD_seekable_stwrite32(fl, output, ZSTD_MAGIC_SKIPPABLE_START | 0xE, 0), "");
+    if (fl->seekTablePos < 4) return seekTableLen - fl->seekTablePos;
+    FORWARD_IF_ERROR(ZSTD_seekable_stwrite32(fl, output, (U32)(seekTableLen - ZSTD_SKIPPABLEHEADERSIZE), 4), "");
+    if (fl->seekTablePos < 8) return seekTableLen - fl->seekTablePos;
+
+    while (fl->seekTableIndex < fl->size) {
+        U32 const start = (U32)(ZSTD_SKIPPABLEHEADERSIZE + sizePerFrame * fl->seekTableIndex);
+        size_t ret;
+        assert(start + 8 <= seekTableLen);
+        ret = ZSTD_seekable_stwrite32(fl, output, fl->entries[fl->seekTableIndex].cSize, start);
+        if (ret) return ret;
+        ret = ZSTD_seekable_stwrite32(fl, output, fl->entries[fl->seekTableIndex].dSize, start + 4);
+        if (ret) return ret;
+        if (fl->checksumFlag) {
+            ret = ZSTD_seekable_stwrite32(fl, output,
+                    fl->entries[fl->seekTableIndex].checksum, start + 8);
+            if (ret) return ret;
+        }
+        fl->seekTableIndex++;
+    }
+
+    FORWARD_IF_ERROR(ZSTD_seekable_stwrite32(fl, output, fl->size,
+                        (U32)(seekTableLen - ZSTD_seekTableFooterSize)), "");
+    if (fl->seekTablePos < seekTableLen - 5) return seekTableLen - fl->seekTablePos;
+
+    if (output->size - output->pos < 1) return seekTableLen - fl->seekTablePos;
+    if (fl->seekTablePos < seekTableLen - 4) {
+        /* descriptor byte: bit 7 is the checksum flag, bits 0-6 are reserved */
+        BYTE const sfd = (BYTE)((fl->checksumFlag ? 1 : 0) << 7);
+        ((BYTE*)output->dst)[output->pos] = sfd;
+        output->pos++;
+        fl->seekTablePos++;
+    }
+
+    FORWARD_IF_ERROR(ZSTD_seekable_stwrite32(fl, output, ZSTD_SEEKABLE_MAGICNUMBER,
+                        (U32)(seekTableLen - 4)), "");
+    if (fl->seekTablePos != seekTableLen) return seekTableLen - fl->seekTablePos;
+    return 0;
+}
+
+
+/*-*************************************
+*  Streaming compression
+***************************************/
+ZSTD_seekable_CStream* ZSTD_seekable_createCStream(void)
+{
+    ZSTD_seekable_CStream* const zcs = (ZSTD_seekable_CStream*)ZSTD_customCalloc(
+            sizeof(ZSTD_seekable_CStream), ZSTD_defaultCMem);
+    if (zcs == NULL) return NULL;
+
+    zcs->cstream = ZSTD_createCStream();
+    if (zcs->cstream == NULL) goto failed1;
+
+    if (ZSTD_isError(ZSTD_seekable_frameLog_init(&zcs->framelog))) goto failed2;
+
+    return zcs;
+
+failed2:
+    ZSTD_freeCStream(zcs->cstream);
+failed1:
+    ZSTD_customFree(zcs, ZSTD_defaultCMem);
+    return NULL;
+}
+
+size_t ZSTD_seekable_freeCStream(ZSTD_seekable_CStream* zcs)
+{
+    if (zcs == NULL) return 0;
+    ZSTD_freeCStream(zcs->cstream);
+    ZSTD_seekable_frameLog_free(&zcs->framelog);
+    ZSTD_customFree(zcs, ZSTD_defaultCMem);
+    return 0;
+}
+
+size_t ZSTD_seekable_initCStream(ZSTD_seekable_CStream* zcs, int compressionLevel,
+                                 int checksumFlag, unsigned maxFrameSize)
+{
+    RETURN_ERROR_IF(zcs == NULL, GENERIC, "");
+    RETURN_ERROR_IF(maxFrameSize > ZSTD_SEEKABLE_MAX_FRAME_DECOMPRESSED_SIZE,
+                    frameParameter_unsupported, "");
+
+    zcs->framelog.size = 0;
+    zcs->framelog.checksumFlag = checksumFlag;
+    zcs->framelog.seekTablePos = 0;
+    zcs->framelog.seekTableIndex = 0;
+
+    zcs->frameCSize = 0;
+    zcs->frameDSize = 0;
+    zcs->maxFrameSize = maxFrameSize ? maxFrameSize
+                                     : ZSTD_SEEKABLE_MAX_FRAME_DECOMPRESSED_SIZE;
+    zcs->writingSeekTable = 0;
+
+    if (checksumFlag) XXH64_reset(&zcs->xxhState, 0);
+
+    FORWARD_IF_ERROR(ZSTD_CCtx_reset(zcs->cstream, ZSTD_reset_session_and_parameters), "");
+    FORWARD_IF_ERROR(ZSTD_CCtx_setParameter(zcs->cstream, ZSTD_c_compressionLevel,
+                                            compressionLevel), "");
+    return ZSTD_CStreamInSize();
+}
+
+size_t ZSTD_seekable_endFrame(ZSTD_seekable_CStream* zcs, ZSTD_outBuffer* output)
+{
+    size_t const prevOutPos = output->pos;
+    ZSTD_inBuffer noInput = { NULL, 0, 0 };
+    size_t const ret = ZSTD_compressStream2(zcs->cstream, output, &noInput, ZSTD_e_end);
+    FORWARD_IF_ERROR(ret, "");
+
+    zcs->frameCSize += (U32)(output->pos - prevOutPos);
+    if (ret) return ret;   /* frame not fully flushed yet */
+
+    FORWARD_IF_ERROR(ZSTD_seekable_logFrame(&zcs->framelog, zcs->frameCSize, zcs->frameDSize,
+            zcs->framelog.checksumFlag ? (U32)XXH64_digest(&zcs->xxhState) : 0), "");
+
+    zcs->frameCSize = 0;
+    zcs->frameDSize = 0;
+    if (zcs->framelog.checksumFlag) XXH64_reset(&zcs->xxhState, 0);
+
+    /* parameters are sticky, only the session needs a reset */
+    ZSTD_CCtx_reset(zcs->cstream, ZSTD_reset_session_only);
+    return 0;
+}
+
+size_t ZSTD_seekable_compressStream(ZSTD_seekable_CStream* zcs, ZSTD_outBuffer* output,
+                                    ZSTD_inBuffer* input)
+{
+    const BYTE* const inBase = (const BYTE*)input->src + input->pos;
+    size_t prevOutPos;
+    size_t inLen;
+    ZSTD_inBuffer inTmp;
+    size_t ret;
+
+    /* a full frame whose epilogue did not fit in `output` last time */
+    if (zcs->frameDSize == zcs->maxFrameSize) {
+        ret = ZSTD_seekable_endFrame(zcs, output);
+        FORWARD_IF_ERROR(ret, "");
+        if (ret) return ret;
+    }
+
+    prevOutPos = output->pos;
+    inLen = MIN(input->size - input->pos, (size_t)(zcs->maxFrameSize - zcs->frameDSize));
+
+    inTmp.src = inBase;
+    inTmp.size = inLen;
+    inTmp.pos = 0;
+
+    ret = ZSTD_compressStream2(zcs->cstream, output, &inTmp, ZSTD_e_continue);
+    FORWARD_IF_ERROR(ret, "");
+
+    if (zcs->framelog.checksumFlag)
+        XXH64_update(&zcs->xxhState, inBase, inTmp.pos);
+
+    zcs->frameCSize += (U32)(output->pos - prevOutPos);
+    zcs->frameDSize += (U32)inTmp.pos;
+    input->pos += inTmp.pos;
+
+    if (zcs->frameDSize == zcs->maxFrameSize) {
+        ret = ZSTD_seekable_endFrame(zcs, output);
+        FORWARD_IF_ERROR(ret, "");
+        if (ret) return ret;
+        return ZSTD_CStreamInSize();
+    }
+
+    return ret ? ret : ZSTD_CStreamInSize();
+}
+
+size_t ZSTD_seekable_endStream(ZSTD_seekable_CStream* zcs, ZSTD_outBuffer* output)
+{
+    if (!zcs->writingSeekTable && zcs->frameDSize) {
+        size_t const endFrame = ZSTD_seekable_endFrame(zcs, output);
+        FORWARD_IF_ERROR(endFrame, "");
+        /* return an accurate size hint */
+        if (endFrame) return endFrame + ZSTD_seekable_seekTableSize(&zcs->framelog);
+    }
+
+    zcs->writingSeekTable = 1;
+    return ZSTD_seekable_writeSeekTable(&zcs->framelog, output);
+}
+
+
+/*-*************************************
+*  Single pass compression
+***************************************/
+size_t ZSTD_seekable_compressBound(size_t srcSize, unsigned maxFrameSize, int checksumFlag)
+{
+    size_t const frameSize = maxFrameSize ? maxFrameSize
+                                          : ZSTD_SEEKABLE_MAX_FRAME_DECOMPRESSED_SIZE;
+    size_t const nbFullFrames = srcSize / frameSize;
+    size_t const lastFrameSize = srcSize % frameSize;
+    size_t const nbFrames = nbFullFrames + (lastFrameSize != 0);
+    return nbFullFrames * ZSTD_compressBound(frameSize)
+         + (lastFrameSize ? ZSTD_compressBound(lastFrameSize) : 0)
+         + ZSTD_SKIPPABLEHEADERSIZE
+         + nbFrames * (8 + (checksumFlag ? 4 : 0))
+         + ZSTD_seekTableFooterSize;
+}
+
+size_t ZSTD_seekable_compress(void* dst, size_t dstCapacity,
+                              const void* src, size_t srcSize,
+                              int compressionLevel, unsigned maxFrameSize,
+                              int checksumFlag)
+{
+    ZSTD_seekable_frameLog fl;
+    ZSTD_CCtx* cctx;
+    const BYTE* ip = (const BYTE*)src;
+    size_t remaining = srcSize;
+    ZSTD_outBuffer output;
+    size_t ret = 0;
+
+    RETURN_ERROR_IF(dst == NULL || (src == NULL && srcSize), GENERIC, "");
+    RETURN_ERROR_IF(maxFrameSize > ZSTD_SEEKABLE_MAX_FRAME_DECOMPRESSED_SIZE,
+                    frameParameter_unsupported, "");
+    if (maxFrameSize == 0) maxFrameSize = ZSTD_SEEKABLE_MAX_FRAME_DECOMPRESSED_SIZE;
+
+    cctx = ZSTD_createCCtx();
+    RETURN_ERROR_IF(cctx == NULL, memory_allocation, "");
+    ret = ZSTD_seekable_frameLog_init(&fl);
+    if (ZSTD_isError(ret)) {
+        ZSTD_freeCCtx(cctx);
+        return ret;
+    }
+    fl.checksumFlag = checksumFlag;
+
+    /* Every frame is compressed directly into `dst` through the same context,
+     * whose workspace and tables are reused across frames. */
+    ret = ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, compressionLevel);
+
+    output.dst = dst;
+    output.size = dstCapacity;
+    output.pos = 0;
+
+    while (!ZSTD_isError(ret) && remaining) {
+        size_t const frameSize = MIN(remaining, (size_t)maxFrameSize);
+        size_t const cSize = ZSTD_compress2(cctx, (BYTE*)dst + output.pos,
+                                            dstCapacity - output.pos, ip, frameSize);
+        if (ZSTD_isError(cSize)) {
+            ret = cSize;
+            break;
+        }
+        ret = ZSTD_seekable_logFrame(&fl, (U32)cSize, (U32)frameSize,
+                    checksumFlag ? (U32)XXH64(ip, frameSize, 0) : 0);
+        output.pos += cSize;
+        ip += frameSize;
+        remaining -= frameSize;
+    }
+
+    if (!ZSTD_isError(ret)) {
+        ret = ZSTD_seekable_writeSeekTable(&fl, &output);
+        if (!ZSTD_isError(ret))
+            ret = ret ? ERROR(dstSize_tooSmall) : output.pos;
+    }
+
+    ZSTD_seekable_frameLog_free(&fl);
+    ZSTD_freeCCtx(cctx);
+    return ret;
+}
@@ -0,0 +1,496 @@
+/**
+ * Copyright (C) 2023, Advanced Micro Devices. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* *********************************************************
+*  Turn on Large Files support (>4GB) for 32-bit Linux/Unix
+***********************************************************/
+#if !defined(__64BIT__) || defined(__MINGW32__)       /* No point defining Large file for 64 bit but MinGW-w64 requires it */
+#  if !defined(_FILE_OFFSET_BITS)
+#    define _FILE_OFFSET_BITS 64                      /* turn off_t into a 64-bit type for ftello, fseeko */
+#  endif
+#  if !defined(_LARGEFILE_SOURCE)                     /* obsolete macro, replaced with _FILE_OFFSET_BITS */
+#    define _LARGEFILE_SOURCE 1                       /* Large File Support extension (LFS) - fseeko, ftello */
+#  endif
+#  if defined(_AIX) || defined(__hpux)
+#    define _LARGE_FILES                              /* Large file support on 32-bits AIX and HP-UX */
+#  endif
+#endif
+
+/*-*************************************
+*  Dependencies
+***************************************/
+#include <stdio.h>                 /* FILE, fread, fseek */
+#include "../common/zstd_deps.h"   /* ZSTD_memcpy, ZSTD_memmove */
+#include "../common/mem.h"         /* MEM_readLE32 */
+#define ZSTD_STATIC_LINKING_ONLY
+#include "../zstd.h"
+#include "../common/zstd_internal.h"  /* XXH64, ZSTD_customMalloc, RETURN_ERROR_IF */
+#include "../zstd_seekable.h"
+
+/* ************************************************************
+* Avoid fseek()'s 2GiB barrier with MSVC, macOS, *BSD, MinGW
+***************************************************************/
+#if defined(_MSC_VER) && _MSC_VER >= 1400
+#   define LONG_SEEK _fseeki64
+#elif !defined(__64BIT__) && (PLATFORM_POSIX_VERSION >= 200112L) /* No point defining Large file for 64 bit */
+#  define LONG_SEEK fseeko
+#elif defined(__MINGW32__) && !defined(__STRICT_ANSI__) && !defined(__NO_MINGW_LFS) && defined(__MSVCRT__)
+#   define LONG_SEEK fseeko64
+#elif defined(_WIN32) && !defined(__DJGPP__)
+#   include <windows.h>
+    static int LONG_SEEK(FILE* file, __int64 offset, int origin) {
+        LARGE_INTEGER off;
+        DWORD method;
+        off.QuadPart = offset;
+        if (origin == SEEK_END)
+            method = FILE_END;
+        else if (origin == SEEK_CUR)
+            method = FILE_CURRENT;
+        else
+            method = FILE_BEGIN;
+
+        if (SetFilePointerEx((HANDLE) _get_osfhandle(_fileno(file)), off, NULL, method))
+            return 0;
+        else
+            return -1;
+    }
+#else
+#   define LONG_SEEK fseek
+#endif
+
+/* Size of the staging buffer for compressed input, and of the scratch output
+ * used to discard data preceding the requested offset inside a frame. */
+#define SEEKABLE_BUFF_SIZE ZSTD_BLOCKSIZE_MAX
+
+
+/*-*************************************
+*  Sources
+***************************************/
+static int ZSTD_seekable_read_FILE(void* opaque, void* buffer, size_t n)
+{
+    size_t const result = fread(buffer, 1, n, (FILE*)opaque);
+    if (result != n) {
+        return -1;
+    }
+    return 0;
+}
+
+static int ZSTD_seekable_seek_FILE(void* opaque, long long offset, int origin)
+{
+    int const ret = LONG_SEEK((FILE*)opaque, offset, origin);
+    if (ret) return ret;
+    return fflush((FILE*)opaque);
+}
+
+typedef struct {
+    const void* ptr;
+    size_t size;
+    size_t pos;
+} ZSTD_seekable_buffWrapper;
+
+static int ZSTD_seekable_read_buff(void* opaque, void* buffer, size_t n)
+{
+    ZSTD_seekable_buffWrapper* const buff = (ZSTD_seekable_buffWrapper*)opaque;
+    assert(buff != NULL);
+    if (buff->pos + n > buff->size) return -1;
+    ZSTD_memcpy(buffer, (const BYTE*)buff->ptr + buff->pos, n);
+    buff->pos += n;
+    return 0;
+}
+
+static int ZSTD_seekable_seek_buff(void* opaque, long long offset, int origin)
+{
+    ZSTD_seekable_buffWrapper* const buff = (ZSTD_seekable_buffWrapper*)opaque;
+    unsigned long long newOffset;
+    assert(buff != NULL);
+    switch (origin) {
+    case SEEK_SET:
+        assert(offset >= 0);
+        newOffset = (unsigned long long)offset;
+        break;
+    case SEEK_CUR:
+        newOffset = (unsigned long long)((long long)buff->pos + offset);
+        break;
+    case SEEK_END:
+        newOffset = (unsigned long long)((long long)buff->size + offset);
+        break;
+    default:
+        assert(0);  /* not possible */
+        return -1;
+    }
+    if (newOffset > buff->size) {
+        return -1;
+    }
+    buff->pos = (size_t)newOffset;
+    return 0;
+}
+
+
+/*-*************************************
+*  Seekable decompression object
+***************************************/
+typedef struct {
+    U64 cOffset;
+    U64 dOffset;
+    U32 checksum;
+} ZSTD_seekable_seekEntry;
+
+/* In-memory index of the archive: `entries` holds `tableLen + 1` items, the
+ * last one being a sentinel holding the total compressed and decompressed
+ * sizes, so frame `i` spans [entries[i].xOffset, entries[i+1].xOffset). */
+typedef struct {
+    ZSTD_seekable_seekEntry* entries;
+    size_t tableLen;
+    int checksumFlag;
+} ZSTD_seekable_seekTable;
+
+struct ZSTD_seekable_s {
+    ZSTD_DStream* dstream;
+    ZSTD_seekable_seekTable seekTable;
+    ZSTD_seekable_customFile src;
+
+    /* decoding progress, kept across calls so that forward reads within the
+     * same frame continue where the previous call stopped */
+    U64 decompressedOffset;
+    U64 compressedOffset;
+    U32 curFrame;
+
+    BYTE inBuff[SEEKABLE_BUFF_SIZE];
+    BYTE outBuff[SEEKABLE_BUFF_SIZE];
+    ZSTD_inBuffer in;
+
+    XXH64_state_t xxhState;
+    ZSTD_seekable_buffWrapper buffWrapper;
+};
+
+ZSTD_seekable* ZSTD_seekable_create(void)
+{
+    ZSTD_seekable* const zs = (ZSTD_seekable*)ZSTD_customMalloc(
+            sizeof(ZSTD_seekable), ZSTD_defaultCMem);
+    if (zs == NULL) return NULL;
+
+    ZSTD_memset(zs, 0, sizeof(*zs));
+
+    zs->dstream = ZSTD_createDStream();
+    if (zs->dstream == NULL) {
+        ZSTD_customFree(zs, ZSTD_defaultCMem);
+        return NULL;
+    }
+
+    return zs;
+}
+
+size_t ZSTD_seekable_free(ZSTD_seekable* zs)
+{
+    if (zs == NULL) return 0;
+    ZSTD_freeDStream(zs->dstream);
+    ZSTD_customFree(zs->seekTable.entries, ZSTD_defaultCMem);
+    ZSTD_customFree(zs, ZSTD_defaultCMem);
+    return 0;
+}
+
+/* Binary search on the cached seek table, O(log nbFrames). */
+unsigned ZSTD_seekable_offsetToFrameIndex(const ZSTD_seekable* zs, unsigned long long pos)
+{
+    U32 lo = 0;
+    U32 hi = (U32)zs->seekTable.tableLen;
+    assert(zs->seekTable.tableLen <= UINT_MAX);
+
+    if (pos >= zs->seekTable.entries[zs->seekTable.tableLen].dOffset) {
+        return (unsigned)zs->seekTable.tableLen;
+    }
+
+    while (lo + 1 < hi) {
+        U32 const mid = lo + ((hi - lo) >> 1);
+        if (zs->seekTable.entries[mid].dOffset <= pos) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+unsigned ZSTD_seekable_getNumFrames(const ZSTD_seekable* zs)
+{
+    assert(zs->seekTable.tableLen <= UINT_MAX);
+    return (unsigned)zs->seekTable.tableLen;
+}
+
+unsigned long long ZSTD_seekable_getFrameCompressedOffset(const ZSTD_seekable* zs, unsigned frameIndex)
+{
+    if (frameIndex >= zs->seekTable.tableLen) return ZSTD_SEEKABLE_FRAMEINDEX_TOOLARGE;
+    return zs->seekTable.entries[frameIndex].cOffset;
+}
+
+unsigned long long ZSTD_seekable_getFrameDecompressedOffset(const ZSTD_seekable* zs, unsigned frameIndex)
+{
+    if (frameIndex >= zs->seekTable.tableLen) return ZSTD_SEEKABLE_FRAMEINDEX_TOOLARGE;
+    return zs->seekTable.entries[frameIndex].dOffset;
+}
+
+size_t ZSTD_seekable_getFrameCompressedSize(const ZSTD_seekable* zs, unsigned frameIndex)
+{
+    if (frameIndex >= zs->seekTable.tableLen) return ERROR(frameIndex_tooLarge);
+    return (size_t)(zs->seekTable.entries[frameIndex + 1].cOffset -
+                    zs->seekTable.entries[frameIndex].cOffset);
+}
+
+size_t ZSTD_seekable_getFrameDecompressedSize(const ZSTD_seekable* zs, unsigned frameIndex)
+{
+    if (frameIndex >= zs->seekTable.tableLen) return ERROR(frameIndex_tooLarge);
+    return (size_t)(zs->seekTable.entries[frameIndex + 1].dOffset -
+                    zs->seekTable.entries[frameIndex].dOffset);
+}
+
+/* Reads the footer and the seek table skippable frame located at the end of
+ * the archive and builds the cumulative offset index. */
+static size_t ZSTD_seekable_loadSeekTable(ZSTD_seekable* zs)
+{
+    int checksumFlag;
+    ZSTD_seekable_customFile const src = zs->src;
+    /* read the footer, fixed size */
+    RETURN_ERROR_IF(src.seek(src.opaque, -ZSTD_seekTableFooterSize, SEEK_END),
+                    seekableIO, "");
+    RETURN_ERROR_IF(src.read(src.opaque, zs->inBuff, ZSTD_seekTableFooterSize),
+                    seekableIO, "");
+
+    RETURN_ERROR_IF(MEM_readLE32(zs->inBuff + 5) != ZSTD_SEEKABLE_MAGICNUMBER,
+                    prefix_unknown, "");
+
+    {   BYTE const sfd = zs->inBuff[4];
+        checksumFlag = sfd >> 7;
+
+        /* check reserved bits */
+        RETURN_ERROR_IF((sfd >> 2) & 0x1f, corruption_detected, "");
+    }
+
+    {   U32 const numFrames = MEM_readLE32(zs->inBuff);
+        U32 const sizePerEntry = 8 + (checksumFlag ? 4 : 0);
+        U64 const tableSize = (U64)sizePerEntry * numFrames;
+        U64 const frameSize = tableSize + ZSTD_seekTableFooterSize + ZSTD_SKIPPABLEHEADERSIZE;
+
+        U32 remaining = (U32)(frameSize - ZSTD_seekTableFooterSize); /* don't need to re-read footer */
+        {   U32 const toRead = MIN(remaining, SEEKABLE_BUFF_SIZE);
+            RETURN_ERROR_IF(numFrames > ZSTD_SEEKABLE_MAXFRAMES, frameIndex_tooLarge, "");
+            RETURN_ERROR_IF(src.seek(src.opaque, -(long long)frameSize, SEEK_END),
+                            seekableIO, "");
+            RETURN_ERROR_IF(src.read(src.opaque, zs->inBuff, toRead), seekableIO, "");
+            remaining -= toRead;
+        }
+
+        RETURN_ERROR_IF(MEM_readLE32(zs->inBuff) != (ZSTD_MAGIC_SKIPPABLE_START | 0xE),
+                        prefix_unknown, "");
+        RETURN_ERROR_IF(MEM_readLE32(zs->inBuff + 4) + ZSTD_SKIPPABLEHEADERSIZE != frameSize,
+                        prefix_unknown, "");
+
+        {   /* Allocate an extra entry at the end so that we can do size
+             * computations on the last element without special case */
+            ZSTD_seekable_seekEntry* const entries = (ZSTD_seekable_seekEntry*)ZSTD_customMalloc(
+                    sizeof(ZSTD_seekable_seekEntry) * (numFrames + 1), ZSTD_defaultCMem);
+
+            U32 idx = 0;
+            U32 pos = 8;
+
+            U64 cOffset = 0;
+            U64 dOffset = 0;
+
+            RETURN_ERROR_IF(entries == NULL, memory_allocation, "");
+
+            /* compute cumulative positions */
+            for (; idx < numFrames; idx++) {
+                if (pos + sizePerEntry > SEEKABLE_BUFF_SIZE) {
+                    U32 const offset = SEEKABLE_BUFF_SIZE - pos;
+                    U32 const toRead = MIN(remaining, SEEKABLE_BUFF_SIZE - offset);
+                    ZSTD_memmove(zs->inBuff, zs->inBuff + pos, offset); /* move any data we haven't read yet */
+                    if (src.read(src.opaque, zs->inBuff + offset, toRead)) {
+                        ZSTD_customFree(entries, ZSTD_defaultCMem);
+                        RETURN_ERROR(seekableIO, "");
+                    }
+                    remaining -= toRead;
+                    pos = 0;
+                }
+                entries[idx].cOffset = cOffset;
+                entries[idx].dOffset = dOffset;
+
+                cOffset += MEM_readLE32(zs->inBuff + pos);
+                pos += 4;
+                dOffset += MEM_readLE32(zs->inBuff + pos);
+                pos += 4;
+                if (checksumFlag) {
+                    entries[idx].checksum = MEM_readLE32(zs->inBuff + pos);
+                    pos += 4;
+                }
+            }
+            entries[numFrames].cOffset = cOffset;
+            entries[numFrames].dOffset = dOffset;
+
+            ZSTD_customFree(zs->seekTable.entries, ZSTD_defaultCMem);
+            zs->seekTable.entries = entries;
+            zs->seekTable.tableLen = numFrames;
+            zs->seekTable.checksumFlag = checksumFlag;
+            return 0;
+        }
+    }
+}
+
+size_t ZSTD_seekable_initBuff(ZSTD_seekable* zs, const void* src, size_t srcSize)
+{
+    zs->buffWrapper.ptr = src;
+    zs->buffWrapper.size = srcSize;
+    zs->buffWrapper.pos = 0;
+    {   ZSTD_seekable_customFile srcFile = { &zs->buffWrapper,
+                                             &ZSTD_seekable_read_buff,
+                                             &ZSTD_seekable_seek_buff };
+        return ZSTD_seekable_initAdvanced(zs, srcFile);
+    }
+}
+
+size_t ZSTD_seekable_initFile(ZSTD_seekable* zs, FILE* src)
+{
+    ZSTD_seekable_customFile srcFile = { src, &ZSTD_seekable_read_FILE,
+                                         &ZSTD_seekable_seek_FILE };
+    return ZSTD_seekable_initAdvanced(zs, srcFile);
+}
+
+size_t ZSTD_seekable_initAdvanced(ZSTD_seekable* zs, ZSTD_seekable_customFile src)
+{
+    RETURN_ERROR_IF(zs == NULL, GENERIC, "");
+    zs->src = src;
+
+    FORWARD_IF_ERROR(ZSTD_seekable_loadSeekTable(zs), "");
+
+    /* force a restart on the first read */
+    zs->decompressedOffset = (U64)-1;
+    zs->compressedOffset = 0;
+    zs->curFrame = 0;
+
+    zs->in.src = zs->inBuff;
+    zs->in.pos = 0;
+    zs->in.size = 0;
+
+    FORWARD_IF_ERROR(ZSTD_DCtx_reset(zs->dstream, ZSTD_reset_session_only), "");
+    return 0;
+}
+
+size_t ZSTD_seekable_decompress(ZSTD_seekable* zs, void* dst, size_t len, unsigned long long offset)
+{
+    U64 const eos = zs->seekTable.entries[zs->seekTable.tableLen].dOffset;
+    int const checksumFlag = zs->seekTable.checksumFlag;
+
+    if (offset >= eos) return 0;
+    if (offset + len > eos) {
+        len = (size_t)(eos - offset);
+    }
+
+    /* Restart only when the request lies behind the decoding position or in
+     * another frame; a forward read within the current frame resumes the
+     * decoding in progress. */
+    {   U32 const targetFrame = ZSTD_seekable_offsetToFrameIndex(zs, offset);
+        if (targetFrame != zs->curFrame || offset < zs->decompressedOffset) {
+            zs->curFrame = targetFrame;
+            zs->decompressedOffset = zs->seekTable.entries[targetFrame].dOffset;
+            zs->compressedOffset = zs->seekTable.entries[targetFrame].cOffset;
+
+            RETURN_ERROR_IF(zs->src.seek(zs->src.opaque, (long long)zs->compressedOffset, SEEK_SET),
+                            seekableIO, "");
+            zs->in.pos = 0;
+            zs->in.size = 0;
+            if (checksumFlag) XXH64_reset(&zs->xxhState, 0);
+            FORWARD_IF_ERROR(ZSTD_DCtx_reset(zs->dstream, ZSTD_reset_session_only), "");
+        }
+    }
+
+    while (zs->decompressedOffset < offset + len) {
+        ZSTD_outBuffer outTmp;
+        size_t prevOutPos;
+        size_t ret;
+
+        if (zs->decompressedOffset < offset) {
+            /* discard the part of the frame preceding the requested offset */
+            outTmp.dst = zs->outBuff;
+            outTmp.size = (size_t)MIN(SEEKABLE_BUFF_SIZE, offset - zs->decompressedOffset);
+            outTmp.pos = 0;
+        } else {
+            outTmp.dst = dst;
+            outTmp.size = len;
+            outTmp.pos = (size_t)(zs->decompressedOffset - offset);
+        }
+
+        /* refill, never reading past the end of the current frame */
+        if (zs->in.pos == zs->in.size) {
+            U64 const frameEnd = zs->seekTable.entries[zs->curFrame + 1].cOffset;
+            size_t const toRead = (size_t)MIN(SEEKABLE_BUFF_SIZE, frameEnd - zs->compressedOffset);
+            RETURN_ERROR_IF(toRead == 0, corruption_detected, "frame shorter than its seek table entry");
+            RETURN_ERROR_IF(zs->src.read(zs->src.opaque, zs->inBuff, toRead), seekableIO, "");
+            zs->compressedOffset += toRead;
+            zs->in.size = toRead;
+            zs->in.pos = 0;
+        }
+
+        prevOutPos = outTmp.pos;
+        ret = ZSTD_decompressStream(zs->dstream, &outTmp, &zs->in);
+        FORWARD_IF_ERROR(ret, "");
+        if (checksumFlag) {
+            XXH64_update(&zs->xxhState, (BYTE*)outTmp.dst + prevOutPos,
+                         outTmp.pos - prevOutPos);
+        }
+        zs->decompressedOffset += outTmp.pos - prevOutPos;
+
+        if (ret == 0) {
+            /* frame complete: validate it against the seek table, then move
+             * on to the next frame which directly follows in the source */
+            RETURN_ERROR_IF(zs->decompressedOffset != zs->seekTable.entries[zs->curFrame + 1].dOffset,
+                            corruption_detected, "");
+            RETURN_ERROR_IF(zs->in.pos != zs->in.size ||
+                            zs->compressedOffset != zs->seekTable.entries[zs->curFrame + 1].cOffset,
+                            corruption_detected, "");
+            RETURN_ERROR_IF(checksumFlag &&
+                            (U32)XXH64_digest(&zs->xxhState) != zs->seekTable.entries[zs->curFrame].checksum,
+                            checksum_wrong, "");
+            zs->curFrame++;
+            if (checksumFlag) XXH64_reset(&zs->xxhState, 0);
+        }
+    }
+
+    return len;
+}
+
+size_t ZSTD_seekable_decompressFrame(ZSTD_seekable* zs, void* dst, size_t dstSize, unsigned frameIndex)
+{
+    RETURN_ERROR_IF(frameIndex >= zs->seekTable.tableLen, frameIndex_tooLarge, "");
+
+    {   size_t const decompressedSize =
+            (size_t)(zs->seekTable.entries[frameIndex + 1].dOffset -
+                     zs->seekTable.entries[frameIndex].dOffset);
+        RETURN_ERROR_IF(dstSize < decompressedSize, dstSize_tooSmall, "");
+        return ZSTD_seekable_decompress(
+                zs, dst, decompressedSize,
+                zs->seekTable.entries[frameIndex].dOffset);
+    }
+}
@@ -34,6 +34,7 @@
 ***************************************/
 #define FASTCOVER_MAX_SAMPLES_SIZE (sizeof(size_t) == 8 ? ((unsigned)-1) : ((unsigned)1 GB))
 #define FASTCOVER_MAX_F 31
+#define FASTCOVER_MIN_F 12  /* lowest f used to fit a memory limit */
 #define FASTCOVER_MAX_ACCEL 10
 #define FASTCOVER_DEFAULT_SPLITPOINT 0.75
 #define DEFAULT_F 20
@@ -447,6 +448,23 @@ FASTCOVER_buildDictionary(const FASTCOVER_ctx_t* ctx,
   return tail;
 }
 
+/**
+ * Memory used by FASTCOVER_tryParameters() for one set of parameters:
+ * the frequency and segment counters, the dictionary buffers of
+ * COVER_selectDict() and the context, digested dictionary and output
+ * buffer used to compress the test samples.
+ */
+static size_t
+FASTCOVER_tryParametersMemory(unsigned f, size_t dictBufferCapacity,
+                              size_t maxSampleSize, int compressionLevel)
+{
+    return ((size_t)6 << f) + 3 * dictBufferCapacity
+         + ZSTD_compressBound(maxSampleSize)
+         + ZSTD_estimateCCtxSize(compressionLevel)
+         + ZSTD_estimateCDictSize(dictBufferCapacity, compressionLevel);
+}
+
+
 /**
  * Parameters for FASTCOVER_tryParameters().
  */
@@ -607,17 +625,18 @@ ZDICT_trainFromBuffer_fastCover(void* dictBuffer, size_t dictBufferCapacity,
 }
 
 
-ZDICTLIB_API size_t
-ZDICT_optimizeTrainFromBuffer_fastCover(
+static size_t
+FASTCOVER_optimizeTrainFromBuffer(
                     void* dictBuffer, size_t dictBufferCapacity,
                     const void* samplesBuffer,
                     const size_t* samplesSizes, unsigned nbSamples,
-                    ZDICT_fastCover_params_t* parameters)
+                    ZDICT_fastCover_params_t* parameters, size_t memLimit)
 {
     ZDICT_cover_params_t coverParams;
     FASTCOVER_accel_t accelParams;
+    unsigned nbThreads = parameters->nbThreads;
+    unsigned f = parameters->f == 0 ? DEFAULT_F : parameters->f;
     /* constants */
-    const unsigned nbThreads = parameters->nbThreads;
     const double splitPoint =
         parameters->splitPoint <= 0.0 ? FASTCOVER_DEFAULT_SPLITPOINT : parameters->splitPoint;
     const unsigned kMinD = parameters->d == 0 ? 6 : parameters->d;
@@ -628,7 +647,6 @@ ZDICT_optimizeTrainFromBuffer_fastCover(
     const unsigned kStepSize = MAX((kMaxK - kMinK) / kSteps, 1);
     const unsigned kIterations =
         (1 + (kMaxD - kMinD) / 2) * (1 + (kMaxK - kMinK) / kStepSize);
-    const unsigned f = parameters->f == 0 ? DEFAULT_F : parameters->f;
     const unsigned accel = parameters->accel == 0 ? DEFAULT_ACCEL : parameters->accel;
     const unsigned shrinkDict = 0;
     /* Local variables */
@@ -661,6 +679,31 @@ ZDICT_optimizeTrainFromBuffer_fastCover(
                    ZDICT_DICTSIZE_MIN);
       return ERROR(dstSize_tooSmall);
     }
+    /* Fit the shared context, the best dictionary and the parameter sets
+     * tried concurrently within memLimit */
+    if (memLimit) {
+      size_t maxSampleSize = 0;
+      size_t sharedSize;
+      size_t jobSize;
+      unsigned i;
+      for (i = 0; i < nbSamples; i++) {
+        maxSampleSize = MAX(samplesSizes[i], maxSampleSize);
+      }
+      for (;;) {
+        sharedSize = ((size_t)4 << f) + (nbSamples + 1) * sizeof(size_t) + dictBufferCapacity;
+        jobSize = FASTCOVER_tryParametersMemory(f, dictBufferCapacity, maxSampleSize,
+                                                parameters->zParams.compressionLevel);
+        if (sharedSize + jobSize <= memLimit || f <= FASTCOVER_MIN_F) break;
+        f--;
+      }
+      if (sharedSize + jobSize > memLimit) {
+        LOCALDISPLAYLEVEL(displayLevel, 1, "memLimit is too small for FASTCOVER\n");
+        return ERROR(memory_allocation);
+      }
+      nbThreads = (unsigned)MIN(nbThreads, (memLimit - sharedSize) / jobSize);
+      LOCALDISPLAYLEVEL(displayLevel, 3, "memLimit: f=%u, %u parameter sets at a time\n",
+                        f, MAX(nbThreads, 1));
+    }
     if (nbThreads > 1) {
       pool = POOL_create(nbThreads, 1);
       if (!pool) {
@@ -757,3 +800,27 @@ ZDICT_optimizeTrainFromBuffer_fastCover(
     }
 
 }
+
+
+ZDICTLIB_API size_t
+ZDICT_optimizeTrainFromBuffer_fastCover(
+                    void* dictBuffer, size_t dictBufferCapacity,
+                    const void* samplesBuffer,
+                    const size_t* samplesSizes, unsigned nbSamples,
+                    ZDICT_fastCover_params_t* parameters)
+{
+    return FASTCOVER_optimizeTrainFromBuffer(dictBuffer, dictBufferCapacity,
+                    samplesBuffer, samplesSizes, nbSamples, parameters, 0);
+}
+
+
+ZDICTLIB_API size_t
+ZDICT_optimizeTrainFromBuffer_fastCover_memLimit(
+                    void* dictBuffer, size_t dictBufferCapacity,
+                    const void* samplesBuffer,
+                    const size_t* samplesSizes, unsigned nbSamples,
+                    ZDICT_fastCover_params_t* parameters, size_t memLimit)
+{
+    return FASTCOVER_optimizeTrainFromBuffer(dictBuffer, dictBufferCapacity,
+                    samplesBuffer, samplesSizes, nbSamples, parameters, memLimit);
+}
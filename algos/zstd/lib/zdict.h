@@ -389,6 +389,23 @@ ZDICTLIB_API size_t ZDICT_optimizeTrainFromBuffer_fastCover(void* dictBuffer,
                     const size_t* samplesSizes, unsigned nbSamples,
                     ZDICT_fastCover_params_t* parameters);
 
+/*! ZDICT_optimizeTrainFromBuffer_fastCover_memLimit():
+ * Same as ZDICT_optimizeTrainFromBuffer_fastCover(), with the memory used by the
+ * parameter search kept within `memLimit` bytes (0 means no limit).
+ * The number of parameter sets tried concurrently is lowered from `nbThreads`
+ * to fit the limit. If a single one does not fit, `f` is lowered (down to 12).
+ * The `f` used is written back into `*parameters`.
+ * `nbThreads` > 1 runs parameter sets in parallel when built with ZSTD_MULTITHREAD.
+ *
+ * @return: size of dictionary stored into `dictBuffer` (<= `dictBufferCapacity`)
+ *          or an error code, which can be tested with ZDICT_isError().
+ *          memory_allocation is returned if `memLimit` is too small even at f = 12.
+ */
+ZDICTLIB_API size_t ZDICT_optimizeTrainFromBuffer_fastCover_memLimit(void* dictBuffer,
+                    size_t dictBufferCapacity, const void* samplesBuffer,
+                    const size_t* samplesSizes, unsigned nbSamples,
+                    ZDICT_fastCover_params_t* parameters, size_t memLimit);
+
 typedef struct {
     unsigned selectivityLevel;   /* 0 means default; larger => select more => larger dictionary */
     ZDICT_params_t zParams;
@@ -2035,6 +2035,34 @@ ZSTDLIB_API unsigned long long ZSTD_findDecompressedSize(const void* src, size_t
  */
 ZSTDLIB_API unsigned long long ZSTD_decompressBound(const void* src, size_t srcSize);
 
+/*!
+ * @brief Margin required for in-place decompression of a single frame.
+ *
+ * Zstd supports in-place decompression, where the input and output buffers overlap.
+ * The compressed frame is placed at the end of a buffer of at least
+ * `originalSize + ZSTD_DECOMPRESSION_MARGIN(originalSize, blockSize)` bytes,
+ * and decompressed to the start of that buffer:
+ *
+ *     |<---------------------- buffer ----------------------->|
+ *                                 |<--- compressed frame ---->|
+ *     |<------ decompressed size ------>|<----- margin ------>|
+ *
+ * @param originalSize decompressed size of the frame.
+ * @param blockSize    maximum block size of the frame, `min(windowSize, ZSTD_BLOCKSIZE_MAX)`.
+ *                     `ZSTD_BLOCKSIZE_MAX` is always large enough.
+ *
+ * @note The margin covers the frame header, the checksum, the 3 byte header of every block,
+ *       and one block of output, so that decoding never overwrites input it has not yet read.
+ *       It is only valid for frames which do not expand the data, as produced by the compressor.
+ */
+#define ZSTD_DECOMPRESSION_MARGIN(originalSize, blockSize) ((size_t)(                        \
+        ZSTD_FRAMEHEADERSIZE_MAX                                       /* frame header */  + \
+        4                                                              /* checksum */      + \
+        ((originalSize) == 0 ? 0 :                                                           \
+            3 * (((originalSize) + (blockSize) - 1) / (blockSize)))    /* block headers */ + \
+        (blockSize)                                                    /* one block */       \
+    ))
+
 /*! 
  * @param src `src` should point to the start of a series of ZSTD encoded and/or skippable frames.
  * @param srcSize `srcSize` must be the _exact_ size of this series (i.e. there should be a frame boundary at `src + srcSize`).
@@ -2385,7 +2413,12 @@ ZSTDLIB_API size_t ZSTD_CCtx_refPrefix_advanced(ZSTD_CCtx* cctx, const void* pre
   * the granularity of the synchronization point.
   * Once the jobSize is smaller than the window size,
   * it will result in compression ratio degradation.
-  * NOTE 1: rsyncable mode only works when multithreading is enabled.
+  * NOTE 1: with AOCL_ZSTD_OPT, rsyncable mode also works without workers.
+  * The sync points are then found on the calling thread, on average every
+  * 1 MB of input, and ZSTD_c_stableInBuffer is not supported. The fast and
+  * dfast strategies may take longer to resync after a change on input with
+  * little redundancy, since they only index the positions they visit.
+  * Otherwise, rsyncable mode only works when multithreading is enabled.
   * NOTE 2: rsyncable performs poorly in combination with long range mode,
   * since it will decrease the effectiveness of synchronization points,
   * though mileage may vary.
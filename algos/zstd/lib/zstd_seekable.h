@@ -0,0 +1,314 @@
+/**
+ * Copyright (C) 2023, Advanced Micro Devices. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file zstd_seekable.h
+ *
+ *  @brief Seekable format support for ZSTD.
+ *
+ *  A seekable archive is a sequence of independent zstd frames followed by a
+ *  skippable frame holding a seek table. The seek table records the compressed
+ *  and decompressed size of every frame, so that a reader can decompress only
+ *  the frames overlapping a requested range of the original data.
+ *  The on-disk layout is compatible with the zstd seekable format
+ *  (contrib/seekable_format in upstream zstd), so archives are readable by
+ *  any standard zstd decoder as a plain concatenation of frames.
+ */
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#ifndef ZSTD_SEEKABLE_H
+#define ZSTD_SEEKABLE_H
+
+#include <stdio.h>    /* FILE */
+#include "zstd.h"     /* ZSTDLIB_API, ZSTD_inBuffer, ZSTD_outBuffer */
+
+/*!
+ * \addtogroup ZSTD_API
+ * @{
+ */
+
+/*!
+ * @name Seekable format
+ * @{
+ */
+
+/// @cond DOXYGEN_SHOULD_SKIP_THIS
+#define ZSTD_seekTableFooterSize 9
+
+#define ZSTD_SEEKABLE_MAGICNUMBER 0x8F92EAB1
+
+#define ZSTD_SEEKABLE_MAXFRAMES 0x8000000U
+
+/* Limit the maximum size to avoid any potential issues storing the compressed size */
+#define ZSTD_SEEKABLE_MAX_FRAME_DECOMPRESSED_SIZE 0x40000000U
+
+#define ZSTD_SEEKABLE_FRAMEINDEX_TOOLARGE (0U - 2)
+/// @endcond /* DOXYGEN_SHOULD_SKIP_THIS */
+
+typedef struct ZSTD_seekable_CStream_s ZSTD_seekable_CStream;
+typedef struct ZSTD_seekable_s ZSTD_seekable;
+
+/*===== Seekable compressor =====*/
+
+/*!
+ * @brief Allocates a seekable compression stream.
+ *
+ * @return Pointer to the stream, or \b NULL on allocation failure.
+ */
+ZSTDLIB_API ZSTD_seekable_CStream* ZSTD_seekable_createCStream(void);
+
+/*!
+ * @brief Releases a seekable compression stream and all its resources.
+ *
+ * @return \b 0, accepts \b NULL.
+ */
+ZSTDLIB_API size_t ZSTD_seekable_freeCStream(ZSTD_seekable_CStream* zcs);
+
+/*!
+ * @brief Starts a new seekable archive.
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b zcs              | in,out | Seekable compression stream.|
+ * | \b compressionLevel | in     | zstd compression level used for every frame.|
+ * | \b checksumFlag     | in     | When non-zero, a 32-bit XXH64 checksum of each frame's content is stored in the seek table.|
+ * | \b maxFrameSize     | in     | Decompressed size after which a frame is closed automatically. \b 0 selects the maximum (1 GB).|
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    | Recommended size for the first input buffer. |
+ * | Fail       | Error code, testable with ZSTD_isError(). |
+ *
+ * @note Smaller frames give finer grained random access at the expense of
+ * compression ratio. Frames in the 64 KB - 1 MB range are a good trade-off.
+ */
+ZSTDLIB_API size_t ZSTD_seekable_initCStream(ZSTD_seekable_CStream* zcs, int compressionLevel,
+                                             int checksumFlag, unsigned maxFrameSize);
+
+/*!
+ * @brief Consumes input and writes compressed data, closing a frame each time
+ * `maxFrameSize` bytes of input have been consumed into it.
+ *
+ * Semantics of `output` and `input` are the same as ZSTD_compressStream2().
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    | Hint for the preferred number of bytes to use as input for the next call. |
+ * | Fail       | Error code, testable with ZSTD_isError(). |
+ */
+ZSTDLIB_API size_t ZSTD_seekable_compressStream(ZSTD_seekable_CStream* zcs, ZSTD_outBuffer* output,
+                                                ZSTD_inBuffer* input);
+
+/*!
+ * @brief Closes the current frame before `maxFrameSize` is reached.
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    | \b 0 when the frame is fully flushed, otherwise the number of bytes still to be flushed. |
+ * | Fail       | Error code, testable with ZSTD_isError(). |
+ */
+ZSTDLIB_API size_t ZSTD_seekable_endFrame(ZSTD_seekable_CStream* zcs, ZSTD_outBuffer* output);
+
+/*!
+ * @brief Closes the current frame and writes the seek table.
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    | \b 0 when the archive is complete, otherwise the number of bytes still to be flushed. |
+ * | Fail       | Error code, testable with ZSTD_isError(). |
+ */
+ZSTDLIB_API size_t ZSTD_seekable_endStream(ZSTD_seekable_CStream* zcs, ZSTD_outBuffer* output);
+
+/*!
+ * @brief Maximum size of a seekable archive produced by ZSTD_seekable_compress().
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b srcSize      | in | Size of the data to compress.|
+ * | \b maxFrameSize | in | Frame size passed to ZSTD_seekable_compress(), \b 0 selects the maximum.|
+ * | \b checksumFlag | in | Checksum flag passed to ZSTD_seekable_compress().|
+ */
+ZSTDLIB_API size_t ZSTD_seekable_compressBound(size_t srcSize, unsigned maxFrameSize, int checksumFlag);
+
+/*!
+ * @brief Compresses `src` into a complete seekable archive in a single call.
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b dst              | out | Destination buffer.|
+ * | \b dstCapacity      | in  | Size of `dst`, ZSTD_seekable_compressBound() guarantees success.|
+ * | \b src              | in  | Data to compress.|
+ * | \b srcSize          | in  | Size of `src`.|
+ * | \b compressionLevel | in  | zstd compression level used for every frame.|
+ * | \b maxFrameSize     | in  | Decompressed size of each frame, \b 0 selects the maximum.|
+ * | \b checksumFlag     | in  | When non-zero, per-frame checksums are stored in the seek table.|
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    | Number of bytes written into `dst`. |
+ * | Fail       | Error code, testable with ZSTD_isError(). |
+ */
+ZSTDLIB_API size_t ZSTD_seekable_compress(void* dst, size_t dstCapacity,
+                                          const void* src, size_t srcSize,
+                                          int compressionLevel, unsigned maxFrameSize,
+                                          int checksumFlag);
+
+/*===== Seekable decompressor =====*/
+
+/*!
+ * @brief Callback reading exactly `n` bytes into `buffer`. Returns \b 0 on success.
+ */
+typedef int(ZSTD_seekable_read)(void* opaque, void* buffer, size_t n);
+
+/*!
+ * @brief Callback moving the read position, `origin` is one of SEEK_SET, SEEK_CUR or SEEK_END.
+ * Returns \b 0 on success.
+ */
+typedef int(ZSTD_seekable_seek)(void* opaque, long long offset, int origin);
+
+/*!
+ * @brief Random access source abstraction used by ZSTD_seekable_initAdvanced().
+ */
+typedef struct {
+    void* opaque;               ///< User data passed to the callbacks
+    ZSTD_seekable_read* read;   ///< Read callback
+    ZSTD_seekable_seek* seek;   ///< Seek callback
+} ZSTD_seekable_customFile;
+
+/*!
+ * @brief Allocates a seekable decompression object.
+ *
+ * @return Pointer to the object, or \b NULL on allocation failure.
+ */
+ZSTDLIB_API ZSTD_seekable* ZSTD_seekable_create(void);
+
+/*!
+ * @brief Releases a seekable decompression object, its cached seek table and
+ * decoding state. Accepts \b NULL.
+ */
+ZSTDLIB_API size_t ZSTD_seekable_free(ZSTD_seekable* zs);
+
+/*!
+ * @brief Attaches an in-memory seekable archive and loads its seek table.
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b zs      | in,out | Seekable decompression object.|
+ * | \b src     | in     | Complete seekable archive. Must remain valid while `zs` is in use.|
+ * | \b srcSize | in     | Size of `src`.|
+ *
+ * @return \b 0 on success, or an error code testable with ZSTD_isError().
+ */
+ZSTDLIB_API size_t ZSTD_seekable_initBuff(ZSTD_seekable* zs, const void* src, size_t srcSize);
+
+/*!
+ * @brief Attaches a seekable archive stored in a file and loads its seek table.
+ * The file must remain open while `zs` is in use.
+ *
+ * @return \b 0 on success, or an error code testable with ZSTD_isError().
+ */
+ZSTDLIB_API size_t ZSTD_seekable_initFile(ZSTD_seekable* zs, FILE* src);
+
+/*!
+ * @brief Attaches a seekable archive accessed through user callbacks and loads
+ * its seek table. Only the seek table and the frames overlapping requested
+ * ranges are ever read from `src`.
+ *
+ * @return \b 0 on success, or an error code testable with ZSTD_isError().
+ */
+ZSTDLIB_API size_t ZSTD_seekable_initAdvanced(ZSTD_seekable* zs, ZSTD_seekable_customFile src);
+
+/*!
+ * @brief Decompresses `len` bytes of original data starting at `offset`.
+ *
+ * Only the frames overlapping `[offset, offset + len)` are decompressed.
+ * Consecutive forward reads within the same frame resume the decoding in
+ * progress instead of restarting the frame.
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b zs     | in,out | Initialized seekable decompression object.|
+ * | \b dst    | out    | Destination buffer of at least `len` bytes.|
+ * | \b len    | in     | Number of bytes to decompress.|
+ * | \b offset | in     | Offset in the original data of the first byte to decompress.|
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    | Number of bytes written to `dst`, smaller than `len` only when the range runs past the end of the data. |
+ * | Fail       | Error code, testable with ZSTD_isError(). |
+ */
+ZSTDLIB_API size_t ZSTD_seekable_decompress(ZSTD_seekable* zs, void* dst, size_t len,
+                                            unsigned long long offset);
+
+/*!
+ * @brief Decompresses a whole frame into `dst`, which must be at least
+ * ZSTD_seekable_getFrameDecompressedSize() bytes.
+ *
+ * @return Number of bytes written to `dst`, or an error code testable with ZSTD_isError().
+ */
+ZSTDLIB_API size_t ZSTD_seekable_decompressFrame(ZSTD_seekable* zs, void* dst, size_t dstSize,
+                                                 unsigned frameIndex);
+
+/*!
+ * @name Seek table queries
+ * @brief Accessors on the cached seek table of an initialized ZSTD_seekable.
+ * Offset and size queries return ZSTD_SEEKABLE_FRAMEINDEX_TOOLARGE for an
+ * out of range `frameIndex`.
+ * @{
+ */
+ZSTDLIB_API unsigned ZSTD_seekable_getNumFrames(const ZSTD_seekable* zs);
+ZSTDLIB_API unsigned long long ZSTD_seekable_getFrameCompressedOffset(const ZSTD_seekable* zs, unsigned frameIndex);
+ZSTDLIB_API unsigned long long ZSTD_seekable_getFrameDecompressedOffset(const ZSTD_seekable* zs, unsigned frameIndex);
+ZSTDLIB_API size_t ZSTD_seekable_getFrameCompressedSize(const ZSTD_seekable* zs, unsigned frameIndex);
+ZSTDLIB_API size_t ZSTD_seekable_getFrameDecompressedSize(const ZSTD_seekable* zs, unsigned frameIndex);
+ZSTDLIB_API unsigned ZSTD_seekable_offsetToFrameIndex(const ZSTD_seekable* zs, unsigned long long offset);
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif /* ZSTD_SEEKABLE_H */
+
+#if defined (__cplusplus)
+}
+#endif
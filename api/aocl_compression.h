@@ -115,6 +115,68 @@ typedef enum
     AOCL_COMPRESSOR_ALGOS_NUM
 } aocl_compression_type;
 
+/**
+ * @brief Stream formats of the ZLIB method.
+ *
+ * Selected through `optVar` of aocl_compression_desc, see AOCL_ZLIB_OPT_VAR().
+ */
+typedef enum
+{
+    AOCL_ZLIB_FORMAT_ZLIB = 0,  ///<zlib header and Adler-32 trailer (RFC 1950)
+    AOCL_ZLIB_FORMAT_GZIP,      ///<gzip header and CRC-32 trailer (RFC 1952)
+    AOCL_ZLIB_FORMAT_RAW        ///<raw deflate data without header or check value (RFC 1951)
+} aocl_zlib_format;
+
+/**
+ * @brief Packs the stream parameters of the ZLIB method into `optVar` of aocl_compression_desc.
+ *
+ * | Parameters   | Bits  | Description |
+ * |:-------------|:-----:|:------------|
+ * | \b format     | 0-1   | Stream format, choose from aocl_zlib_format. |
+ * | \b windowBits | 2-5   | Base two logarithm of the window size, 9 to 15. 0 selects 15. |
+ * | \b memLevel   | 6-9   | Memory used for the hash table, 1 to 9. 0 selects 8. |
+ * | \b strategy   | 10-12 | Z_DEFAULT_STRATEGY (0), Z_FILTERED (1), Z_HUFFMAN_ONLY (2), Z_RLE (3) or Z_FIXED (4). |
+ *
+ * The fields have the meaning of the matching deflateInit2() arguments.
+ * `optVar` = 0 gives a zlib stream with the default parameters, same as compress2().
+ * Decompression only uses the format, so the same `optVar` can be passed to both calls.
+ * Out of range fields fail the compression or decompression call.
+ */
+#define AOCL_ZLIB_OPT_VAR(format, windowBits, memLevel, strategy) \
+    ((size_t)(format) | ((size_t)(windowBits) << 2) | \
+     ((size_t)(memLevel) << 6) | ((size_t)(strategy) << 10))
+
+/**
+ * @brief Block formats of the LZ4 method.
+ *
+ * Selected through `optVar` of aocl_compression_desc, before aocl_llc_setup() is called.
+ */
+typedef enum
+{
+    AOCL_LZ4_FORMAT_BLOCK = 0,  ///<independent blocks, each call compresses or decompresses a self-contained block
+    AOCL_LZ4_FORMAT_STREAM      ///<linked blocks, each block may reference the last 64 KB of earlier blocks of the stream
+} aocl_lz4_format;
+
+/**
+ * @brief Decompression modes of the SNAPPY method.
+ *
+ * Selected through `optVar` of aocl_compression_desc, at decompression.
+ * In both modes, compressed data that does not fit in `outSize` fails
+ * without writing to the output buffer.
+ */
+typedef enum
+{
+    AOCL_SNAPPY_DECOMPRESS_DEFAULT = 0, ///<invalid compressed data fails, possibly after part of the output is written
+    AOCL_SNAPPY_DECOMPRESS_VALIDATE     ///<the whole input is validated first, invalid compressed data leaves the output untouched
+} aocl_snappy_decompress_mode;
+
+/**
+ * @brief Dictionary prepared once and shared by the streams of any number of handles.
+ *
+ * Created by aocl_llc_create_dict() and attached to a stream by aocl_llc_reset_stream().
+ */
+typedef struct aocl_llc_dict_s aocl_llc_dict;
+
 /**
  * @brief This acts as a handle for the compression and decompression of AOCL Compression library.
  * 
@@ -127,7 +189,10 @@ typedef struct
     size_t inSize;       /**<  Input data length                                      */                      
     size_t outSize;      /**<  Output data length                                     */ 
     size_t level;        /**<  Requested compression level                            */
-    size_t optVar;       /**<  Additional variables or parameters                     */
+    size_t optVar;       /**<  Additional variables or parameters. \n
+                               ZLIB: stream format and parameters, see AOCL_ZLIB_OPT_VAR() \n
+                               LZ4: block format, choose from aocl_lz4_format \n
+                               SNAPPY: decompression mode, choose from aocl_snappy_decompress_mode */
     int numThreads;      /**<  Number of threads available for multi-threading        */
     int numMPIranks;     /**<  Number of available multi-core MPI ranks               */
     size_t memLimit;     /**<  Maximum memory limit for compression/decompression     */
@@ -168,6 +233,39 @@ typedef struct
 EXPORT_SYM_DYN uint32_t aocl_llc_compress(aocl_compression_desc *handle,
                             aocl_compression_type codec_type);
 
+/**
+ * @brief Interface API to compress data, adapting the level to a target speed.
+ *
+ * Compresses like aocl_llc_compress() at `handle->level` and always records
+ * `cSize`, `cTime` and `cSpeed` in the handle. The measured speed is then used
+ * as feedback to pick the level for the next call on the same handle:
+ * `handle->level` is lowered by one when `cSpeed` falls below `targetSpeed`, and
+ * raised by one when `cSpeed` exceeds `targetSpeed` with 25% headroom to spare.
+ * Calling it once per block of a stream therefore keeps up with bursts of input
+ * and returns to better ratios when CPU time is available.
+ * A latency budget of `T` ms per block maps to `targetSpeed = inSize / (T * 1000)`.
+ * Levels are kept within 1-22 for ZSTD and 1-12 for LZ4HC. Other methods are not supported.
+ * Blocks of a few tens of KB or more give stable timings.
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b handle      | in,out  | This acts as a handle for compression and decompression. For more information, refer to aocl_compression_desc. |
+ * | \b codec_type  | in      | Select the algorithm to be used for compression, choose from aocl_compression_type. |
+ * | \b targetSpeed | in      | Target compression speed in MB/s. |
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    |Numbers of bytes compressed       |
+ * | Fail       |`ERR_UNSUPPORTED_METHOD`          |
+ * | ^          |`ERR_COMPRESSION_FAILED`          |
+ * | ^          |`ERR_COMPRESSION_INVALID_OUTPUT`  |
+ *
+ */
+EXPORT_SYM_DYN uint32_t aocl_llc_compress_adaptive(aocl_compression_desc *handle,
+                            aocl_compression_type codec_type,
+                            float targetSpeed);
+
 /**
  * @brief Interface API to decompress data.
  * 
@@ -188,6 +286,61 @@ EXPORT_SYM_DYN uint32_t aocl_llc_compress(aocl_compression_desc *handle,
 EXPORT_SYM_DYN uint32_t aocl_llc_decompress(aocl_compression_desc *handle,
                               aocl_compression_type codec_type);
 
+/**
+ * @brief Interface API to get the margin required to decompress data in place.
+ *
+ * For in-place decompression, the compressed data is placed at the end of a buffer
+ * of `outSize + margin` bytes, and decompressed to the start of the same buffer:
+ *
+ *     |<---------------------- buffer ----------------------->|
+ *                                 |<--- compressed data ----->|
+ *     |<----------- outSize ----------->|<----- margin ------>|
+ *
+ * The margin is small compared to the data, so a single buffer replaces separate
+ * input and output buffers. Only LZ4, LZ4HC and ZSTD support in-place decompression.
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b codec_type | in      | Select the algorithm of the compressed data, choose from aocl_compression_type. |
+ * | \b inSize     | in      | Size of the compressed data. |
+ * | \b outSize    | in      | Size of the decompressed data. |
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    | Margin in bytes                |
+ * | Fail       | `ERR_UNSUPPORTED_METHOD`       |
+ */
+EXPORT_SYM_DYN int64_t aocl_llc_decompress_margin(aocl_compression_type codec_type,
+                        size_t inSize, size_t outSize);
+
+/**
+ * @brief Interface API to decompress data in place.
+ *
+ * Decompresses like aocl_llc_decompress(), with `handle->inBuf` allowed to overlap
+ * `handle->outBuf`. `handle->outSize` is the size of the decompressed data. When the
+ * buffers overlap, the compressed data must end at least aocl_llc_decompress_margin()
+ * bytes past `handle->outBuf + handle->outSize`, which holds when it is placed at the
+ * end of a buffer of `outSize + margin` bytes.
+ * The layout is checked before decompression, and buffers that do not overlap are
+ * decompressed as usual.
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b handle     | in,out  | This acts as a handle for compression and decompression. For more information, refer to aocl_compression_desc. |
+ * | \b codec_type | in      | Select the algorithm to be used for decompression, choose from aocl_compression_type. |
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    | Numbers of bytes decompressed     |
+ * | Fail       | `ERR_UNSUPPORTED_METHOD`          |
+ * | ^          | `ERR_COMPRESSION_FAILED`          |
+ * | ^          | `ERR_COMPRESSION_INVALID_OUTPUT`  |
+ */
+EXPORT_SYM_DYN int64_t aocl_llc_decompress_inplace(aocl_compression_desc *handle,
+                        aocl_compression_type codec_type);
+
 /**
  * @brief Interface API to setup the compression method.
  * 
@@ -220,6 +373,104 @@ EXPORT_SYM_DYN int32_t aocl_llc_setup(aocl_compression_desc *handle,
  */
 EXPORT_SYM_DYN void aocl_llc_destroy(aocl_compression_desc *handle,
                         aocl_compression_type codec_type);
+
+/**
+ * @brief Interface API to train a dictionary from a set of samples.
+ *
+ * Samples are stored back to back in `handle->inBuf` (`handle->inSize` bytes in total).
+ * The dictionary is written to `handle->outBuf` of capacity `handle->outSize`.
+ * It is tuned for compression at `handle->level`. Candidate training parameters
+ * are evaluated on up to `handle->numThreads` threads, within `handle->memLimit`
+ * bytes of memory (0 for no limit).
+ * Only ZSTD supports training. Threads are used when ZSTD is built with the
+ * ZSTD_MULTITHREAD option.
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b handle      | in,out  | This acts as a handle for compression and decompression. For more information, refer to aocl_compression_desc. |
+ * | \b codec_type  | in      | Select the algorithm the dictionary is trained for, choose from aocl_compression_type. |
+ * | \b sampleSizes | in      | Sizes of the samples stored in `handle->inBuf`. |
+ * | \b nbSamples   | in      | Number of samples. |
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    | Size of the dictionary written to `handle->outBuf` |
+ * | Fail       | `ERR_UNSUPPORTED_METHOD`         |
+ * | ^          | `ERR_COMPRESSION_FAILED`         |
+ */
+EXPORT_SYM_DYN int64_t aocl_llc_train_dict(aocl_compression_desc *handle,
+                        aocl_compression_type codec_type,
+                        const size_t *sampleSizes, unsigned int nbSamples);
+/**
+ * @brief Interface API to prepare a dictionary for streams of a compression method.
+ *
+ * The dictionary content is copied and hashed once, so `dictBuf` may be freed after the call.
+ * The result can be attached to the streams of any number of handles with
+ * aocl_llc_reset_stream(), and must outlive them.
+ * For LZ4, only the last 64 KB of the dictionary are used.
+ * Only LZ4 supports dictionaries in streams.
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b codec_type | in      | Select the algorithm the dictionary is prepared for, choose from aocl_compression_type. |
+ * | \b dictBuf    | in      | Dictionary content. |
+ * | \b dictSize   | in      | Size of the dictionary content. |
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    | Dictionary to pass to aocl_llc_reset_stream() and aocl_llc_free_dict() |
+ * | Fail       | `NULL`                                                                  |
+ */
+EXPORT_SYM_DYN aocl_llc_dict *aocl_llc_create_dict(aocl_compression_type codec_type,
+                        const char *dictBuf, size_t dictSize);
+
+/**
+ * @brief Interface API to free a dictionary created by aocl_llc_create_dict().
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b codec_type | in      | Algorithm the dictionary was prepared for. |
+ * | \b dict       | in      | Dictionary to free, `NULL` is ignored. |
+ *
+ * return void
+ */
+EXPORT_SYM_DYN void aocl_llc_free_dict(aocl_compression_type codec_type,
+                        aocl_llc_dict *dict);
+
+/**
+ * @brief Interface API to start a new stream on a handle setup for linked blocks.
+ *
+ * The handle must have been setup with `optVar` = AOCL_LZ4_FORMAT_STREAM.
+ * Successive aocl_llc_compress() calls on the handle then produce linked blocks,
+ * which must be passed to aocl_llc_decompress() on a handle in the same state,
+ * in the same order and with `outSize` of at least the block size.
+ * Setup starts a stream without a dictionary. This call discards the history of the
+ * current stream, so that the next block is independent of the earlier ones.
+ * If `dict` is not `NULL`, the first block of the new stream may reference the
+ * dictionary, and later blocks reference the blocks before them.
+ * The same `dict` must be given when the stream is decompressed.
+ * A failed compression or decompression call leaves the stream unusable
+ * until it is reset.
+ *
+ * | Parameters | Direction   | Description |
+ * |:-----------|:-----------:|:------------|
+ * | \b handle     | in,out  | This acts as a handle for compression and decompression. For more information, refer to aocl_compression_desc. |
+ * | \b codec_type | in      | Select the algorithm of the stream, choose from aocl_compression_type. |
+ * | \b dict       | in      | Dictionary from aocl_llc_create_dict(), or `NULL`. |
+ *
+ * @return
+ * | Result     | Description |
+ * |:-----------|:------------|
+ * | Success    | \b 0                           |
+ * | Fail       | `ERR_UNSUPPORTED_METHOD`       |
+ * | ^          | `ERR_COMPRESSION_FAILED`       |
+ */
+EXPORT_SYM_DYN int32_t aocl_llc_reset_stream(aocl_compression_desc *handle,
+                        aocl_compression_type codec_type,
+                        const aocl_llc_dict *dict);
+
 /**
  * @brief Interface API to get the compression library version string.
  * 
@@ -81,6 +81,93 @@ UINT32 aocl_llc_compress(aocl_compression_desc *handle,
     return ret;
 }
 
+/* Adaptive mode raises the level only when the measured speed beats the
+ * target by this factor, so that it does not oscillate between two levels. */
+#define ADAPT_SPEED_HEADROOM 1.25f
+
+//Level range stepped through by aocl_llc_compress_adaptive()
+static INT32 aocl_adaptive_level_range(aocl_compression_type codec_type,
+                                       UINTP *minLevel, UINTP *maxLevel)
+{
+    switch (codec_type)
+    {
+    case AOCL_LZ4HC:
+        *minLevel = 1;
+        *maxLevel = 12;
+        return 0;
+    case AOCL_ZSTD:
+        *minLevel = 1;
+        *maxLevel = 22;
+        return 0;
+    default:
+        return ERR_UNSUPPORTED_METHOD;
+    }
+}
+
+//Unified API function to compress the input, adapting the level to a target speed
+UINT32 aocl_llc_compress_adaptive(aocl_compression_desc *handle,
+                                  aocl_compression_type codec_type,
+                                  FLOAT32 targetSpeed)
+{
+    UINT32 ret;
+    UINTP minLevel, maxLevel;
+#ifdef WIN32
+    timer clkTick;
+#endif
+    timeVal startTime, endTime;
+
+    LOG_UNFORMATTED(TRACE, enableLogs, "Enter");
+
+    if (aocl_adaptive_level_range(codec_type, &minLevel, &maxLevel) != 0 ||
+        !aocl_codec[codec_type].compress)
+    {
+        LOG_UNFORMATTED(ERR, enableLogs,
+            "adaptive compression failed !! compression method is not supported.");
+        LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+        return ERR_UNSUPPORTED_METHOD;
+    }
+
+    if (handle->level < minLevel)
+        handle->level = minLevel;
+    else if (handle->level > maxLevel)
+        handle->level = maxLevel;
+
+    LOG_FORMATTED(INFO, enableLogs,
+       "Calling compression method: %s at level %zu", aocl_codec[codec_type].codec_name,
+       handle->level);
+    initTimer(clkTick);
+    getTime(startTime);
+
+    ret = aocl_codec[codec_type].compress (handle->inBuf,
+                                          handle->inSize,
+                                          handle->outBuf,
+                                          handle->outSize,
+                                          handle->level,
+                                          handle->optVar,
+                                          handle->workBuf);
+
+    getTime(endTime);
+    handle->cSize = ret;
+    handle->cTime = diffTime(clkTick, startTime, endTime);
+    if (handle->cTime == 0)
+        handle->cTime = 1;
+    handle->cSpeed = (handle->inSize * 1000.0) / handle->cTime;
+
+    /* Failed calls give no usable timing, keep the level unchanged */
+    if (ret > 0 && ret <= handle->outSize)
+    {
+        if (handle->cSpeed < targetSpeed && handle->level > minLevel)
+            handle->level--;
+        else if (handle->cSpeed > targetSpeed * ADAPT_SPEED_HEADROOM &&
+                 handle->level < maxLevel)
+            handle->level++;
+    }
+
+    LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+
+    return ret;
+}
+
 //Unified API function to decompress the input
 UINT32 aocl_llc_decompress(aocl_compression_desc *handle,
                           aocl_compression_type codec_type)
@@ -119,6 +206,61 @@ UINT32 aocl_llc_decompress(aocl_compression_desc *handle,
     return ret;
 }
 
+//API to return the margin required to decompress in place
+INT64 aocl_llc_decompress_margin(aocl_compression_type codec_type,
+                                 UINTP inSize, UINTP outSize)
+{
+    if ((codec_type < AOCL_LZ4) || (codec_type >= AOCL_COMPRESSOR_ALGOS_NUM) ||
+        !aocl_codec[codec_type].decompress_margin)
+        return ERR_UNSUPPORTED_METHOD;
+
+    return aocl_codec[codec_type].decompress_margin(inSize, outSize);
+}
+
+//Unified API function to decompress the input into an overlapping output buffer
+INT64 aocl_llc_decompress_inplace(aocl_compression_desc *handle,
+                                  aocl_compression_type codec_type)
+{
+    INT64 margin;
+    UINTP in, out;
+    UINT32 ret;
+
+    LOG_UNFORMATTED(TRACE, enableLogs, "Enter");
+
+    margin = aocl_llc_decompress_margin(codec_type, handle->inSize,
+                                        handle->outSize);
+    if (margin < 0)
+    {
+        LOG_UNFORMATTED(ERR, enableLogs,
+            "decompress_inplace failed !! compression method does not support in-place decompression.");
+        LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+        return ERR_UNSUPPORTED_METHOD;
+    }
+
+    /* Overlapping input must lie at the end of the output, past the margin,
+     * so that decompression never overwrites input it has not read yet. */
+    in = (UINTP)handle->inBuf;
+    out = (UINTP)handle->outBuf;
+    if (in < out + handle->outSize && in + handle->inSize > out &&
+        (in < out || in + handle->inSize < out + handle->outSize + margin))
+    {
+        LOG_FORMATTED(ERR, enableLogs,
+            "decompress_inplace failed !! input must end %lld bytes past the output.",
+            (long long)margin);
+        LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+        return ERR_COMPRESSION_INVALID_OUTPUT;
+    }
+
+    ret = aocl_llc_decompress(handle, codec_type);
+
+    LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+
+    /* native error codes are larger than any valid decompressed size */
+    if (ret > handle->outSize)
+        return ERR_COMPRESSION_FAILED;
+    return ret;
+}
+
 //API to setup and initialize memory for the compression method
 INT32 aocl_llc_setup(aocl_compression_desc *handle,
                     aocl_compression_type codec_type)
@@ -180,6 +322,108 @@ VOID aocl_llc_destroy(aocl_compression_desc *handle,
     LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
 }
 
+//API to train a dictionary for the compression method
+INT64 aocl_llc_train_dict(aocl_compression_desc *handle,
+                          aocl_compression_type codec_type,
+                          const UINTP *sampleSizes, UINT32 nbSamples)
+{
+    INT64 ret;
+
+    LOG_UNFORMATTED(TRACE, enableLogs, "Enter");
+
+    if ((codec_type < AOCL_LZ4) || (codec_type >= AOCL_COMPRESSOR_ALGOS_NUM) ||
+        !aocl_codec[codec_type].train_dict)
+    {
+        LOG_UNFORMATTED(ERR, enableLogs,
+            "train_dict failed !! compression method does not support dictionary training.");
+        LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+        return ERR_UNSUPPORTED_METHOD;
+    }
+
+    LOG_FORMATTED(INFO, enableLogs,
+       "Calling dictionary training for: %s", aocl_codec[codec_type].codec_name);
+
+    ret = aocl_codec[codec_type].train_dict(handle->inBuf,
+                                            sampleSizes,
+                                            nbSamples,
+                                            handle->outBuf,
+                                            handle->outSize,
+                                            handle->level,
+                                            handle->numThreads,
+                                            handle->memLimit);
+
+    LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+    return ret;
+}
+
+//API to prepare a dictionary shared by the streams of the compression method
+aocl_llc_dict *aocl_llc_create_dict(aocl_compression_type codec_type,
+                                    const CHAR *dictBuf, UINTP dictSize)
+{
+    aocl_llc_dict *dict;
+
+    LOG_UNFORMATTED(TRACE, enableLogs, "Enter");
+
+    if ((codec_type < AOCL_LZ4) || (codec_type >= AOCL_COMPRESSOR_ALGOS_NUM) ||
+        !aocl_codec[codec_type].create_dict)
+    {
+        LOG_UNFORMATTED(ERR, enableLogs,
+            "create_dict failed !! compression method does not support stream dictionaries.");
+        LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+        return NULL;
+    }
+
+    LOG_FORMATTED(INFO, enableLogs,
+       "Calling dictionary creation for: %s", aocl_codec[codec_type].codec_name);
+
+    dict = (aocl_llc_dict *)aocl_codec[codec_type].create_dict(dictBuf, dictSize);
+
+    LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+    return dict;
+}
+
+//API to free a dictionary of the compression method
+VOID aocl_llc_free_dict(aocl_compression_type codec_type, aocl_llc_dict *dict)
+{
+    LOG_UNFORMATTED(TRACE, enableLogs, "Enter");
+
+    if ((codec_type >= AOCL_LZ4) && (codec_type < AOCL_COMPRESSOR_ALGOS_NUM) &&
+        aocl_codec[codec_type].free_dict)
+    {
+        aocl_codec[codec_type].free_dict((CHAR *)dict);
+    }
+
+    LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+}
+
+//API to start a new stream of linked blocks, optionally with a dictionary
+INT32 aocl_llc_reset_stream(aocl_compression_desc *handle,
+                            aocl_compression_type codec_type,
+                            const aocl_llc_dict *dict)
+{
+    LOG_UNFORMATTED(TRACE, enableLogs, "Enter");
+
+    if ((codec_type < AOCL_LZ4) || (codec_type >= AOCL_COMPRESSOR_ALGOS_NUM) ||
+        !aocl_codec[codec_type].reset_stream)
+    {
+        LOG_UNFORMATTED(ERR, enableLogs,
+            "reset_stream failed !! compression method does not support linked blocks.");
+        LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+        return ERR_UNSUPPORTED_METHOD;
+    }
+
+    if (aocl_codec[codec_type].reset_stream(handle->workBuf, (const CHAR *)dict) != 0)
+    {
+        LOG_UNFORMATTED(ERR, enableLogs,
+            "reset_stream failed !! handle is not setup for linked blocks.");
+        LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+        return ERR_COMPRESSION_FAILED;
+    }
+
+    LOG_UNFORMATTED(TRACE, enableLogs, "Exit");
+    return 0;
+}
+
 //API to return the compression library version string
 const CHAR *aocl_llc_version(VOID)
 {
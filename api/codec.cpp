@@ -46,6 +46,9 @@
 #endif
 //lz4
 #ifndef AOCL_EXCLUDE_LZ4
+#include <stdlib.h>
+#include <string.h>
+#define LZ4_STATIC_LINKING_ONLY
 #include "algos/lz4/lz4.h"
 #endif
 //lz4hc
@@ -70,8 +73,11 @@
 //zstd
 #ifndef AOCL_EXCLUDE_ZSTD
 #include <cstdlib>
+#include <cstring>
 #define ZSTD_STATIC_LINKING_ONLY
 #include "algos/zstd/lib/zstd.h"
+#define ZDICT_STATIC_LINKING_ONLY
+#include "algos/zstd/lib/zdict.h"
 #endif
 
 //bzip2
@@ -112,14 +118,135 @@ INT64 aocl_bzip2_decompress(CHAR *inbuf, UINTP insize, CHAR *outbuf,
 
 //lz4
 #ifndef AOCL_EXCLUDE_LZ4
+/* Linked blocks of AOCL_LZ4_FORMAT_STREAM may reference the last
+ * AOCL_LZ4_STREAM_WINDOW bytes of the stream. The caller may reuse its
+ * buffers between calls, so blocks are compressed from and decompressed
+ * against private copies of the stream. A copy slides back to its last
+ * window only when it is full, which keeps the cost of moving history
+ * small next to that of copying the blocks in. */
+#define AOCL_LZ4_STREAM_WINDOW  (64 * 1024)
+#define AOCL_LZ4_STREAM_HISTORY (4 * AOCL_LZ4_STREAM_WINDOW)
+
+/* Both formats keep their state in the work buffer, which starts with the
+ * format it was setup for. AOCL_LZ4_FORMAT_BLOCK only keeps the hash table,
+ * which is reused by every call instead of being initialized on the stack. */
+typedef struct {
+    UINTP optVar;                         /* AOCL_LZ4_FORMAT_BLOCK */
+    LZ4_stream_t cstream;                 /* hash table of the previous blocks */
+} lz4_params_t;
+
+typedef struct {
+    UINTP optVar;                         /* AOCL_LZ4_FORMAT_STREAM */
+    LZ4_stream_t cstream;                 /* hash table of the compressed history */
+    INT32 cpos;                           /* end of the compressed history in chist */
+    INT32 dpos;                           /* end of the decompressed history in dhist */
+    CHAR chist[AOCL_LZ4_STREAM_HISTORY];
+    CHAR dhist[AOCL_LZ4_STREAM_HISTORY];
+} lz4_stream_params_t;
+
+/* Dictionary shared by streams. It is hashed once by LZ4_loadDict() and
+ * attached to a stream without copying its table. */
+typedef struct {
+    LZ4_stream_t stream;
+    INT32 size;
+    CHAR data[AOCL_LZ4_STREAM_WINDOW];
+} lz4_dict_t;
+
 CHAR *aocl_lz4_setup(INTP optOff, INTP optLevel,
-                     UINTP insize, UINTP level, UINTP windowLog)
+                     UINTP insize, UINTP level, UINTP optVar)
 {
+    lz4_stream_params_t *lz4_params;
+
 #ifdef AOCL_DYNAMIC_DISPATCHER
-    return aocl_setup_lz4(optOff, optLevel, insize, level, windowLog);
-#else
-    return NULL;
+    aocl_setup_lz4(optOff, optLevel, insize, level, optVar);
 #endif
+    if (optVar == AOCL_LZ4_FORMAT_BLOCK)
+    {
+        lz4_params_t *lz4_block_params =
+            (lz4_params_t *)malloc(sizeof(lz4_params_t));
+        if (!lz4_block_params)
+            return NULL;
+        lz4_block_params->optVar = optVar;
+        LZ4_initStream(&lz4_block_params->cstream,
+                       sizeof(lz4_block_params->cstream));
+        return (CHAR *)lz4_block_params;
+    }
+    if (optVar != AOCL_LZ4_FORMAT_STREAM)
+        return NULL;
+    lz4_params = (lz4_stream_params_t *)malloc(sizeof(lz4_stream_params_t));
+    if (!lz4_params)
+        return NULL;
+    lz4_params->optVar = optVar;
+    LZ4_initStream(&lz4_params->cstream, sizeof(lz4_params->cstream));
+    lz4_params->cpos = 0;
+    lz4_params->dpos = 0;
+    return (CHAR *)lz4_params;
+}
+
+VOID aocl_lz4_destroy(CHAR *workmem)
+{
+    free(workmem);
+}
+
+static INT32 aocl_lz4_stream_compress(lz4_stream_params_t *lz4_params,
+                                      const CHAR *inbuf, INT32 insize,
+                                      CHAR *outbuf, INT32 outsize)
+{
+    INT32 ret;
+
+    if (insize <= AOCL_LZ4_STREAM_HISTORY - AOCL_LZ4_STREAM_WINDOW)
+    {
+        /* blocks follow each other in chist, so each one is compressed
+         * with the history as its prefix */
+        if (lz4_params->cpos + insize > AOCL_LZ4_STREAM_HISTORY)
+            lz4_params->cpos = LZ4_saveDict(&lz4_params->cstream,
+                                    lz4_params->chist, AOCL_LZ4_STREAM_WINDOW);
+        memcpy(lz4_params->chist + lz4_params->cpos, inbuf, insize);
+        ret = LZ4_compress_fast_continue(&lz4_params->cstream,
+                    lz4_params->chist + lz4_params->cpos, outbuf,
+                    insize, outsize, 1);
+        lz4_params->cpos += insize;
+    }
+    else
+    {
+        /* a block larger than chist is compressed in place, and only its
+         * last window is kept for the next one */
+        ret = LZ4_compress_fast_continue(&lz4_params->cstream, inbuf, outbuf,
+                                         insize, outsize, 1);
+        lz4_params->cpos = LZ4_saveDict(&lz4_params->cstream,
+                                lz4_params->chist, AOCL_LZ4_STREAM_WINDOW);
+    }
+    return ret;
+}
+
+static INT32 aocl_lz4_stream_decompress(lz4_stream_params_t *lz4_params,
+                                        const CHAR *inbuf, INT32 insize,
+                                        CHAR *outbuf, INT32 outsize)
+{
+    INT32 dictSize = lz4_params->dpos < AOCL_LZ4_STREAM_WINDOW ?
+                     lz4_params->dpos : AOCL_LZ4_STREAM_WINDOW;
+    INT32 ret = LZ4_decompress_safe_usingDict(inbuf, outbuf, insize, outsize,
+                    lz4_params->dhist + lz4_params->dpos - dictSize, dictSize);
+
+    if (ret <= 0)
+        return ret;
+    if (ret >= AOCL_LZ4_STREAM_WINDOW)
+    {
+        memcpy(lz4_params->dhist, outbuf + ret - AOCL_LZ4_STREAM_WINDOW,
+               AOCL_LZ4_STREAM_WINDOW);
+        lz4_params->dpos = AOCL_LZ4_STREAM_WINDOW;
+        return ret;
+    }
+    if (lz4_params->dpos + ret > AOCL_LZ4_STREAM_HISTORY)
+    {
+        memmove(lz4_params->dhist,
+                lz4_params->dhist + lz4_params->dpos - AOCL_LZ4_STREAM_WINDOW,
+                AOCL_LZ4_STREAM_WINDOW);
+        lz4_params->dpos = AOCL_LZ4_STREAM_WINDOW;
+    }
+    memcpy(lz4_params->dhist + lz4_params->dpos, outbuf, ret);
+    lz4_params->dpos += ret;
+    return ret;
 }
 
 #if defined(__GNUC__) && defined(__x86_64__)
@@ -128,42 +255,155 @@ CHAR *aocl_lz4_setup(INTP optOff, INTP optLevel,
 __asm__(".p2align 5");
 #endif
 UINT32 aocl_lz4_compress(const CHAR *inbuf, UINTP insize, CHAR *outbuf,
-                        UINTP outsize, UINTP level, UINTP, CHAR *)
+                        UINTP outsize, UINTP level, UINTP optVar, CHAR *workmem)
 {
-    return LZ4_compress_default(inbuf, outbuf, insize, outsize);
+    lz4_params_t *lz4_params = (lz4_params_t *)workmem;
+
+    if (optVar == AOCL_LZ4_FORMAT_BLOCK)
+    {
+        /* the state is cleared lazily, which matters most for small blocks */
+        if (lz4_params && lz4_params->optVar == AOCL_LZ4_FORMAT_BLOCK)
+            return LZ4_compress_fast_extState_fastReset(&lz4_params->cstream,
+                        inbuf, outbuf, insize, outsize, 1);
+        return LZ4_compress_default(inbuf, outbuf, insize, outsize);
+    }
+    if (optVar != AOCL_LZ4_FORMAT_STREAM || !lz4_params ||
+        lz4_params->optVar != AOCL_LZ4_FORMAT_STREAM ||
+        !inbuf || !outbuf || insize > LZ4_MAX_INPUT_SIZE)
+        return 0;
+    return aocl_lz4_stream_compress((lz4_stream_params_t *)workmem,
+                                    inbuf, insize, outbuf, outsize);
 }
 
 UINT32 aocl_lz4_decompress(const CHAR *inbuf, UINTP insize, CHAR *outbuf,
-                          UINTP outsize, UINTP level, UINTP, CHAR *)
+                          UINTP outsize, UINTP level, UINTP optVar, CHAR *workmem)
 {
-    return LZ4_decompress_safe(inbuf, outbuf, insize, outsize);
+    if (optVar == AOCL_LZ4_FORMAT_BLOCK)
+        return LZ4_decompress_safe(inbuf, outbuf, insize, outsize);
+    if (optVar != AOCL_LZ4_FORMAT_STREAM || !workmem || !inbuf || !outbuf ||
+        ((lz4_params_t *)workmem)->optVar != AOCL_LZ4_FORMAT_STREAM)
+        return 0;
+    return aocl_lz4_stream_decompress((lz4_stream_params_t *)workmem,
+                                      inbuf, insize, outbuf, outsize);
+}
+
+CHAR *aocl_lz4_create_dict(const CHAR *dictBuf, UINTP dictSize)
+{
+    lz4_dict_t *lz4_dict;
+
+    if (!dictBuf && dictSize)
+        return NULL;
+    lz4_dict = (lz4_dict_t *)malloc(sizeof(lz4_dict_t));
+    if (!lz4_dict)
+        return NULL;
+    /* blocks can only reference the last window of the dictionary */
+    if (dictSize > AOCL_LZ4_STREAM_WINDOW)
+    {
+        dictBuf += dictSize - AOCL_LZ4_STREAM_WINDOW;
+        dictSize = AOCL_LZ4_STREAM_WINDOW;
+    }
+    lz4_dict->size = (INT32)dictSize;
+    if (dictSize)
+        memcpy(lz4_dict->data, dictBuf, dictSize);
+    LZ4_initStream(&lz4_dict->stream, sizeof(lz4_dict->stream));
+    LZ4_loadDict(&lz4_dict->stream, lz4_dict->data, lz4_dict->size);
+    return (CHAR *)lz4_dict;
+}
+
+VOID aocl_lz4_free_dict(CHAR *dict)
+{
+    free(dict);
+}
+
+INT32 aocl_lz4_reset_stream(CHAR *workmem, const CHAR *dict)
+{
+    lz4_stream_params_t *lz4_params = (lz4_stream_params_t *)workmem;
+    const lz4_dict_t *lz4_dict = (const lz4_dict_t *)dict;
+
+    if (!lz4_params || lz4_params->optVar != AOCL_LZ4_FORMAT_STREAM)
+        return -1;
+    LZ4_resetStream_fast(&lz4_params->cstream);
+    lz4_params->cpos = 0;
+    lz4_params->dpos = 0;
+    if (lz4_dict)
+    {
+        /* the first block is compressed against the dictionary tables,
+         * and decompressed against a copy of its content */
+        LZ4_attach_dictionary(&lz4_params->cstream, &lz4_dict->stream);
+        memcpy(lz4_params->dhist, lz4_dict->data, lz4_dict->size);
+        lz4_params->dpos = lz4_dict->size;
+    }
+    return 0;
+}
+
+INT64 aocl_lz4_decompress_margin(UINTP insize, UINTP)
+{
+    return LZ4_DECOMPRESS_INPLACE_MARGIN(insize);
 }
 #endif
 
 
 //lz4hc
 #if !defined(AOCL_EXCLUDE_LZ4HC) && !defined(AOCL_EXCLUDE_LZ4)
+/* State kept across calls, with its hash table sized at setup for the
+ * expected input size, so that small inputs only clear and touch the part
+ * of the state they need */
+typedef struct {
+    LZ4_streamHC_t state;
+    UINTP insize;   /* input size hashLog was chosen for, 0 if unknown */
+    INT32 hashLog;
+} lz4hc_params_t;
+
 CHAR *aocl_lz4hc_setup(INTP optOff, INTP optLevel,
                        UINTP insize, UINTP level, UINTP windowLog)
 {
+    lz4hc_params_t *lz4hc_params;
+
 #ifdef AOCL_DYNAMIC_DISPATCHER
-    return aocl_setup_lz4hc(optOff, optLevel, insize, level, windowLog);
-#else
-    return NULL;
+    aocl_setup_lz4hc(optOff, optLevel, insize, level, windowLog);
 #endif
+    lz4hc_params = (lz4hc_params_t *)malloc(sizeof(lz4hc_params_t));
+    if (!lz4hc_params)
+        return NULL;
+    lz4hc_params->insize = (insize > LZ4_MAX_INPUT_SIZE) ? 0 : insize;
+    lz4hc_params->hashLog = AOCL_LZ4HC_hashLogForSize((int)lz4hc_params->insize);
+    return (CHAR *)lz4hc_params;
 }
 
-INT64 aocl_lz4hc_compress(CHAR *inbuf, UINTP insize, CHAR *outbuf,
-                          UINTP outsize, UINTP level, UINTP, CHAR *)
+VOID aocl_lz4hc_destroy(CHAR *workmem)
 {
-    return LZ4_compress_HC(inbuf, outbuf, insize, outsize, level);
+    free(workmem);
 }
 
-INT64 aocl_lz4hc_decompress(CHAR *inbuf, UINTP insize, CHAR *outbuf,
+UINT32 aocl_lz4hc_compress(const CHAR *inbuf, UINTP insize, CHAR *outbuf,
+                          UINTP outsize, UINTP level, UINTP, CHAR *workmem)
+{
+    lz4hc_params_t *lz4hc_params = (lz4hc_params_t *)workmem;
+    INT32 hashLog;
+
+    if (!lz4hc_params)
+        return LZ4_compress_HC(inbuf, outbuf, insize, outsize, level);
+
+    /* an input larger than the one planned for at setup gets the table
+     * its own size calls for */
+    hashLog = lz4hc_params->hashLog;
+    if (lz4hc_params->insize && insize > lz4hc_params->insize)
+        hashLog = AOCL_LZ4HC_hashLogForSize(
+            (insize > LZ4_MAX_INPUT_SIZE) ? 0 : (int)insize);
+    return AOCL_LZ4_compress_HC_extStateHC_sized(&lz4hc_params->state,
+                inbuf, outbuf, insize, outsize, level, hashLog);
+}
+
+UINT32 aocl_lz4hc_decompress(const CHAR *inbuf, UINTP insize, CHAR *outbuf,
 							UINTP outsize, UINTP, UINTP, CHAR *)
 {
     return LZ4_decompress_safe(inbuf, outbuf, insize, outsize);
 }
+
+INT64 aocl_lz4hc_decompress_margin(UINTP insize, UINTP)
+{
+    return LZ4_DECOMPRESS_INPLACE_MARGIN(insize);
+}
 #endif
 
 
@@ -231,18 +471,25 @@ CHAR *aocl_snappy_setup(INTP optOff, INTP optLevel,
 #endif
 }
 
-INT64 aocl_snappy_compress(CHAR *inbuf, UINTP insize, CHAR *outbuf, 
-						   UINTP outsize, UINTP, UINTP, CHAR *)
+UINT32 aocl_snappy_compress(const CHAR *inbuf, UINTP insize, CHAR *outbuf,
+                            UINTP outsize, UINTP, UINTP, CHAR *)
 {
     snappy::RawCompress(inbuf, insize, outbuf, &outsize);
     return outsize;
 }
 
-INT64 aocl_snappy_decompress(CHAR *inbuf, UINTP insize, CHAR *outbuf, 
-							 UINTP outsize, UINTP, UINTP, CHAR *)
+UINT32 aocl_snappy_decompress(const CHAR *inbuf, UINTP insize, CHAR *outbuf,
+                              UINTP outsize, UINTP, UINTP optVar, CHAR *)
 {
-    snappy::RawUncompress(inbuf, insize, outbuf);
-    return outsize;
+    size_t dsize;
+
+    if (optVar > AOCL_SNAPPY_DECOMPRESS_VALIDATE)
+        return 0;
+    /* the input may be untrusted, and the output a fixed size buffer */
+    if (!snappy::AOCL_RawUncompressSafe(inbuf, insize, outbuf, outsize, &dsize,
+                                        optVar == AOCL_SNAPPY_DECOMPRESS_VALIDATE))
+        return 0;
+    return dsize;
 }
 #endif
 
@@ -258,25 +505,132 @@ CHAR *aocl_zlib_setup(INTP optOff, INTP optLevel,
 #endif
 }
 
-INT64 aocl_zlib_compress(CHAR *inbuf, UINTP insize, CHAR *outbuf,
-                         UINTP outsize, UINTP level, UINTP, CHAR *)
+/* Splits the optVar of the zlib method, packed by AOCL_ZLIB_OPT_VAR(), into
+ * the windowBits, memLevel and strategy arguments of deflateInit2(). The
+ * returned windowBits carries the stream format as in deflateInit2(). */
+static INTP aocl_zlib_params(UINTP optVar, INTP *windowBits, INTP *memLevel,
+                             INTP *strategy)
+{
+    UINTP format = optVar & 0x3;
+    INTP wbits = (optVar >> 2) & 0xF;
+    INTP mlevel = (optVar >> 6) & 0xF;
+
+    *strategy = (optVar >> 10) & 0x7;
+    if ((optVar >> 13) != 0 || *strategy > Z_FIXED)
+        return -1;
+    if (wbits == 0)
+        wbits = MAX_WBITS;
+    if (wbits < 9)
+        return -1;
+    if (mlevel == 0)
+        mlevel = 8;
+    if (mlevel > MAX_MEM_LEVEL)
+        return -1;
+    *memLevel = mlevel;
+
+    switch (format)
+    {
+    case AOCL_ZLIB_FORMAT_ZLIB:
+        *windowBits = wbits;
+        break;
+    case AOCL_ZLIB_FORMAT_GZIP:
+        *windowBits = wbits + 16;
+        break;
+    case AOCL_ZLIB_FORMAT_RAW:
+        *windowBits = -wbits;
+        break;
+    default:
+        return -1;
+    }
+    return 0;
+}
+
+UINT32 aocl_zlib_compress(const CHAR *inbuf, UINTP insize, CHAR *outbuf,
+                          UINTP outsize, UINTP level, UINTP optVar, CHAR *)
 {
-    uLongf zencLen = outsize;
-    INTP res = compress2((UINT8 *)outbuf, &zencLen, 
-                         (UINT8 *)inbuf, insize, level);
+    z_stream strm;
+    INTP windowBits, memLevel, strategy;
+    INTP res;
+
+    if (aocl_zlib_params(optVar, &windowBits, &memLevel, &strategy) != 0)
+        return 0;
+
+    /* deflate straight into outbuf: the wrapper and its check value are
+     * produced in the same pass, as compress2() does for the zlib format */
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = (z_const Bytef *)inbuf;
+    strm.avail_in = 0;
+    res = deflateInit2(&strm, (INTP)level, Z_DEFLATED, windowBits, memLevel,
+                       strategy);
     if (res != Z_OK)
         return 0;
-    return zencLen;
+
+    strm.next_out = (Bytef *)outbuf;
+    strm.avail_out = 0;
+    do {
+        const uInt max = (uInt)-1;
+        if (strm.avail_out == 0) {
+            strm.avail_out = outsize > max ? max : (uInt)outsize;
+            outsize -= strm.avail_out;
+        }
+        if (strm.avail_in == 0) {
+            strm.avail_in = insize > max ? max : (uInt)insize;
+            insize -= strm.avail_in;
+        }
+        res = deflate(&strm, insize ? Z_NO_FLUSH : Z_FINISH);
+    } while (res == Z_OK && (strm.avail_out != 0 || outsize != 0));
+    deflateEnd(&strm);
+
+    if (res != Z_STREAM_END)
+        return 0;
+    return strm.total_out;
 }
 
-INT64 aocl_zlib_decompress(CHAR *inbuf, UINTP insize, CHAR *outbuf, 
-						   UINTP outsize, UINTP, UINTP, CHAR *)
+UINT32 aocl_zlib_decompress(const CHAR *inbuf, UINTP insize, CHAR *outbuf,
+                            UINTP outsize, UINTP, UINTP optVar, CHAR *)
 {
-    uLongf zdecLen = outsize;
-    INTP res = uncompress((UINT8*)outbuf, &zdecLen, (UINT8 *)inbuf, insize);
+    z_stream strm;
+    INTP windowBits, memLevel, strategy;
+    INTP res;
+
+    if (aocl_zlib_params(optVar, &windowBits, &memLevel, &strategy) != 0)
+        return 0;
+
+    /* the largest window decodes streams written with any smaller one */
+    windowBits = windowBits < 0 ? -MAX_WBITS :
+                 (windowBits > MAX_WBITS ? MAX_WBITS + 16 : MAX_WBITS);
+
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = (z_const Bytef *)inbuf;
+    strm.avail_in = 0;
+    res = inflateInit2(&strm, windowBits);
     if (res != Z_OK)
         return 0;
-    return zdecLen;
+
+    strm.next_out = (Bytef *)outbuf;
+    strm.avail_out = 0;
+    do {
+        const uInt max = (uInt)-1;
+        if (strm.avail_out == 0) {
+            strm.avail_out = outsize > max ? max : (uInt)outsize;
+            outsize -= strm.avail_out;
+        }
+        if (strm.avail_in == 0) {
+            strm.avail_in = insize > max ? max : (uInt)insize;
+            insize -= strm.avail_in;
+        }
+        res = inflate(&strm, Z_NO_FLUSH);
+    } while (res == Z_OK && (strm.avail_out != 0 || outsize != 0) &&
+             (strm.avail_in != 0 || insize != 0));
+    inflateEnd(&strm);
+
+    if (res != Z_STREAM_END)
+        return 0;
+    return strm.total_out;
 }
 #endif
 
@@ -287,9 +641,28 @@ typedef struct {
     ZSTD_CCtx *cctx;
     ZSTD_DCtx *dctx;
     ZSTD_CDict *cdict;
-    ZSTD_parameters zparams;
     ZSTD_customMem cmem;
+    /* Key for which the parameters of cctx were applied.
+     * sizeClass 0 means they are not applied yet. */
+    UINTP level;
+    UINTP windowLog;
+    UINT32 sizeClass;
 } zstd_params_t;
+
+/* Parameters returned by ZSTD_getParams() depend only on the level and
+ * on ceil(log2(insize)): parameter tables switch at 16 KB, 128 KB and
+ * 256 KB and window/table sizes are trimmed to the next power of 2 of
+ * insize. Map insize to such a class. 1 is used for unknown (0) size. */
+static UINT32 aocl_zstd_size_class(UINTP insize)
+{
+    UINT32 sizeLog = 0;
+    if (insize == 0)
+        return 1;
+    while (sizeLog < 31 && ((UINTP)1 << sizeLog) < insize)
+        sizeLog++;
+    return sizeLog + 2;
+}
+
 CHAR *aocl_zstd_setup(INTP optOff, INTP optLevel,
                       UINTP insize, UINTP level, UINTP windowLog)
 {
@@ -305,6 +678,9 @@ CHAR *aocl_zstd_setup(INTP optOff, INTP optLevel,
     zstd_params->cctx = ZSTD_createCCtx();
     zstd_params->dctx = ZSTD_createDCtx();
     zstd_params->cdict = NULL;
+    zstd_params->level = 0;
+    zstd_params->windowLog = 0;
+    zstd_params->sizeClass = 0;
 
     return (CHAR*) zstd_params;
 }
@@ -323,33 +699,64 @@ VOID aocl_zstd_destroy(CHAR *workmem)
     free(workmem);
 }
 
-INT64 aocl_zstd_compress(CHAR *inbuf, UINTP insize, CHAR *outbuf,
-                         UINTP outsize, UINTP level, UINTP windowLog,
-                         CHAR *workmem)
+/* Apply to cctx the parameters ZSTD_getParams() derives for level and
+ * insize, with the window limited to windowLog. They stay set on cctx
+ * for the following ZSTD_compress2() calls. */
+static UINTP aocl_zstd_apply_params(ZSTD_CCtx *cctx, UINTP insize,
+                                    UINTP level, UINTP windowLog)
+{
+    ZSTD_parameters zparams = ZSTD_getParams(level, insize, 0);
+    UINTP res;
+
+    if (windowLog && zparams.cParams.windowLog > windowLog) {
+        zparams.cParams.windowLog = windowLog;
+        zparams.cParams.chainLog = windowLog + 
+            ((zparams.cParams.strategy == ZSTD_btlazy2) || 
+            (zparams.cParams.strategy == ZSTD_btopt) || 
+            (zparams.cParams.strategy == ZSTD_btultra));
+    }
+
+    res = ZSTD_CCtx_reset(cctx, ZSTD_reset_parameters);
+    if (ZSTD_isError(res))
+        return res;
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, zparams.cParams.windowLog);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_chainLog, zparams.cParams.chainLog);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_hashLog, zparams.cParams.hashLog);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_searchLog, zparams.cParams.searchLog);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_minMatch, zparams.cParams.minMatch);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_targetLength, zparams.cParams.targetLength);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_strategy, zparams.cParams.strategy);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_contentSizeFlag, 1);
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, zparams.fParams.checksumFlag);
+    return ZSTD_CCtx_setParameter(cctx, ZSTD_c_dictIDFlag, !zparams.fParams.noDictIDFlag);
+}
+
+UINT32 aocl_zstd_compress(const CHAR *inbuf, UINTP insize, CHAR *outbuf,
+                          UINTP outsize, UINTP level, UINTP windowLog,
+                          CHAR *workmem)
 {
     UINTP res;
+    UINT32 sizeClass;
     zstd_params_t *zstd_params = (zstd_params_t *) workmem;
     
     if (!zstd_params || !zstd_params->cctx)
         return 0;
 
-    zstd_params->zparams = ZSTD_getParams(level, insize, 0);
-    ZSTD_CCtx_setParameter(zstd_params->cctx, ZSTD_c_compressionLevel, level);
-    zstd_params->zparams.fParams.contentSizeFlag = 1;
-
-    if (windowLog && zstd_params->zparams.cParams.windowLog > windowLog) {
-        zstd_params->zparams.cParams.windowLog = windowLog;
-        zstd_params->zparams.cParams.chainLog = windowLog + 
-			((zstd_params->zparams.cParams.strategy == ZSTD_btlazy2) || 
-			(zstd_params->zparams.cParams.strategy == ZSTD_btopt) || 
-			(zstd_params->zparams.cParams.strategy == ZSTD_btultra));
+    /* The parameters stay applied on cctx across calls. Re-apply them only
+     * when level, windowLog or the size class of the input changes. */
+    sizeClass = aocl_zstd_size_class(insize);
+    if (zstd_params->sizeClass != sizeClass ||
+        zstd_params->level != level || zstd_params->windowLog != windowLog)
+    {
+        res = aocl_zstd_apply_params(zstd_params->cctx, insize, level, windowLog);
+        if (ZSTD_isError(res))
+            return res;
+        zstd_params->level = level;
+        zstd_params->windowLog = windowLog;
+        zstd_params->sizeClass = sizeClass;
     }
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-    res = ZSTD_compress_advanced(zstd_params->cctx, outbuf, outsize, inbuf, 
-                                insize, NULL, 0, zstd_params->zparams);
-#pragma GCC diagnostic pop
+    res = ZSTD_compress2(zstd_params->cctx, outbuf, outsize, inbuf, insize);
 
     if (ZSTD_isError(res))
         return res;
@@ -357,8 +764,8 @@ INT64 aocl_zstd_compress(CHAR *inbuf, UINTP insize, CHAR *outbuf,
     return res;
 }
 
-INT64 aocl_zstd_decompress(CHAR *inbuf, UINTP insize, CHAR *outbuf, 
-						   UINTP outsize, UINTP, UINTP, CHAR *workmem)
+UINT32 aocl_zstd_decompress(const CHAR *inbuf, UINTP insize, CHAR *outbuf, 
+						    UINTP outsize, UINTP, UINTP, CHAR *workmem)
 {
     zstd_params_t *zstd_params = (zstd_params_t *) workmem;
     if (!zstd_params || !zstd_params->dctx)
@@ -367,4 +774,34 @@ INT64 aocl_zstd_decompress(CHAR *inbuf, UINTP insize, CHAR *outbuf,
     return ZSTD_decompressDCtx(zstd_params->dctx, outbuf, outsize, 
                                inbuf, insize);
 }
+
+INT64 aocl_zstd_decompress_margin(UINTP, UINTP outsize)
+{
+    /* frames of up to one block use a block size of their content size */
+    UINTP blockSize = (outsize < ZSTD_BLOCKSIZE_MAX) ? outsize : ZSTD_BLOCKSIZE_MAX;
+    return ZSTD_DECOMPRESSION_MARGIN(outsize, blockSize);
+}
+
+INT64 aocl_zstd_train_dict(const CHAR *samples, const UINTP *sampleSizes,
+                           UINT32 nbSamples, CHAR *dictBuf, UINTP dictCapacity,
+                           UINTP level, INTP numThreads, UINTP memLimit)
+{
+    ZDICT_fastCover_params_t params;
+    UINTP res;
+
+    if (!samples || !sampleSizes || !dictBuf)
+        return ERR_COMPRESSION_FAILED;
+
+    memset(&params, 0, sizeof(params));
+    params.nbThreads = (numThreads > 1) ? (unsigned)numThreads : 1;
+    params.zParams.compressionLevel = (int)level;
+
+    res = ZDICT_optimizeTrainFromBuffer_fastCover_memLimit(dictBuf,
+                dictCapacity, samples, sampleSizes, nbSamples, &params,
+                memLimit);
+    if (ZDICT_isError(res))
+        return ERR_COMPRESSION_FAILED;
+
+    return res;
+}
 #endif
@@ -45,6 +45,12 @@ typedef UINT32 (*comp_decomp_fp)(const CHAR *inStream, UINTP inSize, CHAR *outSt
 typedef CHAR* (*setup_fp)(INTP optOff, INTP optLevel, UINTP inSize, UINTP,
                           UINTP);
 typedef VOID  (*destroy_fp)(CHAR *memBuff);
+typedef INT64 (*train_fp)(const CHAR *samples, const UINTP *sampleSizes,
+                          UINT32 nbSamples, CHAR *dictBuff, UINTP dictCapacity,
+                          UINTP level, INTP numThreads, UINTP memLimit);
+typedef CHAR* (*dict_create_fp)(const CHAR *dictBuff, UINTP dictSize);
+typedef INT32 (*reset_fp)(CHAR *memBuff, const CHAR *dict);
+typedef INT64 (*margin_fp)(UINTP inSize, UINTP outSize);
 
 //Method 1
 #ifndef AOCL_EXCLUDE_BZIP2
@@ -66,11 +72,21 @@ typedef VOID  (*destroy_fp)(CHAR *memBuff);
         UINT32 aocl_lz4_decompress(const CHAR *inBuf, UINTP inSize, CHAR *outBuf, 
                          UINTP outSize, UINTP level, UINTP optVar, CHAR *workBuf);
         CHAR *aocl_lz4_setup(INTP optOff, INTP optLevel,
-                         UINTP insize, UINTP level, UINTP windowLog);
+                         UINTP insize, UINTP level, UINTP optVar);
+        VOID aocl_lz4_destroy(CHAR *workmem);
+        CHAR *aocl_lz4_create_dict(const CHAR *dictBuf, UINTP dictSize);
+        VOID aocl_lz4_free_dict(CHAR *dict);
+        INT32 aocl_lz4_reset_stream(CHAR *workmem, const CHAR *dict);
+        INT64 aocl_lz4_decompress_margin(UINTP inSize, UINTP outSize);
 #else
 	#define aocl_lz4_compress NULL
 	#define aocl_lz4_decompress NULL
         #define aocl_lz4_setup NULL
+        #define aocl_lz4_destroy NULL
+        #define aocl_lz4_create_dict NULL
+        #define aocl_lz4_free_dict NULL
+        #define aocl_lz4_reset_stream NULL
+        #define aocl_lz4_decompress_margin NULL
 #endif
 //Method 3
 #if !defined(AOCL_EXCLUDE_LZ4HC) && !defined(AOCL_EXCLUDE_LZ4)
@@ -80,10 +96,14 @@ typedef VOID  (*destroy_fp)(CHAR *memBuff);
                          UINTP outSize, UINTP level, UINTP optVar, CHAR *workBuf);
         CHAR *aocl_lz4hc_setup(INTP optOff, INTP optLevel,
                          UINTP insize, UINTP level, UINTP windowLog);
+        VOID aocl_lz4hc_destroy(CHAR *workmem);
+        INT64 aocl_lz4hc_decompress_margin(UINTP inSize, UINTP outSize);
 #else
 	#define aocl_lz4hc_compress NULL
 	#define aocl_lz4hc_decompress NULL
         #define aocl_lz4hc_setup NULL
+        #define aocl_lz4hc_destroy NULL
+        #define aocl_lz4hc_decompress_margin NULL
 #endif
 //Method 4
 #ifndef AOCL_EXCLUDE_LZMA
@@ -133,11 +153,17 @@ typedef VOID  (*destroy_fp)(CHAR *memBuff);
         CHAR *aocl_zstd_setup(INTP optOff, INTP optLevel,
                          UINTP insize, UINTP level, UINTP windowLog);
         VOID aocl_zstd_destroy(CHAR *workmem);
+        INT64 aocl_zstd_train_dict(const CHAR *samples, const UINTP *sampleSizes,
+                         UINT32 nbSamples, CHAR *dictBuf, UINTP dictCapacity,
+                         UINTP level, INTP numThreads, UINTP memLimit);
+        INT64 aocl_zstd_decompress_margin(UINTP inSize, UINTP outSize);
 #else
 	#define aocl_zstd_compress NULL
 	#define aocl_zstd_decompress NULL
 	#define aocl_zstd_setup NULL
 	#define aocl_zstd_destroy NULL
+	#define aocl_zstd_train_dict NULL
+	#define aocl_zstd_decompress_margin NULL
 #endif
 
 typedef struct
@@ -148,17 +174,22 @@ typedef struct
     comp_decomp_fp decompress;
     setup_fp setup;
     destroy_fp destroy;
+    train_fp train_dict;
+    dict_create_fp create_dict;
+    destroy_fp free_dict;
+    reset_fp reset_stream;
+    margin_fp decompress_margin;
 } aocl_codec_t;
 
 static const aocl_codec_t aocl_codec[AOCL_COMPRESSOR_ALGOS_NUM] =
 {
-    { "lz4",    "1.9.3",      aocl_lz4_compress,    aocl_lz4_decompress,    aocl_lz4_setup,    NULL },
-    { "lz4hc",  "1.9.3",      aocl_lz4hc_compress,  aocl_lz4_decompress,    aocl_lz4hc_setup,  NULL },
-    { "lzma",   "22.01",      aocl_lzma_compress,   aocl_lzma_decompress,   aocl_lzma_setup,   NULL },
-    { "bzip2",  "1.0.8",      aocl_bzip2_compress,  aocl_bzip2_decompress,  aocl_bzip2_setup,  NULL },
-    { "snappy", "2020-07-11", aocl_snappy_compress, aocl_snappy_decompress, aocl_snappy_setup, NULL },
-    { "zlib",   "1.2.11",     aocl_zlib_compress,   aocl_zlib_decompress,   aocl_zlib_setup,   NULL },
-    { "zstd",   "1.5.0",      aocl_zstd_compress,   aocl_zstd_decompress,   aocl_zstd_setup,   aocl_zstd_destroy }
+    { "lz4",    "1.9.3",      aocl_lz4_compress,    aocl_lz4_decompress,    aocl_lz4_setup,    aocl_lz4_destroy,   NULL,                 aocl_lz4_create_dict, aocl_lz4_free_dict, aocl_lz4_reset_stream, aocl_lz4_decompress_margin },
+    { "lz4hc",  "1.9.3",      aocl_lz4hc_compress,  aocl_lz4hc_decompress,  aocl_lz4hc_setup,  aocl_lz4hc_destroy, NULL,                 NULL,                 NULL,               NULL,                 aocl_lz4hc_decompress_margin },
+    { "lzma",   "22.01",      aocl_lzma_compress,   aocl_lzma_decompress,   aocl_lzma_setup,   NULL,               NULL,                 NULL,                 NULL,               NULL,                 NULL },
+    { "bzip2",  "1.0.8",      aocl_bzip2_compress,  aocl_bzip2_decompress,  aocl_bzip2_setup,  NULL,               NULL,                 NULL,                 NULL,               NULL,                 NULL },
+    { "snappy", "2020-07-11", aocl_snappy_compress, aocl_snappy_decompress, aocl_snappy_setup, NULL,               NULL,                 NULL,                 NULL,               NULL,                 NULL },
+    { "zlib",   "1.2.11",     aocl_zlib_compress,   aocl_zlib_decompress,   aocl_zlib_setup,   NULL,               NULL,                 NULL,                 NULL,               NULL,                 NULL },
+    { "zstd",   "1.5.0",      aocl_zstd_compress,   aocl_zstd_decompress,   aocl_zstd_setup,   aocl_zstd_destroy,  aocl_zstd_train_dict, NULL,                 NULL,               NULL,                 aocl_zstd_decompress_margin }
 };
 
 #endif
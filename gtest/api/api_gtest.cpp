@@ -276,6 +276,62 @@ void set_ACD_io_bufs(ACD* desc, TestLoadBase* t) {
     desc->outSize = t->getOutSize();
 }
 
+/*
+    Base fixture for the tests of a single method.
+    src is filled with data that compresses well, dst receives the compressed
+    data and rt the decompressed data. rtSize defaults to the size of src.
+*/
+class API_method : public ::testing::Test {
+public:
+    API_method(ACT algo, size_t srcSize, size_t rtSize = 0)
+        : algo(algo), src(srcSize), dst(srcSize + srcSize / 4 + 1024),
+          rt(rtSize ? rtSize : srcSize) {}
+
+    void SetUp() override {
+        for (size_t i = 0; i < src.size(); ++i)
+            src[i] = "abcdefgh"[rand() % 8];
+        reset_ACD(&desc, algo_levels[algo].def);
+    }
+
+    void TearDown() override {
+        aocl_llc_destroy(&desc, algo);
+    }
+
+    //compresses the first size bytes of src into dst
+    int64_t compress(size_t optVar, size_t size) {
+        desc.optVar = optVar;
+        desc.inBuf = &src[0];
+        desc.inSize = size;
+        desc.outBuf = &dst[0];
+        desc.outSize = dst.size();
+        return aocl_llc_compress(&desc, algo);
+    }
+
+    //decompresses the first inSize bytes of dst into the first outSize bytes of rt
+    int64_t decompress(size_t optVar, size_t inSize, size_t outSize) {
+        desc.optVar = optVar;
+        desc.inBuf = &dst[0];
+        desc.inSize = inSize;
+        desc.outBuf = &rt[0];
+        desc.outSize = outSize;
+        return aocl_llc_decompress(&desc, algo);
+    }
+
+    //compresses the first size bytes of src and checks that they decompress
+    void roundtrip(size_t optVar, size_t size) {
+        int64_t cSize = compress(optVar, size);
+        ASSERT_GT(cSize, 0);
+        EXPECT_EQ(decompress(optVar, cSize, rt.size()), (int64_t)size);
+        EXPECT_EQ(memcmp(&src[0], &rt[0], size), 0);
+    }
+
+    ACT algo;
+    std::vector<char> src;
+    std::vector<char> dst;
+    std::vector<char> rt;
+    ACD desc;
+};
+
 /*********************************************
  * Begin Version Tests
  *********************************************/
@@ -298,6 +354,8 @@ public:
     void setup_and_validate() {
         EXPECT_NO_THROW(aocl_llc_setup(&desc, algo));
         switch (algo) {
+        case LZ4: //lz4 keeps its block state
+        case LZ4HC: //lz4hc saves its state
         case ZSTD:
             EXPECT_NE(desc.workBuf, nullptr);  //ztd saves params and context 
             break;
@@ -435,6 +493,8 @@ public:
     void setup() {
         ASSERT_NO_THROW(aocl_llc_setup(&desc, algo));
         switch (algo) {
+        case LZ4: //lz4 keeps its block state
+        case LZ4HC: //lz4hc saves its state
         case ZSTD:
             ASSERT_NE(desc.workBuf, nullptr); //ztd saves params and context 
             break;
@@ -479,7 +539,7 @@ public:
     }
 
     ACT algo;
-    ACD desc;
+    ACD desc = {};  //single level methods run no test in the levels loops
 };
 
 TEST_P(API_compress, AOCL_Compression_api_aocl_llc_compress_defaultOptOn_common_1) //default optOn
@@ -697,6 +757,8 @@ public:
         //setup
         ASSERT_NO_THROW(aocl_llc_setup(&desc, algo));
         switch (algo) {
+        case LZ4: //lz4 keeps its block state
+        case LZ4HC: //lz4hc saves its state
         case ZSTD:
             ASSERT_NE(desc.workBuf, nullptr); //ztd saves params and context 
             break;
@@ -770,15 +832,7 @@ TEST_P(API_decompress, AOCL_Compression_api_aocl_llc_decompress_inpNull_common_1
     desc.outBuf  = dpr->getOutData();
     desc.outSize = dpr->getOutSize();
     int64_t dSize = aocl_llc_decompress(&desc, algo);
-
-    switch (algo) {
-    case SNAPPY:
-        EXPECT_GT(dSize, 0); //snappy does not return error code
-        break;
-    default:
-        EXPECT_LE(dSize, 0); //decompress failed
-        break;
-    }
+    EXPECT_LE(dSize, 0); //decompress failed
 }
 
 TEST_P(API_decompress, AOCL_Compression_api_aocl_llc_decompress_inpSzZero_common_1) //inp size = 0
@@ -796,15 +850,7 @@ TEST_P(API_decompress, AOCL_Compression_api_aocl_llc_decompress_inpSzZero_common
     desc.outBuf  = dpr->getOutData();
     desc.outSize = dpr->getOutSize();
     int64_t dSize = aocl_llc_decompress(&desc, algo);
-
-    switch (algo) {
-    case SNAPPY:
-        EXPECT_GT(dSize, 0); //snappy does not return error code
-        break;
-    default:
-        EXPECT_LE(dSize, 0); //decompress failed
-        break;
-    }
+    EXPECT_LE(dSize, 0); //decompress failed
 }
 
 TEST_P(API_decompress, AOCL_Compression_api_aocl_llc_decompress_outNull_common_1) //out NULL
@@ -822,15 +868,7 @@ TEST_P(API_decompress, AOCL_Compression_api_aocl_llc_decompress_outNull_common_1
     desc.outBuf  = nullptr;
     desc.outSize = dpr->getOutSize();
     int64_t dSize = aocl_llc_decompress(&desc, algo);
-
-    switch (algo) {
-    case SNAPPY:
-        EXPECT_GT(dSize, 0); //snappy does not return error code
-        break;
-    default:
-        EXPECT_LE(dSize, 0); //decompress failed
-        break;
-    }
+    EXPECT_LE(dSize, 0); //decompress failed
 }
 
 TEST_P(API_decompress, AOCL_Compression_api_aocl_llc_decompress_outSzZero_common_1) //out size = 0
@@ -885,3 +923,747 @@ INSTANTIATE_TEST_SUITE_P(
 /*********************************************
  * End Decompress Tests
  ********************************************/
+
+/*********************************************
+  * Begin Train Dictionary Tests
+ *********************************************/
+class API_train_dict : public ::testing::TestWithParam<ACT> {
+public:
+    void SetUp() override {
+        algo = GetParam();
+        // Samples are records built from a small vocabulary, like log lines.
+        static const char* words[] = { "time=", "level=INFO ", "level=WARN ",
+            "tenant=", "id=", "latency=", "status=200 ", "path=/api/v1/items " };
+        const size_t nbWords = sizeof(words) / sizeof(words[0]);
+        samples.resize(nbSamples * 512);
+        for (unsigned i = 0; i < nbSamples; ++i) {
+            size_t len = 0;
+            while (len < 300) {
+                const char* w = words[rand() % nbWords];
+                memcpy(&samples[samplesLen + len], w, strlen(w));
+                len += strlen(w);
+                len += snprintf(&samples[samplesLen + len], 16, "%d ", rand() % 1000);
+            }
+            sampleSizes[i] = len;
+            samplesLen += len;
+        }
+    }
+
+    int64_t train_dict() {
+        desc.inBuf = samples.data();
+        desc.inSize = samplesLen;
+        desc.outBuf = dict;
+        desc.outSize = sizeof(dict);
+        return aocl_llc_train_dict(&desc, algo, sampleSizes, nbSamples);
+    }
+
+    static const unsigned nbSamples = 200;
+    vector<char> samples;
+    size_t sampleSizes[nbSamples];
+    size_t samplesLen = 0;
+    char dict[8 * 1024];
+    ACT algo;
+    ACD desc;
+};
+
+TEST_P(API_train_dict, AOCL_Compression_api_aocl_llc_train_dict_default_common_1) //default
+{
+    skip_test_if_algo_invalid(algo)
+    reset_ACD(&desc, algo_levels[algo].def);
+    int64_t dictSize = train_dict();
+    if (algo == ZSTD) {
+        EXPECT_GT(dictSize, 0);
+        EXPECT_LE(dictSize, (int64_t)sizeof(dict));
+    }
+    else {
+        EXPECT_EQ(dictSize, ERR_UNSUPPORTED_METHOD);
+    }
+}
+
+TEST_P(API_train_dict, AOCL_Compression_api_aocl_llc_train_dict_threads_common_2) //numThreads
+{
+    skip_test_if_algo_invalid(algo)
+    reset_ACD(&desc, algo_levels[algo].def);
+    desc.numThreads = 4;
+    int64_t dictSize = train_dict();
+    if (algo == ZSTD)
+        EXPECT_GT(dictSize, 0);
+    else
+        EXPECT_EQ(dictSize, ERR_UNSUPPORTED_METHOD);
+}
+
+TEST_P(API_train_dict, AOCL_Compression_api_aocl_llc_train_dict_memLimit_common_3) //memLimit too small
+{
+    skip_test_if_algo_invalid(algo)
+    reset_ACD(&desc, algo_levels[algo].def);
+    desc.memLimit = 1024;
+    int64_t dictSize = train_dict();
+    if (algo == ZSTD)
+        EXPECT_EQ(dictSize, ERR_COMPRESSION_FAILED);
+    else
+        EXPECT_EQ(dictSize, ERR_UNSUPPORTED_METHOD);
+}
+
+TEST_P(API_train_dict, AOCL_Compression_api_aocl_llc_train_dict_invalid_common_4) //Invalid algo id
+{
+    skip_test_if_algo_invalid(algo)
+    reset_ACD(&desc, algo_levels[algo].def);
+    algo = AOCL_COMPRESSOR_ALGOS_NUM;
+    EXPECT_EQ(train_dict(), ERR_UNSUPPORTED_METHOD);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    API_TEST,
+    API_train_dict,
+    ::testing::ValuesIn(get_algos()));
+/*********************************************
+ * End Train Dictionary Tests
+ ********************************************/
+
+/*********************************************
+ * Begin Adaptive Compress Tests
+ *********************************************/
+class API_compress_adaptive : public ::testing::TestWithParam<ACT> {
+public:
+    void SetUp() override {
+        algo = GetParam();
+        // Text-like input, so that levels differ in speed and ratio.
+        static const char* words[] = { "alpha ", "beta ", "gamma ", "delta ",
+            "epsilon ", "zeta ", "eta ", "theta " };
+        for (size_t i = 0; i < sizeof(src); ) {
+            const char* w = words[rand() % 8];
+            size_t len = strlen(w);
+            if (i + len > sizeof(src)) len = sizeof(src) - i;
+            memcpy(src + i, w, len);
+            i += len;
+        }
+    }
+
+    void TearDown() override {
+        if (algo < AOCL_COMPRESSOR_ALGOS_NUM && supported())
+            aocl_llc_destroy(&desc, algo);
+    }
+
+    bool supported() {
+        return algo == LZ4HC || algo == ZSTD;
+    }
+
+    void setup(INTP level) {
+        reset_ACD(&desc, level);
+        if (supported()) {
+            ASSERT_EQ(aocl_llc_setup(&desc, algo), 0);
+        }
+    }
+
+    int64_t compress_adaptive(float targetSpeed) {
+        desc.inBuf = src;
+        desc.inSize = sizeof(src);
+        desc.outBuf = dst;
+        desc.outSize = sizeof(dst);
+        // error codes come back as negative values cast to uint32_t
+        return (int32_t)aocl_llc_compress_adaptive(&desc, algo, targetSpeed);
+    }
+
+    //decompress the last adaptive output and match it with src
+    void decompress_and_validate(int64_t cSize) {
+        ACD ddesc = desc;
+        ddesc.inBuf = dst;
+        ddesc.inSize = cSize;
+        ddesc.outBuf = rt;
+        ddesc.outSize = sizeof(rt);
+        EXPECT_EQ(aocl_llc_decompress(&ddesc, algo), sizeof(src));
+        EXPECT_EQ(memcmp(src, rt, sizeof(src)), 0);
+    }
+
+    char src[64 * 1024];
+    char dst[80 * 1024];
+    char rt[64 * 1024];
+    ACT algo;
+    ACD desc;
+};
+
+TEST_P(API_compress_adaptive, AOCL_Compression_api_aocl_llc_compress_adaptive_lower_common_1) //target not met
+{
+    skip_test_if_algo_invalid(algo)
+    setup(algo_levels[algo].def);
+    if (!supported()) {
+        EXPECT_EQ(compress_adaptive(1.0f), ERR_UNSUPPORTED_METHOD);
+        return;
+    }
+    for (INTP i = 0; i < 3; ++i) {
+        size_t level = desc.level;
+        int64_t cSize = compress_adaptive(1e9f); //unreachable speed
+        ASSERT_GT(cSize, 0);
+        EXPECT_EQ(cSize, desc.cSize);
+        EXPECT_GT(desc.cTime, 0);
+        EXPECT_EQ(desc.level, level - 1); //one level per call
+        decompress_and_validate(cSize);
+    }
+}
+
+TEST_P(API_compress_adaptive, AOCL_Compression_api_aocl_llc_compress_adaptive_raise_common_2) //target beaten
+{
+    skip_test_if_algo_invalid(algo)
+    if (!supported()) return;
+    setup(algo_levels[algo].upper - 1);
+    int64_t cSize = compress_adaptive(1e-6f); //any speed beats it
+    ASSERT_GT(cSize, 0);
+    EXPECT_EQ(desc.level, (size_t)algo_levels[algo].upper);
+    cSize = compress_adaptive(1e-6f);
+    ASSERT_GT(cSize, 0);
+    EXPECT_EQ(desc.level, (size_t)algo_levels[algo].upper); //stays at the top level
+    decompress_and_validate(cSize);
+}
+
+TEST_P(API_compress_adaptive, AOCL_Compression_api_aocl_llc_compress_adaptive_clamp_common_3) //level out of range
+{
+    skip_test_if_algo_invalid(algo)
+    if (!supported()) return;
+    setup(algo_levels[algo].upper + 10);
+    int64_t cSize = compress_adaptive(1e9f);
+    ASSERT_GT(cSize, 0);
+    EXPECT_EQ(desc.level, (size_t)algo_levels[algo].upper - 1); //clamped, then lowered
+    decompress_and_validate(cSize);
+
+    desc.level = 0;
+    cSize = compress_adaptive(1e9f);
+    ASSERT_GT(cSize, 0);
+    EXPECT_EQ(desc.level, (size_t)algo_levels[algo].lower); //does not go below the lowest level
+    decompress_and_validate(cSize);
+}
+
+TEST_P(API_compress_adaptive, AOCL_Compression_api_aocl_llc_compress_adaptive_invalid_common_4) //Invalid algo id
+{
+    skip_test_if_algo_invalid(algo)
+    reset_ACD(&desc, 1);
+    algo = AOCL_COMPRESSOR_ALGOS_NUM;
+    EXPECT_EQ(compress_adaptive(1.0f), ERR_UNSUPPORTED_METHOD);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    API_TEST,
+    API_compress_adaptive,
+    ::testing::ValuesIn(get_algos()));
+/*********************************************
+ * End Adaptive Compress Tests
+ ********************************************/
+
+/*********************************************
+ * Begin In-place Decompress Tests
+ *********************************************/
+class API_decompress_inplace : public ::testing::TestWithParam<ACT> {
+public:
+    void SetUp() override {
+        algo = GetParam();
+        // Text with incompressible runs, so that blocks of every kind are produced.
+        static const char* words[] = { "alpha ", "beta ", "gamma ", "delta ",
+            "epsilon ", "zeta ", "eta ", "theta " };
+        src.resize(1024 * 1024);
+        for (size_t i = 0; i < src.size(); ) {
+            size_t len;
+            if (rand() % 64 == 0) {
+                len = std::min<size_t>(rand() % 256, src.size() - i);
+                for (size_t j = 0; j < len; ++j)
+                    src[i + j] = (char)rand();
+            }
+            else {
+                const char* w = words[rand() % 8];
+                len = std::min(strlen(w), src.size() - i);
+                memcpy(&src[i], w, len);
+            }
+            i += len;
+        }
+        reset_ACD(&desc, algo < AOCL_COMPRESSOR_ALGOS_NUM ? algo_levels[algo].def : 0);
+    }
+
+    void TearDown() override {
+        if (algo < AOCL_COMPRESSOR_ALGOS_NUM && supported())
+            aocl_llc_destroy(&desc, algo);
+    }
+
+    bool supported() {
+        return algo == LZ4 || algo == LZ4HC || algo == ZSTD;
+    }
+
+    void setup() {
+        desc.inSize = src.size();
+        ASSERT_EQ(aocl_llc_setup(&desc, algo), 0);
+    }
+
+    //compress size bytes of src into cbuf
+    int64_t compress(size_t size) {
+        cbuf.resize(size + size / 8 + 1024);
+        desc.inBuf = &src[0];
+        desc.inSize = size;
+        desc.outBuf = &cbuf[0];
+        desc.outSize = cbuf.size();
+        int64_t cSize = (int32_t)aocl_llc_compress(&desc, algo);
+        EXPECT_GT(cSize, 0);
+        return cSize;
+    }
+
+    //place the compressed data at offset in buf, then decompress it to the start of buf
+    int64_t decompress_at(size_t size, int64_t cSize, size_t offset) {
+        memcpy(&buf[offset], &cbuf[0], cSize);
+        desc.inBuf = &buf[offset];
+        desc.inSize = cSize;
+        desc.outBuf = &buf[0];
+        desc.outSize = size;
+        return aocl_llc_decompress_inplace(&desc, algo);
+    }
+
+    void roundtrip(size_t size) {
+        int64_t cSize = compress(size);
+        ASSERT_GT(cSize, 0);
+        int64_t margin = aocl_llc_decompress_margin(algo, cSize, size);
+        ASSERT_GT(margin, 0);
+        buf.assign(size + margin, 0);
+        ASSERT_LE((size_t)cSize, buf.size());
+        EXPECT_EQ(decompress_at(size, cSize, buf.size() - cSize), (int64_t)size);
+        EXPECT_EQ(memcmp(&src[0], &buf[0], size), 0);
+    }
+
+    std::vector<char> src;
+    std::vector<char> cbuf;
+    std::vector<char> buf;
+    ACT algo;
+    ACD desc;
+};
+
+TEST_P(API_decompress_inplace, AOCL_Compression_api_aocl_llc_decompress_inplace_sizes_common_1) //input at the end of the output
+{
+    skip_test_if_algo_invalid(algo)
+    if (!supported()) {
+        EXPECT_EQ(aocl_llc_decompress_margin(algo, 1000, 4000), ERR_UNSUPPORTED_METHOD);
+        EXPECT_EQ(aocl_llc_decompress_inplace(&desc, algo), ERR_UNSUPPORTED_METHOD);
+        return;
+    }
+    setup();
+    static const size_t sizes[] = { 1, 100, 4096, 65536, 131072, 131073, 300000, 1024 * 1024 };
+    for (size_t size : sizes)
+        roundtrip(size);
+}
+
+TEST_P(API_decompress_inplace, AOCL_Compression_api_aocl_llc_decompress_inplace_levels_common_2) //all levels
+{
+    skip_test_if_algo_invalid(algo)
+    if (!supported()) return;
+    for (INTP level = algo_levels[algo].lower; level <= algo_levels[algo].upper; ++level) {
+        reset_ACD(&desc, level);
+        setup();
+        roundtrip(200000);
+        aocl_llc_destroy(&desc, algo);
+    }
+    reset_ACD(&desc, algo_levels[algo].def);
+    setup();
+}
+
+TEST_P(API_decompress_inplace, AOCL_Compression_api_aocl_llc_decompress_inplace_layout_common_3) //unsafe overlaps are rejected
+{
+    skip_test_if_algo_invalid(algo)
+    if (!supported()) return;
+    setup();
+    size_t size = src.size(); //ZSTD margin is a whole block, so overlap needs several blocks
+    int64_t cSize = compress(size);
+    ASSERT_GT(cSize, 0);
+    int64_t margin = aocl_llc_decompress_margin(algo, cSize, size);
+    ASSERT_GT(margin, 0);
+
+    //input ends inside the margin
+    buf.assign(size + margin, 0);
+    EXPECT_EQ(decompress_at(size, cSize, buf.size() - cSize - 1), ERR_COMPRESSION_INVALID_OUTPUT);
+    //input starts before the output
+    desc.inBuf = &buf[0];
+    desc.inSize = cSize;
+    desc.outBuf = &buf[1];
+    desc.outSize = size;
+    EXPECT_EQ(aocl_llc_decompress_inplace(&desc, algo), ERR_COMPRESSION_INVALID_OUTPUT);
+
+    //extra space past the margin, and separate buffers
+    buf.assign(2 * size + margin, 0);
+    EXPECT_EQ(decompress_at(size, cSize, buf.size() - cSize - 1000), (int64_t)size);
+    EXPECT_EQ(memcmp(&src[0], &buf[0], size), 0);
+    buf.assign(size + cSize, 0);
+    EXPECT_EQ(decompress_at(size, cSize, size), (int64_t)size);
+    EXPECT_EQ(memcmp(&src[0], &buf[0], size), 0);
+
+    //output too small for the data
+    buf.assign(size + margin, 0);
+    EXPECT_EQ(decompress_at(size / 2, cSize, buf.size() - cSize), ERR_COMPRESSION_FAILED);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    API_TEST,
+    API_decompress_inplace,
+    ::testing::ValuesIn(get_algos()));
+/*********************************************
+ * End In-place Decompress Tests
+ ********************************************/
+
+#ifndef AOCL_EXCLUDE_ZLIB
+/*********************************************
+ * Begin ZLIB Stream Format Tests
+ *********************************************/
+class API_zlib_format : public API_method {
+public:
+    API_zlib_format() : API_method(ZLIB, 32 * 1024) {}
+
+    void SetUp() override {
+        API_method::SetUp();
+        aocl_llc_setup(&desc, ZLIB);
+    }
+};
+
+TEST_F(API_zlib_format, AOCL_Compression_api_zlib_format_wrappers_common_1) //same deflate data in every wrapper
+{
+    int64_t zSize = compress(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_ZLIB, 0, 0, 0), src.size());
+    ASSERT_GT(zSize, 0);
+    EXPECT_EQ((unsigned char)dst[0] & 0x0f, 8); //CM = deflate
+
+    int64_t gSize = compress(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_GZIP, 0, 0, 0), src.size());
+    ASSERT_GT(gSize, 0);
+    EXPECT_EQ((unsigned char)dst[0], 0x1f);
+    EXPECT_EQ((unsigned char)dst[1], 0x8b);
+    uint32_t isize = (unsigned char)dst[gSize - 4] |
+                     ((unsigned char)dst[gSize - 3] << 8) |
+                     ((unsigned char)dst[gSize - 2] << 16) |
+                     ((uint32_t)(unsigned char)dst[gSize - 1] << 24);
+    EXPECT_EQ(isize, src.size());
+
+    int64_t rSize = compress(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_RAW, 0, 0, 0), src.size());
+    ASSERT_GT(rSize, 0);
+    EXPECT_EQ(zSize, rSize + 2 + 4);  //2 byte header, Adler-32
+    EXPECT_EQ(gSize, rSize + 10 + 8); //10 byte header, CRC-32 and ISIZE
+}
+
+TEST_F(API_zlib_format, AOCL_Compression_api_zlib_format_roundtrip_common_2) //every format decodes
+{
+    roundtrip(0, src.size());
+    roundtrip(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_GZIP, 0, 0, 0), src.size());
+    roundtrip(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_RAW, 0, 0, 0), src.size());
+}
+
+TEST_F(API_zlib_format, AOCL_Compression_api_zlib_format_params_common_3) //windowBits, memLevel, strategy
+{
+    for (int strategy = 0; strategy <= 4; ++strategy) {
+        roundtrip(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_RAW, 9, 1, strategy), src.size());
+        roundtrip(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_GZIP, 12, 9, strategy), src.size());
+    }
+}
+
+TEST_F(API_zlib_format, AOCL_Compression_api_zlib_format_mismatch_common_4) //wrong format on decompression
+{
+    int64_t cSize = compress(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_GZIP, 0, 0, 0), src.size());
+    ASSERT_GT(cSize, 0);
+    EXPECT_EQ(decompress(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_ZLIB, 0, 0, 0), cSize, rt.size()), 0);
+}
+
+TEST_F(API_zlib_format, AOCL_Compression_api_zlib_format_invalid_common_5) //out of range fields
+{
+    EXPECT_EQ(compress(AOCL_ZLIB_OPT_VAR(3, 0, 0, 0), src.size()), 0);                      //format
+    EXPECT_EQ(compress(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_ZLIB, 8, 0, 0), src.size()), 0);  //windowBits
+    EXPECT_EQ(compress(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_ZLIB, 0, 10, 0), src.size()), 0); //memLevel
+    EXPECT_EQ(compress(AOCL_ZLIB_OPT_VAR(AOCL_ZLIB_FORMAT_ZLIB, 0, 0, 5), src.size()), 0);  //strategy
+    EXPECT_EQ(compress((size_t)1 << 13, src.size()), 0);                                    //unused bits
+}
+/*********************************************
+ * End ZLIB Stream Format Tests
+ ********************************************/
+#endif /* AOCL_EXCLUDE_ZLIB */
+
+#if !defined(AOCL_EXCLUDE_LZ4HC) && !defined(AOCL_EXCLUDE_LZ4)
+/*********************************************
+ * Begin LZ4HC Sized State Tests
+ *********************************************/
+class API_lz4hc_sized : public API_method {
+public:
+    API_lz4hc_sized() : API_method(LZ4HC, 128 * 1024) {}
+};
+
+TEST_F(API_lz4hc_sized, AOCL_Compression_api_lz4hc_sized_small_common_1) //table sized for small inputs
+{
+    desc.inSize = 4096;
+    aocl_llc_setup(&desc, LZ4HC);
+    ASSERT_NE(desc.workBuf, nullptr);
+    for (int i = 0; i < 4; ++i)
+        roundtrip(0, 4096);
+    roundtrip(0, 100);
+    roundtrip(0, src.size()); //larger than planned at setup
+    roundtrip(0, 4096);
+}
+
+TEST_F(API_lz4hc_sized, AOCL_Compression_api_lz4hc_sized_levels_common_2) //all levels, unknown size at setup
+{
+    aocl_llc_setup(&desc, LZ4HC);
+    ASSERT_NE(desc.workBuf, nullptr);
+    for (INTP level = algo_levels[LZ4HC].lower; level <= algo_levels[LZ4HC].upper; ++level) {
+        desc.level = level;
+        roundtrip(0, 20000);
+    }
+}
+/*********************************************
+ * End LZ4HC Sized State Tests
+ ********************************************/
+#endif /* !AOCL_EXCLUDE_LZ4HC && !AOCL_EXCLUDE_LZ4 */
+
+#ifndef AOCL_EXCLUDE_LZ4
+/*********************************************
+ * Begin LZ4 Stream Tests
+ *********************************************/
+class API_lz4_stream : public ::testing::Test {
+public:
+    void SetUp() override {
+        reset_ACD(&cdesc, algo_levels[LZ4].def);
+        reset_ACD(&ddesc, algo_levels[LZ4].def);
+        cdesc.optVar = ddesc.optVar = AOCL_LZ4_FORMAT_STREAM;
+        aocl_llc_setup(&cdesc, LZ4);
+        aocl_llc_setup(&ddesc, LZ4);
+        srand(7);
+    }
+
+    void TearDown() override {
+        aocl_llc_destroy(&cdesc, LZ4);
+        aocl_llc_destroy(&ddesc, LZ4);
+    }
+
+    //record of fields shared by all records, so that records repeat each other
+    void make_record(size_t size) {
+        static const char *fields[] = { "type=order;", "status=open;", "side=sell;",
+            "venue=XNYS;", "currency=USD;", "account=10042;", "qty=", "price=" };
+        size_t n = 0;
+        while (n < size) {
+            const char *f = fields[rand() % 8];
+            while (*f && n < size)
+                src[n++] = *f++;
+            if (n < size)
+                src[n++] = "0123456789"[rand() % 10];
+        }
+    }
+
+    //compresses src on desc
+    int64_t compress(ACD *desc, size_t size) {
+        desc->inBuf = src;
+        desc->inSize = size;
+        desc->outBuf = dst;
+        desc->outSize = sizeof(dst);
+        return aocl_llc_compress(desc, LZ4);
+    }
+
+    //compresses src on cdesc, decompresses it on ddesc, returns the compressed size
+    int64_t roundtrip(size_t size) {
+        int64_t cSize = compress(&cdesc, size);
+        EXPECT_GT(cSize, 0);
+        if (cSize <= 0)
+            return 0;
+        ddesc.inBuf = dst;
+        ddesc.inSize = cSize;
+        ddesc.outBuf = rt;
+        ddesc.outSize = sizeof(rt);
+        EXPECT_EQ(aocl_llc_decompress(&ddesc, LZ4), (int64_t)size);
+        EXPECT_EQ(memcmp(src, rt, size), 0);
+        return cSize;
+    }
+
+    char src[320 * 1024];
+    char dst[330 * 1024];
+    char rt[320 * 1024];
+    ACD cdesc;
+    ACD ddesc;
+};
+
+TEST_F(API_lz4_stream, AOCL_Compression_api_lz4_stream_linked_common_1) //small records reference earlier ones
+{
+    ASSERT_NE(cdesc.workBuf, nullptr);
+    ASSERT_NE(ddesc.workBuf, nullptr);
+    int64_t linked = 0, independent = 0;
+    for (int i = 0; i < 2000; ++i) { //history slides several times
+        size_t size = 100 + rand() % 400;
+        make_record(size);
+        linked += roundtrip(size);
+    }
+    ACD bdesc;
+    reset_ACD(&bdesc, algo_levels[LZ4].def);
+    srand(7);
+    for (int i = 0; i < 2000; ++i) {
+        size_t size = 100 + rand() % 400;
+        make_record(size);
+        independent += compress(&bdesc, size);
+    }
+    EXPECT_LT(linked * 3 / 2, independent);
+}
+
+TEST_F(API_lz4_stream, AOCL_Compression_api_lz4_stream_sizes_common_2) //blocks larger than the history
+{
+    size_t sizes[] = { 1, 70000, 13, sizeof(src), 5000, 200 * 1024, 64 * 1024, 0 };
+    for (size_t size : sizes) {
+        make_record(size);
+        if (size)
+            roundtrip(size);
+    }
+    //empty input still gives a block
+    int64_t cSize = compress(&cdesc, 0);
+    ASSERT_GT(cSize, 0);
+    ddesc.inBuf = dst;
+    ddesc.inSize = cSize;
+    ddesc.outBuf = rt;
+    ddesc.outSize = sizeof(rt);
+    EXPECT_EQ(aocl_llc_decompress(&ddesc, LZ4), 0);
+    make_record(1000);
+    roundtrip(1000);
+}
+
+TEST_F(API_lz4_stream, AOCL_Compression_api_lz4_stream_reset_common_3) //reset starts independent streams
+{
+    for (int i = 0; i < 10; ++i) {
+        make_record(1000);
+        roundtrip(1000);
+    }
+    EXPECT_EQ(aocl_llc_reset_stream(&cdesc, LZ4, nullptr), 0);
+    make_record(1000);
+    int64_t cSize = compress(&cdesc, 1000);
+    ASSERT_GT(cSize, 0);
+    //the first block of a stream is a plain LZ4 block
+    ACD bdesc;
+    reset_ACD(&bdesc, algo_levels[LZ4].def);
+    bdesc.inBuf = dst;
+    bdesc.inSize = cSize;
+    bdesc.outBuf = rt;
+    bdesc.outSize = sizeof(rt);
+    EXPECT_EQ(aocl_llc_decompress(&bdesc, LZ4), 1000);
+    EXPECT_EQ(memcmp(src, rt, 1000), 0);
+}
+
+TEST_F(API_lz4_stream, AOCL_Compression_api_lz4_stream_dict_common_4) //dictionary shared by streams
+{
+    make_record(40 * 1024);
+    aocl_llc_dict *dict = aocl_llc_create_dict(LZ4, src, 40 * 1024);
+    ASSERT_NE(dict, nullptr);
+    memset(src, 0, 40 * 1024); //dictionary content is copied
+
+    ACD c2, d2;
+    reset_ACD(&c2, algo_levels[LZ4].def);
+    reset_ACD(&d2, algo_levels[LZ4].def);
+    c2.optVar = d2.optVar = AOCL_LZ4_FORMAT_STREAM;
+    aocl_llc_setup(&c2, LZ4);
+    aocl_llc_setup(&d2, LZ4);
+
+    make_record(300);
+    int64_t plain = roundtrip(300);
+    for (int s = 0; s < 3; ++s) {
+        ASSERT_EQ(aocl_llc_reset_stream(&cdesc, LZ4, dict), 0);
+        ASSERT_EQ(aocl_llc_reset_stream(&ddesc, LZ4, dict), 0);
+        ASSERT_EQ(aocl_llc_reset_stream(&c2, LZ4, dict), 0);
+        ASSERT_EQ(aocl_llc_reset_stream(&d2, LZ4, dict), 0);
+        EXPECT_LT(roundtrip(300) * 3 / 2, plain);
+        for (int i = 0; i < 20; ++i) {
+            make_record(300);
+            roundtrip(300);
+        }
+        //second stream on the same dictionary
+        std::swap(cdesc, c2);
+        std::swap(ddesc, d2);
+        make_record(300);
+        EXPECT_LT(roundtrip(300) * 3 / 2, plain);
+        std::swap(cdesc, c2);
+        std::swap(ddesc, d2);
+    }
+
+    //decompressing without the dictionary fails or gives other data
+    ASSERT_EQ(aocl_llc_reset_stream(&cdesc, LZ4, dict), 0);
+    ASSERT_EQ(aocl_llc_reset_stream(&ddesc, LZ4, nullptr), 0);
+    make_record(300);
+    int64_t cSize = compress(&cdesc, 300);
+    ASSERT_GT(cSize, 0);
+    ddesc.inBuf = dst;
+    ddesc.inSize = cSize;
+    ddesc.outBuf = rt;
+    ddesc.outSize = sizeof(rt);
+    int64_t dSize = aocl_llc_decompress(&ddesc, LZ4);
+    EXPECT_TRUE(dSize != 300 || memcmp(src, rt, 300) != 0);
+
+    aocl_llc_destroy(&c2, LZ4);
+    aocl_llc_destroy(&d2, LZ4);
+    aocl_llc_free_dict(LZ4, dict);
+}
+
+TEST_F(API_lz4_stream, AOCL_Compression_api_lz4_stream_invalid_common_5) //handles and methods without streams
+{
+    ACD bdesc;
+    reset_ACD(&bdesc, algo_levels[LZ4].def);
+    aocl_llc_setup(&bdesc, LZ4);
+    EXPECT_NE(bdesc.workBuf, nullptr); //block state
+    EXPECT_EQ(aocl_llc_reset_stream(&bdesc, LZ4, nullptr), ERR_COMPRESSION_FAILED);
+    make_record(1000);
+    bdesc.optVar = AOCL_LZ4_FORMAT_STREAM; //not setup for streams
+    EXPECT_EQ(compress(&bdesc, 1000), 0);
+    bdesc.optVar = AOCL_LZ4_FORMAT_STREAM + 1;
+    EXPECT_EQ(compress(&bdesc, 1000), 0);
+    aocl_llc_destroy(&bdesc, LZ4);
+
+    EXPECT_EQ(aocl_llc_reset_stream(&cdesc, AOCL_COMPRESSOR_ALGOS_NUM, nullptr), ERR_UNSUPPORTED_METHOD);
+    EXPECT_EQ(aocl_llc_create_dict(AOCL_COMPRESSOR_ALGOS_NUM, src, 1000), nullptr);
+    EXPECT_EQ(aocl_llc_create_dict(LZ4, nullptr, 1000), nullptr);
+    aocl_llc_free_dict(LZ4, nullptr);
+#ifndef AOCL_EXCLUDE_ZSTD
+    EXPECT_EQ(aocl_llc_reset_stream(&cdesc, ZSTD, nullptr), ERR_UNSUPPORTED_METHOD);
+    EXPECT_EQ(aocl_llc_create_dict(ZSTD, src, 1000), nullptr);
+#endif
+}
+/*********************************************
+ * End LZ4 Stream Tests
+ ********************************************/
+#endif /* AOCL_EXCLUDE_LZ4 */
+
+#ifndef AOCL_EXCLUDE_SNAPPY
+/*********************************************
+ * Begin SNAPPY Bounded Decompress Tests
+ *********************************************/
+class API_snappy_bounded : public API_method {
+public:
+    API_snappy_bounded() : API_method(SNAPPY, 32 * 1024, 32 * 1024 + 64) {}
+
+    void SetUp() override {
+        API_method::SetUp();
+        aocl_llc_setup(&desc, SNAPPY);
+        cSize = compress(0, src.size());
+    }
+
+    int64_t cSize;
+};
+
+TEST_F(API_snappy_bounded, AOCL_Compression_api_snappy_bounded_length_common_1) //decoded length, not capacity
+{
+    ASSERT_GT(cSize, 0);
+    for (size_t optVar = AOCL_SNAPPY_DECOMPRESS_DEFAULT; optVar <= AOCL_SNAPPY_DECOMPRESS_VALIDATE; ++optVar) {
+        EXPECT_EQ(decompress(optVar, cSize, rt.size()), (int64_t)src.size());
+        EXPECT_EQ(memcmp(&src[0], &rt[0], src.size()), 0);
+    }
+}
+
+TEST_F(API_snappy_bounded, AOCL_Compression_api_snappy_bounded_capacity_common_2) //output does not fit
+{
+    ASSERT_GT(cSize, 0);
+    for (size_t optVar = AOCL_SNAPPY_DECOMPRESS_DEFAULT; optVar <= AOCL_SNAPPY_DECOMPRESS_VALIDATE; ++optVar) {
+        rt.assign(rt.size(), 0x5a);
+        EXPECT_EQ(decompress(optVar, cSize, src.size() - 1), 0);
+        for (size_t i = 0; i < rt.size(); ++i)
+            ASSERT_EQ(rt[i], 0x5a); //nothing written
+    }
+}
+
+TEST_F(API_snappy_bounded, AOCL_Compression_api_snappy_bounded_validate_common_3) //invalid data
+{
+    ASSERT_GT(cSize, 0);
+    /* truncated input fails in both modes, validation fails before writing */
+    EXPECT_EQ(decompress(AOCL_SNAPPY_DECOMPRESS_DEFAULT, cSize - 1, rt.size()), 0);
+    rt.assign(rt.size(), 0x5a);
+    EXPECT_EQ(decompress(AOCL_SNAPPY_DECOMPRESS_VALIDATE, cSize - 1, rt.size()), 0);
+    for (size_t i = 0; i < rt.size(); ++i)
+        ASSERT_EQ(rt[i], 0x5a);
+
+    EXPECT_EQ(decompress(AOCL_SNAPPY_DECOMPRESS_VALIDATE + 1, cSize, rt.size()), 0); //unknown mode
+}
+/*********************************************
+ * End SNAPPY Bounded Decompress Tests
+ ********************************************/
+#endif /* AOCL_EXCLUDE_SNAPPY */
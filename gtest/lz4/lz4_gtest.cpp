@@ -40,6 +40,7 @@
 #include <climits>
 #include "gtest/gtest.h"
 
+#define LZ4_STATIC_LINKING_ONLY
 #include "algos/lz4/lz4.h"
 
 using namespace std;
@@ -312,6 +313,30 @@ TEST_F(LLZ4_decompress_safe, AOCL_Compression_lz4_LZ4_decompress_safe_common_6 )
     EXPECT_LT(LZ4_decompress_safe(dst, output, dstCapacity, origLen), 0);
 }
 
+/* Runs of every match offset from 1 to 40, and far ones, between literal runs of
+   varying length, so that all match copy variants are decoded */
+static std::string lz4_offsets_source(size_t size)
+{
+    std::string data;
+    unsigned seed = 3;
+    while (data.size() < size)
+    {
+        seed = seed * 1103515245u + 12345u;
+        size_t lits = (seed >> 8) % 4 ? (seed >> 10) % 20 : (seed >> 10) % 400;
+        for (size_t i = 0; i < lits; i++)
+            data += (char)(rand() % 255);
+        seed = seed * 1103515245u + 12345u;
+        size_t offset = (seed >> 8) % 8 ? (seed >> 12) % 40 + 1 : (seed >> 12) % 60000 + 1;
+        size_t len = (seed >> 4) % 4 ? (seed >> 16) % 30 + 4 : (seed >> 16) % 2000 + 4;
+        if (offset > data.size())
+            continue;
+        for (size_t i = 0; i < len; i++)
+            data += data[data.size() - offset];
+    }
+    data.resize(size);
+    return data;
+}
+
 /*********************************************
  * "End" of Decompression Tests
  *********************************************/
@@ -455,6 +480,34 @@ TEST(LZ4_compress_destSize, AOCL_Compression_lz4_LZ4_compress_destSize_common_5)
     EXPECT_EQ(LZ4_compress_destSize(d.getOrigData(), d.getCompressedBuff(), &srcLen, 0), 0);
 }
 
+TEST(LZ4_compress_destSize, AOCL_Compression_lz4_LZ4_compress_destSize_common_6) // fillOutput_all_optLevels
+{
+    const int sizes[] = { 1000, 60000, 300000 };
+    const int targets[] = { 100, 4000, 50000 };
+    for (int size : sizes)
+    {
+        std::string data = lz4_offsets_source(size);
+        for (int target : targets)
+        {
+            for (int optLevel = -1; optLevel <= 3; optLevel++)
+            {
+                /* optLevel -1 : reference code */
+                aocl_setup_lz4(optLevel < 0, optLevel < 0 ? 0 : optLevel, 0, 0, 0);
+                std::string comp(target, 0), out(size, 0);
+                int srcLen = size;
+                int compLen = LZ4_compress_destSize(&data[0], &comp[0], &srcLen, target);
+                ASSERT_GT(compLen, 0);
+                EXPECT_LE(compLen, target);
+                ASSERT_LE(srcLen, size);
+                /* consumed input is exactly what decodes back */
+                ASSERT_EQ(LZ4_decompress_safe(&comp[0], &out[0], compLen, size), srcLen);
+                EXPECT_TRUE(out.compare(0, srcLen, data, 0, srcLen) == 0);
+            }
+        }
+    }
+    aocl_setup_lz4(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+}
+
 /*********************************************
  * End of LZ4_compress_destSize
  *********************************************/
@@ -536,8 +589,8 @@ protected:
         state = LZ4_createStream();
     }
 
-    // Initialize or reset `src` buffer.
-    void setSrcSize(int sz)
+    // Initialize or reset `src` buffer, with random or text-like data.
+    void setSrcSize(int sz, bool text = false)
     {
         if(src)
             free(src);
@@ -545,7 +598,7 @@ protected:
         src = (char *)malloc(srcSize);
         for (int i = 0; i < srcSize; i++)
         {
-            src[i] = rand() % 255;
+            src[i] = text ? "abcdefgh"[rand() % 8] : rand() % 255;
         }
     }
 
@@ -791,6 +844,83 @@ TEST_F(LZ4_AOCL_LZ4_compress_fast_extState, AOCL_Compression_lz4_AOCL_LZ4_compre
  * End of LZ4_compress_fast_extState
  *********************************************/
 
+/*********************************************
+ * "Begin" of AOCL_LZ4_compress_fast_extState_fastReset
+ *********************************************/
+
+/*
+    `state` is reused across calls, as a state kept in a setup work buffer is.
+    `src` holds text-like data, so that small inputs find matches.
+*/
+class LZ4_AOCL_LZ4_compress_fast_extState_fastReset : public LLZ4_compress_fast_extState
+{
+protected:
+    // Compress `len` bytes at `src + offset` and check they decompress back.
+    int compressAt(int offset, int len, int capacity)
+    {
+        int compressedSize = AOCL_LZ4_compress_fast_extState_fastReset(state, src + offset, dst, len, capacity, 1);
+        if (compressedSize > 0)
+        {
+            EXPECT_TRUE(check_uncompressed_equal_to_original(src + offset, len, dst, compressedSize));
+        }
+        return compressedSize;
+    }
+};
+
+TEST_F(LZ4_AOCL_LZ4_compress_fast_extState_fastReset, AOCL_Compression_lz4_AOCL_LZ4_compress_fast_extState_fastReset_common_1) // invalid_args
+{
+    setSrcSize(1000);
+    setDstSize(LZ4_compressBound(srcSize));
+    EXPECT_EQ(AOCL_LZ4_compress_fast_extState_fastReset(NULL, src, dst, srcSize, dstSize, 1), -1);
+    EXPECT_EQ(AOCL_LZ4_compress_fast_extState_fastReset(state, NULL, dst, srcSize, dstSize, 1), -1);
+    EXPECT_EQ(AOCL_LZ4_compress_fast_extState_fastReset(state, src, NULL, srcSize, dstSize, 1), -1);
+    EXPECT_EQ(AOCL_LZ4_compress_fast_extState_fastReset(state, NULL, dst, 0, dstSize, 1), 1);
+}
+
+TEST_F(LZ4_AOCL_LZ4_compress_fast_extState_fastReset, AOCL_Compression_lz4_AOCL_LZ4_compress_fast_extState_fastReset_common_2) // small_inputs_reuse_state
+{
+    setSrcSize(1 << 20, true);
+    setDstSize(LZ4_compressBound(4096));
+    LZ4_stream_t *freshState = LZ4_createStream();
+    long long total = 0, fresh = 0;
+    // enough calls for the table to be reset several times
+    for (int i = 0; i < 400; i++)
+    {
+        int len = 1 + rand() % 4095;
+        int offset = rand() % (srcSize - len);
+        int compressedSize = compressAt(offset, len, dstSize);
+        ASSERT_GT(compressedSize, 0);
+        total += compressedSize;
+        fresh += AOCL_LZ4_compress_fast_extState(freshState, src + offset, dst, len, dstSize, 1);
+    }
+    free(freshState);
+    // the reduced table costs little ratio on small inputs
+    EXPECT_LE(total, fresh + fresh / 20);
+}
+
+TEST_F(LZ4_AOCL_LZ4_compress_fast_extState_fastReset, AOCL_Compression_lz4_AOCL_LZ4_compress_fast_extState_fastReset_common_3) // mixed_sizes
+{
+    setSrcSize(300000, true);
+    setDstSize(LZ4_compressBound(srcSize));
+    static const int lens[] = { 100, 4095, 4096, 30000, 65546, 65547, 200000, 10, 3000, 70000, 2000, 60000, 1 };
+    for (int len : lens)
+        EXPECT_GT(compressAt(srcSize - len, len, dstSize), 0);
+    // random data after a stale table of each kind, with limited output
+    setSrcSize(300000);
+    for (int len : lens)
+    {
+        if (len > 16)
+        {
+            EXPECT_EQ(compressAt(0, len, len / 2), 0);
+        }
+        EXPECT_GT(compressAt(0, len, dstSize), 0);
+    }
+}
+
+/*********************************************
+ * End of AOCL_LZ4_compress_fast_extState_fastReset
+ *********************************************/
+
 /*********************************************
  * "Begin" of LZ4_createStream
  *********************************************/
@@ -42,6 +42,7 @@
 
 #include "algos/lz4/lz4.h"
 #include "algos/lz4/lz4hc.h"
+#include "algos/lz4/lz4frame.h"
 
 using namespace std;
 
@@ -1727,3 +1728,416 @@ TEST_F(LZ4HC_AOCL_LZ4HC_countBack, AOCL_Compression_lz4hc_AOCL_LZ4HC_countBack_c
 /*********************************************
  * "End" of AOCL_LZ4HC_countBack Tests
  *********************************************/
+
+/*********************************************
+ * "Begin" of AOCL_LZ4HC_compress_optimal Tests
+ *********************************************/
+/* Text like data with short and long repeats, runs and random segments, so
+ * that the optimal parser sees matches of every length */
+static std::string lz4hc_optimal_source(size_t sz, unsigned seed)
+{
+    const char* words[] = { "lorem ", "ipsum ", "dolor ", "sit ", "amet, ", "consectetur ",
+                            "adipiscing ", "elit. ", "sed ", "do ", "eiusmod ", "tempor " };
+    std::string s;
+    srand(seed);
+    while (s.size() < sz) {
+        int kind = rand() % 16;
+        if (kind < 10) {
+            s += words[rand() % 12];
+        } else if (kind < 12 && s.size() > 64) {
+            size_t len = 20 + rand() % 5000;                /* long repeat */
+            size_t off = 1 + rand() % (s.size() < 60000 ? s.size() : 60000);
+            for (size_t i = 0; i < len; i++) s += s[s.size() - off];
+        } else if (kind < 13) {
+            s.append(1 + rand() % 300, (char)(rand() % 4)); /* run */
+        } else {
+            for (int i = rand() % 40; i > 0; i--) s += (char)rand();
+        }
+    }
+    s.resize(sz);
+    return s;
+}
+
+/* AOCL_LZ4HC_RUN_PRESCAN changes the parse of runs, so outputs of the AOCL
+ * parser are compared with the reference only without it */
+#ifdef AOCL_LZ4HC_RUN_PRESCAN
+#define LZ4HC_SAME_OUTPUT_AS_REFERENCE 0
+#else
+#define LZ4HC_SAME_OUTPUT_AS_REFERENCE 1
+#endif
+
+/* Compresses src at cLevel with the reference parser (optOff) and with the
+ * AOCL parser at optLevel, checks both outputs are identical and decompress */
+static void lz4hc_optimal_check(const std::string& src, int cLevel, int optLevel)
+{
+    int bound = LZ4_compressBound((int)src.size());
+    std::string ref(bound, 0), out(bound, 0), dec(src.size() + 1, 0);
+
+    aocl_setup_lz4hc(1, optLevel, 0, 0, 0);
+    int refSz = LZ4_compress_HC(src.data(), &ref[0], (int)src.size(), bound, cLevel);
+    aocl_setup_lz4hc(0, optLevel, 0, 0, 0);
+    int outSz = LZ4_compress_HC(src.data(), &out[0], (int)src.size(), bound, cLevel);
+
+    ASSERT_GT(refSz, 0);
+    if (LZ4HC_SAME_OUTPUT_AS_REFERENCE) {
+        ASSERT_EQ(outSz, refSz);
+        EXPECT_EQ(memcmp(ref.data(), out.data(), refSz), 0);
+    }
+    ASSERT_EQ(LZ4_decompress_safe(out.data(), &dec[0], outSz, (int)dec.size()), (int)src.size());
+    EXPECT_EQ(memcmp(src.data(), dec.data(), src.size()), 0);
+}
+
+TEST(LZ4HC_AOCL_LZ4HC_compress_optimal, AOCL_Compression_lz4hc_AOCL_LZ4HC_compress_optimal_common_1) // same output as reference parser
+{
+    const size_t sizes[] = { 13, 100, 4096, 65536, 300000 };
+    for (size_t sz : sizes)
+        for (int cLevel = LZ4HC_CLEVEL_OPT_MIN; cLevel <= LZ4HC_CLEVEL_MAX; cLevel++)
+            for (int optLevel = 0; optLevel <= 3; optLevel++)
+                lz4hc_optimal_check(lz4hc_optimal_source(sz, (unsigned)(sz + cLevel)), cLevel, optLevel);
+    aocl_setup_lz4hc(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+}
+
+TEST(LZ4HC_AOCL_LZ4HC_compress_optimal, AOCL_Compression_lz4hc_AOCL_LZ4HC_compress_optimal_common_2) // long matches beyond the parsing window
+{
+    /* repeats longer than LZ4_OPT_NUM end the parsing window early */
+    std::string src = lz4hc_optimal_source(10000, 7);
+    src += src + src;
+    src.append(20000, 'a');
+    for (int optLevel = 0; optLevel <= 3; optLevel++)
+        lz4hc_optimal_check(src, LZ4HC_CLEVEL_MAX, optLevel);
+    aocl_setup_lz4hc(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+}
+
+TEST(LZ4HC_AOCL_LZ4HC_compress_optimal, AOCL_Compression_lz4hc_AOCL_LZ4HC_compress_optimal_common_3) // fillOutput and dictionary modes
+{
+    std::string src = lz4hc_optimal_source(200000, 11);
+    std::string dict = lz4hc_optimal_source(65536, 12);
+    LZ4_streamHC_t* state = LZ4_createStreamHC();
+    ASSERT_NE(state, nullptr);
+
+    for (int cLevel = LZ4HC_CLEVEL_OPT_MIN; cLevel <= LZ4HC_CLEVEL_MAX; cLevel++) {
+        for (int target : { 1000, 30000 }) {
+            std::string ref(target, 0), out(target, 0);
+            int refSrcSz = (int)src.size(), outSrcSz = (int)src.size();
+            aocl_setup_lz4hc(1, 3, 0, 0, 0);
+            int refSz = LZ4_compress_HC_destSize(state, src.data(), &ref[0], &refSrcSz, target, cLevel);
+            aocl_setup_lz4hc(0, 3, 0, 0, 0);
+            int outSz = LZ4_compress_HC_destSize(state, src.data(), &out[0], &outSrcSz, target, cLevel);
+            ASSERT_GT(refSz, 0);
+            if (LZ4HC_SAME_OUTPUT_AS_REFERENCE) {
+                EXPECT_EQ(outSz, refSz);
+                EXPECT_EQ(outSrcSz, refSrcSz);
+                EXPECT_EQ(memcmp(ref.data(), out.data(), refSz), 0);
+            }
+        }
+
+        {
+            int bound = LZ4_compressBound((int)src.size());
+            std::string ref(bound, 0), out(bound, 0), dec(src.size(), 0);
+            aocl_setup_lz4hc(1, 3, 0, 0, 0);
+            LZ4_resetStreamHC_fast(state, cLevel);
+            LZ4_loadDictHC(state, dict.data(), (int)dict.size());
+            int refSz = LZ4_compress_HC_continue(state, src.data(), &ref[0], (int)src.size(), bound);
+            aocl_setup_lz4hc(0, 3, 0, 0, 0);
+            LZ4_resetStreamHC_fast(state, cLevel);
+            LZ4_loadDictHC(state, dict.data(), (int)dict.size());
+            int outSz = LZ4_compress_HC_continue(state, src.data(), &out[0], (int)src.size(), bound);
+            ASSERT_GT(refSz, 0);
+            if (LZ4HC_SAME_OUTPUT_AS_REFERENCE) {
+                ASSERT_EQ(outSz, refSz);
+                EXPECT_EQ(memcmp(ref.data(), out.data(), refSz), 0);
+            }
+            EXPECT_EQ(LZ4_decompress_safe_usingDict(out.data(), &dec[0], outSz, (int)dec.size(),
+                                                    dict.data(), (int)dict.size()), (int)src.size());
+            EXPECT_EQ(memcmp(src.data(), dec.data(), src.size()), 0);
+        }
+    }
+    LZ4_freeStreamHC(state);
+    aocl_setup_lz4hc(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+}
+/*********************************************
+ * "End" of AOCL_LZ4HC_compress_optimal Tests
+ *********************************************/
+
+/*********************************************
+ * "Begin" of AOCL_LZ4HC_countPattern Tests
+ *********************************************/
+/* Highest optLevel the system running gtest supports */
+static int lz4hc_max_opt_level()
+{
+    return __builtin_cpu_supports("avx512bw") ? 4 : 3;
+}
+
+/* Patterns of length 1, 2 and 4 */
+static const unsigned lz4hc_patterns[] = { 0x00000000, 0xFFFFFFFF, 0x34123412, 0x78563412 };
+
+/* Fills buf with the bytes of pattern repeated, byte 0 at phase0 */
+static void lz4hc_fill_pattern(LZ4_byte* buf, size_t sz, unsigned pattern, size_t phase0)
+{
+    for (size_t i = 0; i < sz; i++)
+        buf[i] = (LZ4_byte)(pattern >> (8 * ((i - phase0) & 3)));
+}
+
+TEST(LZ4HC_AOCL_LZ4HC_countPattern, AOCL_Compression_lz4hc_AOCL_LZ4HC_countPattern_common_1) // same count as LZ4HC_countPattern
+{
+    LZ4_byte buf[512];
+    srand(48);
+    for (int optLevel = 0; optLevel <= lz4hc_max_opt_level(); optLevel++) {
+        aocl_setup_lz4hc(0, optLevel, 0, 0, 0);
+        for (int i = 0; i < 3000; i++) {
+            unsigned const pattern = lz4hc_patterns[i & 3];
+            size_t const runLen = rand() % 300;
+            size_t const endOff = rand() % 400;
+            lz4hc_fill_pattern(buf, sizeof(buf), pattern, 0);
+            buf[runLen] ^= 1 << (rand() % 8); // run ends at a byte of any value
+            EXPECT_EQ(Test_AOCL_LZ4HC_countPattern(buf, buf + endOff, pattern),
+                      Test_LZ4HC_countPattern(buf, buf + endOff, pattern));
+        }
+    }
+    aocl_setup_lz4hc(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+}
+
+TEST(LZ4HC_AOCL_LZ4HC_countPattern, AOCL_Compression_lz4hc_AOCL_LZ4HC_countPattern_common_2) // same count as LZ4HC_reverseCountPattern
+{
+    LZ4_byte buf[512];
+    size_t const ipOff = 400;
+    srand(48);
+    for (int optLevel = 0; optLevel <= lz4hc_max_opt_level(); optLevel++) {
+        aocl_setup_lz4hc(0, optLevel, 0, 0, 0);
+        for (int i = 0; i < 3000; i++) {
+            unsigned const pattern = lz4hc_patterns[i & 3];
+            size_t const runLen = rand() % 300;
+            size_t const lowOff = rand() % (ipOff + 1); // iLow in any phase
+            lz4hc_fill_pattern(buf, sizeof(buf), pattern, ipOff - 4);
+            buf[ipOff - runLen - 1] ^= 1 << (rand() % 8);
+            EXPECT_EQ(Test_AOCL_LZ4HC_reverseCountPattern(buf + ipOff, buf + lowOff, pattern),
+                      Test_LZ4HC_reverseCountPattern(buf + ipOff, buf + lowOff, pattern));
+        }
+    }
+    aocl_setup_lz4hc(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+}
+
+TEST(LZ4HC_AOCL_LZ4HC_countPattern, AOCL_Compression_lz4hc_AOCL_LZ4HC_countPattern_common_3) // runs give the same output as the reference
+{
+    /* runs of every pattern length between text, as in disk images */
+    std::string src = lz4hc_optimal_source(100000, 48);
+    for (size_t pos = 0; pos + 5000 < src.size(); pos += 5000) {
+        unsigned const pattern = lz4hc_patterns[(pos / 5000) & 3];
+        size_t const runLen = 40 + (pos * 7) % 3000;
+        for (size_t i = 0; i < runLen; i++)
+            src[pos + i] = (char)(pattern >> (8 * (i & 3)));
+    }
+    for (int cLevel = LZ4HC_CLEVEL_DEFAULT; cLevel <= LZ4HC_CLEVEL_MAX; cLevel++)
+        for (int optLevel = 0; optLevel <= lz4hc_max_opt_level(); optLevel++)
+            lz4hc_optimal_check(src, cLevel, optLevel);
+    aocl_setup_lz4hc(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+}
+/*********************************************
+ * "End" of AOCL_LZ4HC_countPattern Tests
+ *********************************************/
+
+/*********************************************
+ * "Begin" of AOCL_LZ4_compress_HC_extStateHC_sized Tests
+ *********************************************/
+TEST(LZ4HC_AOCL_LZ4HC_hashLogForSize, AOCL_Compression_lz4hc_AOCL_LZ4HC_hashLogForSize_common_1)
+{
+    EXPECT_EQ(AOCL_LZ4HC_hashLogForSize(0), LZ4HC_HASH_LOG);
+    EXPECT_EQ(AOCL_LZ4HC_hashLogForSize(1), LZ4HC_HASH_LOG_MIN);
+    EXPECT_EQ(AOCL_LZ4HC_hashLogForSize(4096), 12);
+    EXPECT_EQ(AOCL_LZ4HC_hashLogForSize(4097), 13);
+    EXPECT_EQ(AOCL_LZ4HC_hashLogForSize(1 << 20), LZ4HC_HASH_LOG);
+}
+
+class LZ4HC_AOCL_LZ4_compress_HC_extStateHC_sized : public AOCL_setup_lz4hc
+{
+protected:
+    char *state = NULL;
+
+    void SetUp() override
+    {
+        // not initialized on purpose: the state is prepared by the call
+        state = (char *)malloc(LZ4_sizeofStateHC());
+        memset(state, 0xA5, LZ4_sizeofStateHC());
+    }
+
+    void TearDown() override
+    {
+        free(state);
+    }
+};
+
+TEST_F(LZ4HC_AOCL_LZ4_compress_HC_extStateHC_sized, AOCL_Compression_lz4hc_AOCL_LZ4_compress_HC_extStateHC_sized_common_1) // invalid arguments
+{
+    char src[16] = { 0 }, dst[64];
+    EXPECT_EQ(AOCL_LZ4_compress_HC_extStateHC_sized(NULL, src, dst, 16, 64, 9, 12), -1);
+    EXPECT_EQ(AOCL_LZ4_compress_HC_extStateHC_sized(state, NULL, dst, 16, 64, 9, 12), -1);
+    EXPECT_EQ(AOCL_LZ4_compress_HC_extStateHC_sized(state, src, NULL, 16, 64, 9, 12), -1);
+    EXPECT_GT(AOCL_LZ4_compress_HC_extStateHC_sized(state, NULL, dst, 0, 64, 9, 12), 0);
+}
+
+TEST_F(LZ4HC_AOCL_LZ4_compress_HC_extStateHC_sized, AOCL_Compression_lz4hc_AOCL_LZ4_compress_HC_extStateHC_sized_common_2) // round trip for all sizes and levels
+{
+    const int sizes[] = { 1, 13, 1000, 4096, 20000, 65536, 200000 };
+    for (int sz : sizes) {
+        std::string src = lz4hc_optimal_source(sz, (unsigned)sz);
+        int bound = LZ4_compressBound(sz);
+        std::string out(bound, 0), dec(sz, 0);
+        for (int cLevel = 1; cLevel <= LZ4HC_CLEVEL_MAX; cLevel++) {
+            // out of range hash logs are clamped
+            for (int hashLog : { 0, LZ4HC_HASH_LOG_MIN, AOCL_LZ4HC_hashLogForSize(sz), LZ4HC_HASH_LOG, 30 }) {
+                int outSz = AOCL_LZ4_compress_HC_extStateHC_sized(state, src.data(), &out[0], sz, bound, cLevel, hashLog);
+                ASSERT_GT(outSz, 0);
+                ASSERT_EQ(LZ4_decompress_safe(out.data(), &dec[0], outSz, sz), sz);
+                EXPECT_EQ(memcmp(src.data(), dec.data(), sz), 0);
+            }
+        }
+    }
+}
+
+TEST_F(LZ4HC_AOCL_LZ4_compress_HC_extStateHC_sized, AOCL_Compression_lz4hc_AOCL_LZ4_compress_HC_extStateHC_sized_common_3) // same output as LZ4_compress_HC with the full table
+{
+    std::string src = lz4hc_optimal_source(100000, 3);
+    int bound = LZ4_compressBound((int)src.size());
+    std::string ref(bound, 0), out(bound, 0);
+    for (int cLevel : { 3, 9, 12 }) {
+        int refSz = LZ4_compress_HC(src.data(), &ref[0], (int)src.size(), bound, cLevel);
+        int outSz = AOCL_LZ4_compress_HC_extStateHC_sized(state, src.data(), &out[0], (int)src.size(), bound, cLevel, LZ4HC_HASH_LOG);
+        ASSERT_EQ(outSz, refSz);
+        EXPECT_EQ(memcmp(ref.data(), out.data(), refSz), 0);
+    }
+}
+
+TEST_F(LZ4HC_AOCL_LZ4_compress_HC_extStateHC_sized, AOCL_Compression_lz4hc_AOCL_LZ4_compress_HC_extStateHC_sized_common_4) // state reused by other functions
+{
+    std::string src = lz4hc_optimal_source(30000, 5);
+    int bound = LZ4_compressBound((int)src.size());
+    std::string out(bound, 0), ref(bound, 0), dec(src.size(), 0);
+
+    // limited output
+    EXPECT_EQ(AOCL_LZ4_compress_HC_extStateHC_sized(state, src.data(), &out[0], (int)src.size(), 100, 9, 11), 0);
+
+    ASSERT_GT(AOCL_LZ4_compress_HC_extStateHC_sized(state, src.data(), &out[0], (int)src.size(), bound, 9, 11), 0);
+    int refSz = LZ4_compress_HC(src.data(), &ref[0], (int)src.size(), bound, 9);
+    int outSz = LZ4_compress_HC_extStateHC(state, src.data(), &out[0], (int)src.size(), bound, 9);
+    ASSERT_EQ(outSz, refSz);
+    EXPECT_EQ(memcmp(ref.data(), out.data(), refSz), 0);
+
+    ASSERT_GT(AOCL_LZ4_compress_HC_extStateHC_sized(state, src.data(), &out[0], (int)src.size(), bound, 9, 11), 0);
+    LZ4_resetStreamHC_fast((LZ4_streamHC_t *)state, 9);
+    outSz = LZ4_compress_HC_continue((LZ4_streamHC_t *)state, src.data(), &out[0], (int)src.size(), bound);
+    ASSERT_GT(outSz, 0);
+    ASSERT_EQ(LZ4_decompress_safe(out.data(), &dec[0], outSz, (int)dec.size()), (int)src.size());
+    EXPECT_EQ(memcmp(src.data(), dec.data(), src.size()), 0);
+}
+/*********************************************
+ * "End" of AOCL_LZ4_compress_HC_extStateHC_sized Tests
+ *********************************************/
+
+
+/*********************************************
+ * "Begin" of AOCL_LZ4F_compressFrame_mt Tests
+ *********************************************/
+/* Decodes a whole frame with the stock frame decoder, returns the decoded
+ * size or -1 on error */
+static long long lz4hc_frame_decode(const std::string& frame, std::string& out)
+{
+    LZ4F_dctx* dctx;
+    size_t dstSize = out.size(), srcSize = frame.size();
+    if (LZ4F_isError(LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION)))
+        return -1;
+    size_t ret = LZ4F_decompress(dctx, &out[0], &dstSize, frame.data(), &srcSize, NULL);
+    LZ4F_freeDecompressionContext(dctx);
+    if (ret != 0 || srcSize != frame.size()) //frame not complete or not consumed
+        return -1;
+    return (long long)dstSize;
+}
+
+static std::string lz4hc_frame_mt(const std::string& src, const LZ4F_preferences_t* prefs, int numThreads)
+{
+    std::string frame(LZ4F_compressFrameBound(src.size(), prefs), 0);
+    size_t sz = AOCL_LZ4F_compressFrame_mt(&frame[0], frame.size(), src.data(), src.size(), prefs, numThreads);
+    EXPECT_FALSE(LZ4F_isError(sz)) << LZ4F_getErrorName(sz);
+    frame.resize(LZ4F_isError(sz) ? 0 : sz);
+    return frame;
+}
+
+TEST(LZ4HC_AOCL_LZ4F_compressFrame_mt, AOCL_Compression_lz4hc_AOCL_LZ4F_compressFrame_mt_common_1) // frames decode with LZ4F_decompress
+{
+    std::string src = lz4hc_optimal_source(1000000, 3);
+    std::string out(src.size() + 1, 0);
+    for (int level = -1; level <= LZ4HC_CLEVEL_MAX; level++) {
+        for (int linked = 0; linked <= 1; linked++) {
+            LZ4F_preferences_t prefs = LZ4F_INIT_PREFERENCES;
+            prefs.compressionLevel = level;
+            prefs.frameInfo.blockSizeID = LZ4F_max64KB;
+            prefs.frameInfo.blockMode = linked ? LZ4F_blockLinked : LZ4F_blockIndependent;
+            prefs.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+            prefs.frameInfo.blockChecksumFlag = LZ4F_blockChecksumEnabled;
+            prefs.frameInfo.contentSize = 1;
+            std::string frame = lz4hc_frame_mt(src, &prefs, 4);
+            ASSERT_EQ(lz4hc_frame_decode(frame, out), (long long)src.size());
+            EXPECT_EQ(memcmp(src.data(), out.data(), src.size()), 0);
+
+            /* the frame is the one of LZ4F_compressFrame(), except for linked
+             * blocks below LZ4HC_CLEVEL_MIN, where priming each block with the
+             * preceding input keeps the ratio of a single threaded frame */
+            std::string ref(LZ4F_compressFrameBound(src.size(), &prefs), 0);
+            size_t refSz = LZ4F_compressFrame(&ref[0], ref.size(), src.data(), src.size(), &prefs);
+            ASSERT_FALSE(LZ4F_isError(refSz));
+            if (!linked || level >= LZ4HC_CLEVEL_MIN) {
+                ASSERT_EQ(frame.size(), refSz) << "level " << level << (linked ? " linked" : " independent");
+                EXPECT_EQ(memcmp(frame.data(), ref.data(), refSz), 0) << "level " << level;
+            } else {
+                EXPECT_LE(frame.size(), refSz + refSz / 100) << "level " << level;
+            }
+        }
+    }
+}
+
+TEST(LZ4HC_AOCL_LZ4F_compressFrame_mt, AOCL_Compression_lz4hc_AOCL_LZ4F_compressFrame_mt_common_2) // output does not depend on numThreads
+{
+    std::string src = lz4hc_optimal_source(3000000, 5);
+    LZ4F_preferences_t prefs = LZ4F_INIT_PREFERENCES;
+    prefs.compressionLevel = LZ4HC_CLEVEL_DEFAULT;
+    prefs.frameInfo.blockSizeID = LZ4F_max256KB;
+    prefs.frameInfo.blockMode = LZ4F_blockLinked;
+    std::string frame1 = lz4hc_frame_mt(src, &prefs, 1);
+    ASSERT_GT(frame1.size(), 0u);
+    const int threads[] = { 0, 2, 3, 16, 100 };
+    for (int n : threads)
+        EXPECT_TRUE(lz4hc_frame_mt(src, &prefs, n) == frame1) << n << " threads";
+    std::string out(src.size(), 0);
+    ASSERT_EQ(lz4hc_frame_decode(frame1, out), (long long)src.size());
+    EXPECT_TRUE(out == src);
+}
+
+TEST(LZ4HC_AOCL_LZ4F_compressFrame_mt, AOCL_Compression_lz4hc_AOCL_LZ4F_compressFrame_mt_common_3) // small inputs, default preferences and errors
+{
+    std::string out(300000, 0);
+    const size_t sizes[] = { 0, 1, 100, 65536, 65537, 200000 };
+    for (size_t sz : sizes) {
+        std::string src = lz4hc_optimal_source(sz, (unsigned)sz);
+        std::string frame = lz4hc_frame_mt(src, NULL, 4);
+        ASSERT_GT(frame.size(), 0u);
+        ASSERT_EQ(lz4hc_frame_decode(frame, out), (long long)sz);
+        EXPECT_EQ(memcmp(src.data(), out.data(), sz), 0);
+    }
+
+    /* incompressible blocks are stored */
+    std::string rnd(200000, 0);
+    for (size_t i = 0; i < rnd.size(); i++) rnd[i] = (char)rand();
+    LZ4F_preferences_t prefs = LZ4F_INIT_PREFERENCES;
+    prefs.compressionLevel = LZ4HC_CLEVEL_MAX;
+    std::string frame = lz4hc_frame_mt(rnd, &prefs, 2);
+    ASSERT_EQ(lz4hc_frame_decode(frame, out), (long long)rnd.size());
+    EXPECT_EQ(memcmp(rnd.data(), out.data(), rnd.size()), 0);
+
+    std::string src = lz4hc_optimal_source(100000, 9);
+    std::string dst(LZ4F_compressFrameBound(src.size(), &prefs), 0);
+    EXPECT_TRUE(LZ4F_isError(AOCL_LZ4F_compressFrame_mt(&dst[0], dst.size() - 1, src.data(), src.size(), &prefs, 2)));
+    EXPECT_TRUE(LZ4F_isError(AOCL_LZ4F_compressFrame_mt(NULL, dst.size(), src.data(), src.size(), &prefs, 2)));
+    EXPECT_TRUE(LZ4F_isError(AOCL_LZ4F_compressFrame_mt(&dst[0], dst.size(), NULL, src.size(), &prefs, 2)));
+}
+/*********************************************
+ * "End" of AOCL_LZ4F_compressFrame_mt Tests
+ *********************************************/
@@ -1303,6 +1303,119 @@ INSTANTIATE_TEST_SUITE_P(
     SNAPPY_RawUncompress_p,
     ::testing::ValuesIn(uncompress_pass_cases()));
 
+class SNAPPY_AOCL_RawUncompressSafe_ : public ::testing::TestWithParam<string>
+{
+    void SetUp() override {
+        aocl_setup_snappy_test();
+    }
+};
+
+TEST_P(SNAPPY_AOCL_RawUncompressSafe_, fail_cases)
+{
+    string compressed = GetParam();
+    char result[1000000];
+    size_t ulength = 0;
+
+    EXPECT_FALSE(AOCL_RawUncompressSafe(compressed.data(), compressed.size(), result, sizeof(result), &ulength, false));
+    EXPECT_FALSE(AOCL_RawUncompressSafe(compressed.data(), compressed.size(), result, sizeof(result), &ulength, true));
+    EXPECT_EQ(ulength, 0u); // not written on failure
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SNAPPY,
+    SNAPPY_AOCL_RawUncompressSafe_,
+    ::testing::ValuesIn(fail_cases()));
+
+class SNAPPY_AOCL_RawUncompressSafe_p : public ::testing::TestWithParam<pair<string, string>>
+{
+    void SetUp() override {
+        aocl_setup_snappy_test();
+    }
+};
+
+TEST_P(SNAPPY_AOCL_RawUncompressSafe_p, capacity)
+{
+    pair<string, string> p = GetParam();
+    string &compressed = p.first;
+    string &original = p.second;
+    const size_t guard = 64;
+    for (int validate = 0; validate <= 1; validate++)
+    {
+        // exact capacity, and a larger one : the decoded length is returned
+        for (size_t extra = 0; extra <= guard; extra += guard)
+        {
+            string result(original.size() + extra, '\x5a');
+            size_t ulength = 0;
+            EXPECT_TRUE(AOCL_RawUncompressSafe(compressed.data(), compressed.size(),
+                string_as_array(&result), result.size(), &ulength, validate));
+            EXPECT_EQ(ulength, original.size());
+            EXPECT_EQ(result.substr(0, ulength), original);
+            EXPECT_EQ(result.substr(ulength), string(extra, '\x5a'));
+        }
+        // one byte short : fails before writing anything
+        if (original.size() > 0)
+        {
+            string result(original.size() - 1 + guard, '\x5a');
+            size_t ulength = 0;
+            EXPECT_FALSE(AOCL_RawUncompressSafe(compressed.data(), compressed.size(),
+                string_as_array(&result), original.size() - 1, &ulength, validate));
+            EXPECT_EQ(result, string(result.size(), '\x5a'));
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SNAPPY,
+    SNAPPY_AOCL_RawUncompressSafe_p,
+    ::testing::ValuesIn(uncompress_pass_cases()));
+
+TEST(SNAPPY_AOCL_RawUncompressSafe, all_optLevels)
+{
+    string original(100000, 0);
+    for (size_t i = 0; i < original.size(); i++)
+        original[i] = "abcdefgh"[(i * 7 + i / 13) % 8];
+    string compressed;
+    Compress(original.data(), original.size(), &compressed);
+
+    // truncated and corrupted copies fail in every variant, within bounds
+    string truncated = compressed.substr(0, compressed.size() - 1);
+    string corrupted = compressed;
+    corrupted[compressed.size() / 2] ^= 0x40;
+    for (int optLevel = -1; optLevel <= 3; optLevel++)
+    {
+        // optLevel -1 : reference code
+        aocl_setup_snappy(optLevel < 0, optLevel < 0 ? 0 : optLevel, 0, 0, 0);
+        string result(original.size(), 0);
+        size_t ulength = 0;
+        EXPECT_TRUE(AOCL_RawUncompressSafe(compressed.data(), compressed.size(),
+            string_as_array(&result), result.size(), &ulength, false));
+        EXPECT_EQ(ulength, original.size());
+        EXPECT_EQ(result, original);
+        EXPECT_FALSE(AOCL_RawUncompressSafe(truncated.data(), truncated.size(),
+            string_as_array(&result), result.size(), &ulength, false));
+        bool decoded = AOCL_RawUncompressSafe(corrupted.data(), corrupted.size(),
+            string_as_array(&result), result.size(), &ulength, false);
+        EXPECT_EQ(decoded, IsValidCompressedBuffer(corrupted.data(), corrupted.size()));
+    }
+    aocl_setup_snappy_test();
+}
+
+TEST(SNAPPY_AOCL_RawUncompressSafe, fail_cases)
+{
+    char c[100];
+    size_t ulength;
+    string s = "Hello world";
+    string result;
+
+    Compress(s.data(), s.size(), &result);
+
+    EXPECT_FALSE(AOCL_RawUncompressSafe(NULL, 100, c, sizeof(c), &ulength, false));
+    EXPECT_FALSE(AOCL_RawUncompressSafe(result.data(), result.size(), NULL, sizeof(c), &ulength, false));
+    EXPECT_FALSE(AOCL_RawUncompressSafe(result.data(), result.size(), c, sizeof(c), NULL, false));
+    EXPECT_FALSE(AOCL_RawUncompressSafe(result.data(), result.size(), c, s.size() - 1, &ulength, false));
+    EXPECT_FALSE(AOCL_RawUncompressSafe(result.data(), 0, c, sizeof(c), &ulength, true));
+}
+
 class SNAPPY_Compress_ : public ::testing::TestWithParam<string>
 {
     void SetUp() override {
@@ -416,6 +416,83 @@ TEST_F(ZLIB_compress2, pass2)
   free(dest);
 }
 
+class ZLIB_compress2_mt : public AOCL_setup_zlib {
+};
+
+TEST_F(ZLIB_compress2_mt, fail_cases)
+{
+  const uLong srcLen = 10;
+  Bytef src[srcLen + 1] = "helloWorld";
+  uLong destLen = aocl_compressBound_mt(srcLen, 0);
+  Bytef *dest = (Bytef *)malloc(destLen);
+
+  EXPECT_EQ(aocl_compress2_mt(NULL, &destLen, src, srcLen, 6, MAX_WBITS, 2, 0), Z_STREAM_ERROR);  // AOCL_Compression_zlib_compress2_mt_common_1
+  EXPECT_EQ(aocl_compress2_mt(dest, NULL, src, srcLen, 6, MAX_WBITS, 2, 0), Z_STREAM_ERROR);  // AOCL_Compression_zlib_compress2_mt_common_2
+  EXPECT_EQ(aocl_compress2_mt(dest, &destLen, NULL, srcLen, 6, MAX_WBITS, 2, 0), Z_STREAM_ERROR);  // AOCL_Compression_zlib_compress2_mt_common_3
+  EXPECT_EQ(aocl_compress2_mt(dest, &destLen, src, srcLen, 10, MAX_WBITS, 2, 0), Z_STREAM_ERROR);  // AOCL_Compression_zlib_compress2_mt_common_4
+  EXPECT_EQ(aocl_compress2_mt(dest, &destLen, src, srcLen, 6, 12, 2, 0), Z_STREAM_ERROR);  // AOCL_Compression_zlib_compress2_mt_common_5
+  destLen = 3;
+  EXPECT_EQ(aocl_compress2_mt(dest, &destLen, src, srcLen, 6, MAX_WBITS, 2, 0), Z_BUF_ERROR);  // AOCL_Compression_zlib_compress2_mt_common_6
+  free(dest);
+}
+
+TEST_F(ZLIB_compress2_mt, pass)
+{
+  /* Spans several blocks, with repeats that reach across block boundaries */
+  const uLong srcLen = 700 * 1024 + 123;
+  std::string src(srcLen, 0);
+  for (uLong i = 0; i < srcLen; i++)
+    src[i] = (char)('a' + ((i * 131) ^ (i >> 9)) % 23);
+
+  uLong bound = aocl_compressBound_mt(srcLen, 0);
+  std::string dest(bound, 0);
+  std::string out(srcLen, 0);
+  std::string single;
+
+  for (int windowBits = MAX_WBITS; windowBits <= MAX_WBITS + 16; windowBits += 16)
+  {
+    /* 2 threads queue fewer slots than blocks, so the slots are reused */
+    for (int threads = 1; threads <= 4; threads *= 2)
+    {
+      uLong destLen = bound;
+      EXPECT_EQ(aocl_compress2_mt((Bytef *)&dest[0], &destLen, (const Bytef *)src.data(), srcLen,
+                                  6, windowBits, threads, 0), Z_OK);  // AOCL_Compression_zlib_compress2_mt_common_7
+
+      /* The output does not depend on the number of threads */
+      if (threads == 1)
+        single = dest.substr(0, destLen);
+      EXPECT_TRUE(dest.substr(0, destLen) == single);
+
+      /* Decodes as a single standard stream, check value included */
+      z_stream strm;
+      memset(&strm, 0, sizeof(strm));
+      ASSERT_EQ(inflateInit2(&strm, windowBits), Z_OK);
+      strm.next_in = (Bytef *)&dest[0];
+      strm.avail_in = (uInt)destLen;
+      strm.next_out = (Bytef *)&out[0];
+      strm.avail_out = (uInt)srcLen;
+      EXPECT_EQ(inflate(&strm, Z_FINISH), Z_STREAM_END);
+      EXPECT_EQ(strm.total_out, srcLen);
+      EXPECT_EQ(strm.avail_in, 0u);
+      EXPECT_TRUE(out == src);
+      inflateEnd(&strm);
+    }
+  }
+
+  /* Empty input still produces a valid stream */
+  uLong destLen = bound;
+  uLong outLen = srcLen;
+  EXPECT_EQ(aocl_compress2_mt((Bytef *)&dest[0], &destLen, (const Bytef *)src.data(), 0,
+                              1, MAX_WBITS, 4, 0), Z_OK);  // AOCL_Compression_zlib_compress2_mt_common_8
+  EXPECT_EQ(uncompress((Bytef *)&out[0], &outLen, (Bytef *)&dest[0], destLen), Z_OK);
+  EXPECT_EQ(outLen, 0u);
+
+  /* Running out of room midway stops the workers cleanly */
+  destLen = single.size() / 2;
+  EXPECT_EQ(aocl_compress2_mt((Bytef *)&dest[0], &destLen, (const Bytef *)src.data(), srcLen,
+                              6, MAX_WBITS + 16, 2, 0), Z_BUF_ERROR);  // AOCL_Compression_zlib_compress2_mt_common_9
+}
+
 class ZLIB_uncompress2 : public AOCL_setup_zlib {
 };
 
@@ -1022,6 +1099,59 @@ TEST(ZLIB_deflatePrime, pass_cases)
   rstd(strm);
 }
 
+TEST(ZLIB_deflatePrime, stream_roundtrip)
+{
+  /* Bit buffer must carry primed bits and partial codes across flushes
+  * and tiny output windows without corrupting the stream. */
+  const uInt srcLen = 64 * 1024;
+  std::string src(srcLen, 0);
+  for (uInt i = 0; i < srcLen; i++)
+    src[i] = (char)((i % 251) < 128 ? 'a' + (i * 7 % 26) : (i * 2654435761u) >> 24);
+
+  const int flushes[] = { Z_NO_FLUSH, Z_PARTIAL_FLUSH, Z_SYNC_FLUSH, Z_FULL_FLUSH, Z_BLOCK };
+  for (int level = 1; level <= 9; level++)
+  {
+    z_stream ds;
+    memset(&ds, 0, sizeof(ds));
+    ASSERT_EQ(deflateInit2(&ds, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY), Z_OK);
+    /* Prime an empty fixed-Huffman block (BFINAL=0, BTYPE=01, EOB) */
+    ASSERT_EQ(deflatePrime(&ds, 10, 2), Z_OK);
+
+    std::string comp(deflateBound(&ds, srcLen) + 1024, 0);
+    ds.next_out = (Bytef *)&comp[0];
+    uInt off = 0, chunk = 3000;
+    int ret = Z_OK, k = 0;
+    while (ret != Z_STREAM_END)
+    {
+      uInt n = (srcLen - off) < chunk ? (srcLen - off) : chunk;
+      ds.next_in = (Bytef *)&src[off];
+      ds.avail_in = n;
+      off += n;
+      int flush = off == srcLen ? Z_FINISH : flushes[k++ % 5];
+      do {
+        ds.avail_out = 7;
+        ret = deflate(&ds, flush);
+        ASSERT_NE(ret, Z_STREAM_ERROR);
+      } while (ds.avail_out == 0 || (flush == Z_FINISH && ret != Z_STREAM_END));
+    }
+    uLong compLen = ds.total_out;
+    deflateEnd(&ds);
+
+    z_stream is;
+    memset(&is, 0, sizeof(is));
+    ASSERT_EQ(inflateInit2(&is, -15), Z_OK);
+    std::string out(srcLen, 0);
+    is.next_in = (Bytef *)&comp[0];
+    is.avail_in = (uInt)compLen;
+    is.next_out = (Bytef *)&out[0];
+    is.avail_out = srcLen;
+    EXPECT_EQ(inflate(&is, Z_FINISH), Z_STREAM_END);
+    EXPECT_EQ(is.total_out, srcLen);
+    EXPECT_TRUE(out == src);
+    inflateEnd(&is);
+  }
+}
+
 TEST(ZLIB_deflateSetHeader, fail_cases)
 {
   z_streamp strm = nzp();
@@ -2229,3 +2359,545 @@ TEST_F(ZLIB_deflate, AOCL_Compression_zlib_deflate_large_buffers_3)
     free(compr);
     free(uncompr);
 }
+
+TEST(ZLIB_gzopen, pipelined_roundtrip)
+{
+  /* 'p' mode: background writes when writing, mapped input when reading.
+  * Data must match plain mode across flushes, members, seeks and rewinds. */
+  const char *path = "zlib_gtest_pipelined.gz";
+  const int srcLen = 1024 * 1024;
+  std::string src(srcLen, 0);
+  for (int i = 0; i < srcLen; i++)
+    src[i] = (char)((i % 509) < 300 ? 'a' + (i * 7 % 26) : (i * 2654435761u) >> 24);
+
+  const char *wmodes[] = { "wb6p", "wb1p" };
+  const char *rmodes[] = { "rb", "rbp" };
+  for (int w = 0; w < 2; w++)
+  {
+    gzFile gz = gzopen(path, wmodes[w]);
+    ASSERT_NE(gz, (gzFile)NULL);
+    EXPECT_EQ(gzbuffer(gz, 16384), 0);
+    int off = 0, k = 0;
+    while (off < srcLen)
+    {
+      int n = MIN(srcLen - off, 12345 * (k % 5 + 1));
+      ASSERT_EQ(gzwrite(gz, &src[off], n), n);
+      off += n;
+      if (++k % 7 == 0) {
+        EXPECT_EQ(gzflush(gz, Z_SYNC_FLUSH), Z_OK);
+      }
+    }
+    EXPECT_EQ(gzclose(gz), Z_OK);
+    /* second gzip member */
+    gz = gzopen(path, "abp");
+    ASSERT_NE(gz, (gzFile)NULL);
+    ASSERT_EQ(gzwrite(gz, &src[0], 1000), 1000);
+    EXPECT_EQ(gzclose(gz), Z_OK);
+
+    for (int r = 0; r < 2; r++)
+    {
+      gz = gzopen(path, rmodes[r]);
+      ASSERT_NE(gz, (gzFile)NULL);
+      EXPECT_EQ(gzbuffer(gz, 16384), 0);
+      std::string out(srcLen + 1000, 0);
+      int got, total = 0;
+      while ((got = gzread(gz, &out[total], MIN(65536, srcLen + 1000 - total))) > 0)
+        total += got;
+      EXPECT_EQ(total, srcLen + 1000);
+      EXPECT_TRUE(out.compare(0, srcLen, src) == 0);
+      EXPECT_TRUE(out.compare(srcLen, 1000, src, 0, 1000) == 0);
+
+      char buf[4096];
+      EXPECT_EQ(gzseek(gz, srcLen / 3, SEEK_SET), srcLen / 3);
+      EXPECT_EQ(gzread(gz, buf, sizeof(buf)), (int)sizeof(buf));
+      EXPECT_EQ(memcmp(buf, &src[srcLen / 3], sizeof(buf)), 0);
+      EXPECT_EQ(gzrewind(gz), 0);
+      EXPECT_EQ(gzread(gz, buf, sizeof(buf)), (int)sizeof(buf));
+      EXPECT_EQ(memcmp(buf, &src[0], sizeof(buf)), 0);
+      EXPECT_EQ(gzclose(gz), Z_OK);
+    }
+  }
+  remove(path);
+}
+
+TEST(ZLIB_deflate_rsyncable, bits_range)
+{
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  ASSERT_EQ(deflateInit(&strm, 6), Z_OK);
+  EXPECT_EQ(aocl_deflateRsyncable(&strm, 7), Z_STREAM_ERROR);
+  EXPECT_EQ(aocl_deflateRsyncable(&strm, 25), Z_STREAM_ERROR);
+  EXPECT_EQ(aocl_deflateRsyncable(&strm, 12), Z_OK);
+  EXPECT_EQ(aocl_deflateRsyncable(&strm, 0), Z_OK);
+  EXPECT_EQ(deflateEnd(&strm), Z_OK);
+  EXPECT_EQ(aocl_deflateRsyncable(NULL, 12), Z_STREAM_ERROR);
+}
+
+TEST(ZLIB_deflate_rsyncable, local_change)
+{
+  /* A byte changed early in the input must leave the end of the compressed
+   * stream untouched, whatever the chunking of input and output. */
+  const int srcLen = 512 * 1024;
+  std::string src(srcLen, 0);
+  unsigned seed = 1;
+  for (int i = 0; i < srcLen; i++)
+  {
+    seed = seed * 1103515245u + 12345u;
+    src[i] = (seed >> 16) % 5 ? 'a' + (seed >> 20) % 8 : ' ';
+  }
+  std::string mod = src;
+  mod[1000] ^= 1;
+
+  uLong bound = compressBound(srcLen) + 4096;
+  std::string out[2];
+  for (int v = 0; v < 2; v++)
+  {
+    const std::string &in = v ? mod : src;
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    ASSERT_EQ(deflateInit(&strm, 6), Z_OK);
+    ASSERT_EQ(aocl_deflateRsyncable(&strm, 12), Z_OK);
+    out[v].resize(bound);
+    strm.next_in = (Bytef *)&in[0];
+    strm.next_out = (Bytef *)&out[v][0];
+    int err = Z_OK;
+    while (err != Z_STREAM_END)
+    {
+      uLong inLeft = srcLen - strm.total_in;
+      strm.avail_in = (uInt)MIN(inLeft, 10007);
+      strm.avail_out = 999;
+      err = deflate(&strm, strm.avail_in == inLeft ? Z_FINISH : Z_NO_FLUSH);
+      ASSERT_TRUE(err == Z_OK || err == Z_STREAM_END || err == Z_BUF_ERROR);
+    }
+    out[v].resize(strm.total_out);
+    EXPECT_EQ(deflateEnd(&strm), Z_OK);
+
+    std::string back(srcLen, 0);
+    uLongf backLen = srcLen;
+    EXPECT_EQ(uncompress((Bytef *)&back[0], &backLen, (Bytef *)&out[v][0], out[v].size()), Z_OK);
+    EXPECT_EQ(backLen, (uLongf)srcLen);
+    EXPECT_TRUE(back == in);
+  }
+  /* only the adler32 trailer depends on the whole input */
+  size_t common = 0;
+  while (common + 5 < out[0].size() && common + 5 < out[1].size() &&
+         out[0][out[0].size() - 5 - common] == out[1][out[1].size() - 5 - common])
+    common++;
+  EXPECT_GT(common, out[0].size() / 2);
+}
+
+/* Compresses src with the given strategy, feeding and draining the stream in
+ * pieces of chunk bytes, and checks that it decompresses back to src. */
+static std::string deflate_strategy(const std::string &src, int strategy,
+                                    int optLevel, uInt chunk)
+{
+  aocl_setup_zlib(0, optLevel, 0, 0, 0);
+  std::string out(compressBound(src.size()) + 4096, 0);
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  EXPECT_EQ(deflateInit2(&strm, 6, Z_DEFLATED, MAX_WBITS, 8, strategy), Z_OK);
+  strm.next_in = (Bytef *)&src[0];
+  strm.next_out = (Bytef *)&out[0];
+  int err = Z_OK;
+  while (err != Z_STREAM_END)
+  {
+    uLong inLeft = src.size() - strm.total_in;
+    strm.avail_in = (uInt)MIN(inLeft, chunk);
+    strm.avail_out = (uInt)MIN(out.size() - strm.total_out, chunk);
+    err = deflate(&strm, strm.avail_in == inLeft ? Z_FINISH : Z_NO_FLUSH);
+    EXPECT_TRUE(err == Z_OK || err == Z_STREAM_END || err == Z_BUF_ERROR);
+    if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR)
+      break;
+  }
+  out.resize(strm.total_out);
+  EXPECT_EQ(deflateEnd(&strm), Z_OK);
+
+  std::string back(src.size(), 0);
+  uLongf backLen = src.size();
+  EXPECT_EQ(uncompress((Bytef *)&back[0], &backLen, (Bytef *)&out[0], out.size()), Z_OK);
+  EXPECT_TRUE(back == src);
+  return out;
+}
+
+TEST(ZLIB_deflate_strategy, rle_huffman_opt_levels)
+{
+  /* runs of all lengths around MIN_MATCH and MAX_MATCH between literals */
+  const int srcLen = 300 * 1024;
+  std::string src;
+  unsigned seed = 7;
+  while ((int)src.size() < srcLen)
+  {
+    seed = seed * 1103515245u + 12345u;
+    int len = (seed >> 16) % 4 ? (seed >> 8) % 6 + 1 : (seed >> 8) % 600 + 1;
+    src.append(len, (char)((seed >> 24) % 3));
+  }
+  src.resize(srcLen);
+
+  const int strategies[] = { Z_RLE, Z_HUFFMAN_ONLY };
+  for (int strategy : strategies)
+  {
+    /* the SSE2 and AVX2 variants emit the same stream, whatever the chunking */
+    std::string ref = deflate_strategy(src, strategy, 1, (uInt)-1);
+    EXPECT_TRUE(deflate_strategy(src, strategy, 1, 1000) == ref);
+    EXPECT_TRUE(deflate_strategy(src, strategy, 3, (uInt)-1) == ref);
+    EXPECT_TRUE(deflate_strategy(src, strategy, 3, 1000) == ref);
+  }
+  aocl_setup_zlib(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+}
+
+/* Writes Deflate64 streams with fixed or dynamic blocks, for want of an
+   encoder, and keeps the data they inflate to in ref */
+struct deflate64_writer
+{
+  std::string out;
+  std::string ref;
+  unsigned long acc = 0;
+  int nacc = 0;
+  unsigned char litLen[288], distLen[32];
+  unsigned litCode[288], distCode[32];
+
+  void put(unsigned val, int n)
+  {
+    acc |= (unsigned long)val << nacc;
+    nacc += n;
+    for (; nacc >= 8; nacc -= 8, acc >>= 8)
+      out += (char)(acc & 0xff);
+  }
+  void putCode(unsigned code, int len)  /* Huffman codes go msb first */
+  {
+    unsigned rev = 0;
+    for (int i = 0; i < len; i++)
+      rev |= ((code >> i) & 1) << (len - 1 - i);
+    put(rev, len);
+  }
+  static void canonical(const unsigned char *lens, int n, unsigned *codes)
+  {
+    unsigned count[16] = { 0 }, next[16] = { 0 }, code = 0;
+    for (int i = 0; i < n; i++)
+      count[lens[i]]++;
+    count[0] = 0;
+    for (int b = 1; b < 16; b++)
+      next[b] = code = (code + count[b - 1]) << 1;
+    for (int i = 0; i < n; i++)
+      if (lens[i])
+        codes[i] = next[lens[i]]++;
+  }
+  void fixedBlock(int last)
+  {
+    put(last, 1);
+    put(1, 2);
+    for (int i = 0; i < 288; i++)
+      litLen[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+    memset(distLen, 5, sizeof(distLen));
+    canonical(litLen, 288, litCode);
+    canonical(distLen, 32, distCode);
+  }
+  void dynamicBlock(int last)
+  {
+    /* 8 and 9 bit literal/length codes, and all 32 distance codes at 5 bits,
+       a complete code only Deflate64 allows */
+    static const int order[10] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5 };
+    unsigned char clen[19] = { 0 };
+    clen[8] = 1;    /* code 0 */
+    clen[5] = 2;    /* code 10 */
+    clen[9] = 2;    /* code 11 */
+    put(last, 1);
+    put(2, 2);
+    put(286 - 257, 5);
+    put(32 - 1, 5);
+    put(10 - 4, 4);
+    for (int i = 0; i < 10; i++)
+      put(clen[order[i]], 3);
+    for (int i = 0; i < 288; i++)
+      litLen[i] = i >= 286 ? 0 : (i >= 196 && i < 256) ? 9 : 8;
+    memset(distLen, 5, sizeof(distLen));
+    for (int i = 0; i < 286; i++)
+      litLen[i] == 8 ? putCode(0, 1) : putCode(3, 2);
+    for (int i = 0; i < 32; i++)
+      putCode(2, 2);
+    canonical(litLen, 286, litCode);
+    canonical(distLen, 32, distCode);
+  }
+  void literal(unsigned char c)
+  {
+    putCode(litCode[c], litLen[c]);
+    ref += (char)c;
+  }
+  void match(unsigned len, unsigned dist)
+  {
+    static const unsigned lbase[28] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15,
+      17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227 };
+    int s = 0;
+    if (len > 258)                      /* code 285, 16 extra bits */
+    {
+      putCode(litCode[285], litLen[285]);
+      put(len - 3, 16);
+    }
+    else
+    {
+      for (s = 27; lbase[s] > len; s--)
+        ;
+      putCode(litCode[257 + s], litLen[257 + s]);
+      put(len - lbase[s], s < 8 ? 0 : (s - 4) >> 2);
+    }
+    unsigned base = 1;
+    for (s = 0; s < 31; s++)
+    {
+      unsigned next = base + (1U << (s < 4 ? 0 : (s - 2) >> 1));
+      if (dist < next)
+        break;
+      base = next;
+    }
+    putCode(distCode[s], distLen[s]);
+    put(dist - base, s < 4 ? 0 : (s - 2) >> 1);
+    for (unsigned i = 0; i < len; i++)
+      ref += ref[ref.size() - dist];
+  }
+  void end()
+  {
+    putCode(litCode[256], litLen[256]);
+  }
+  void flush()
+  {
+    if (nacc)
+      put(0, 8 - nacc);
+  }
+};
+
+static int inflate_deflate64(const std::string &in, std::string &out,
+                             size_t outLen, uInt chunkIn, uInt chunkOut,
+                             bool deflate64)
+{
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  EXPECT_EQ(inflateInit2(&strm, -MAX_WBITS), Z_OK);
+  if (deflate64) {
+    EXPECT_EQ(aocl_inflateDeflate64(&strm), Z_OK);
+  }
+  out.assign(outLen, 0);
+  strm.next_in = (Bytef *)in.data();
+  strm.next_out = (Bytef *)&out[0];
+  int err = Z_OK;
+  while (err == Z_OK)
+  {
+    strm.avail_in = (uInt)MIN(in.size() - strm.total_in, chunkIn);
+    strm.avail_out = (uInt)MIN(outLen - strm.total_out, chunkOut);
+    err = inflate(&strm, Z_NO_FLUSH);
+    if (err == Z_BUF_ERROR && strm.total_in < in.size() &&
+        strm.total_out < outLen)
+      err = Z_OK;
+  }
+  out.resize(strm.total_out);
+  EXPECT_EQ(inflateEnd(&strm), Z_OK);
+  return err;
+}
+
+TEST(ZLIB_inflateDeflate64, fail_cases)
+{
+  z_stream strm;
+  EXPECT_EQ(aocl_inflateDeflate64(NULL), Z_STREAM_ERROR);
+
+  /* zlib and gzip wrapped streams cannot be Deflate64 */
+  memset(&strm, 0, sizeof(strm));
+  EXPECT_EQ(inflateInit2(&strm, MAX_WBITS), Z_OK);
+  EXPECT_EQ(aocl_inflateDeflate64(&strm), Z_STREAM_ERROR);
+  EXPECT_EQ(inflateEnd(&strm), Z_OK);
+
+  /* nor can a stream already being inflated be switched */
+  unsigned char block[] = { 0x03, 0x00 };   /* empty fixed last block */
+  unsigned char buf[4];
+  memset(&strm, 0, sizeof(strm));
+  EXPECT_EQ(inflateInit2(&strm, -MAX_WBITS), Z_OK);
+  EXPECT_EQ(aocl_inflateDeflate64(&strm), Z_OK);
+  strm.next_in = block;
+  strm.avail_in = sizeof(block);
+  strm.next_out = buf;
+  strm.avail_out = sizeof(buf);
+  EXPECT_EQ(inflate(&strm, Z_NO_FLUSH), Z_STREAM_END);
+  EXPECT_EQ(aocl_inflateDeflate64(&strm), Z_STREAM_ERROR);
+  EXPECT_EQ(inflateReset(&strm), Z_OK);
+  EXPECT_EQ(aocl_inflateDeflate64(&strm), Z_OK);
+  EXPECT_EQ(inflateEnd(&strm), Z_OK);
+}
+
+TEST(ZLIB_inflateDeflate64, long_lengths_and_distances)
+{
+  deflate64_writer w;
+  unsigned seed = 11;
+  auto literals = [&](int n) {
+    for (int i = 0; i < n; i++)
+    {
+      seed = seed * 1103515245u + 12345u;
+      w.literal((unsigned char)(seed >> 16));
+    }
+  };
+  w.fixedBlock(0);
+  literals(40000);
+  w.match(65538, 40000);    /* longest length, distance code 30 */
+  literals(2000);
+  w.match(300, 65536);      /* longest distance, code 31 */
+  literals(100);
+  w.match(258, 1);          /* code 284 with 31 extra */
+  w.match(10, 33000);
+  literals(2000);
+  w.end();
+  w.dynamicBlock(1);
+  literals(3000);
+  w.match(1000, 60000);
+  literals(2000);
+  w.match(259, 50000);
+  w.match(5, 3);
+  literals(500);
+  w.end();
+  w.flush();
+
+  std::string out;
+  for (int optLevel = 0; optLevel <= 3; optLevel++)
+  {
+    aocl_setup_zlib(0, optLevel, 0, 0, 0);
+    /* fast path, slow path on short output and on short input */
+    EXPECT_EQ(inflate_deflate64(w.out, out, w.ref.size(), (uInt)-1, (uInt)-1, true), Z_STREAM_END);
+    EXPECT_TRUE(out == w.ref);
+    EXPECT_EQ(inflate_deflate64(w.out, out, w.ref.size(), (uInt)-1, 1000, true), Z_STREAM_END);
+    EXPECT_TRUE(out == w.ref);
+    EXPECT_EQ(inflate_deflate64(w.out, out, w.ref.size(), 7, (uInt)-1, true), Z_STREAM_END);
+    EXPECT_TRUE(out == w.ref);
+    /* plain deflate rejects the 16 extra bit length and distance codes */
+    EXPECT_EQ(inflate_deflate64(w.out, out, w.ref.size(), (uInt)-1, (uInt)-1, false), Z_DATA_ERROR);
+  }
+  aocl_setup_zlib(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+}
+
+/* Text, binary and runs, with matches at every distance from 1 to 31 and far
+   ones, so that inflate_fast_chunk_avx2() decodes literal pairs, single
+   literals and every overlapping copy pattern */
+static std::string inflate_fast_source(size_t size)
+{
+  static const char *words[] = { "the ", "of ", "and ", "inflate ", "window ",
+                                 "a ", "distance ", "e ", "literal " };
+  std::string data;
+  unsigned seed = 11;
+  while (data.size() < size)
+  {
+    seed = seed * 1103515245u + 12345u;
+    switch ((seed >> 8) % 5)
+    {
+    case 0: /* text from a small vocabulary */
+      for (int i = 0; i < 20; i++)
+      {
+        seed = seed * 1103515245u + 12345u;
+        data += words[(seed >> 16) % 9];
+      }
+      break;
+    case 4: /* letters of skewed frequencies: literal codes short enough to pair */
+      for (int i = 0; i < 40; i++)
+      {
+        seed = seed * 1103515245u + 12345u;
+        data += "eeeeeeeetttaaoinshrdlu"[(seed >> 16) % 22];
+      }
+      break;
+    case 1: /* random binary: long literal codes */
+      for (unsigned i = 0; i < (seed >> 12) % 64 + 1; i++)
+      {
+        seed = seed * 1103515245u + 12345u;
+        data += (char)(seed >> 24);
+      }
+      break;
+    default: /* a pattern of period 1 to 31, or a far match */
+    {
+      size_t period = (seed >> 12) % 32 + 1;
+      size_t len = (seed >> 4) % 8 ? (seed >> 18) % 40 + 3 : (seed >> 18) % 600 + 3;
+      for (size_t i = 0; i < period; i++)
+      {
+        seed = seed * 1103515245u + 12345u;
+        data += (char)(seed >> 24);
+      }
+      if (period == 32 && data.size() > 20000)
+        period = 20000 - (seed >> 20) % 1000;
+      for (size_t i = 0; i < len; i++)
+        data += data[data.size() - period];
+    }
+    }
+  }
+  data.resize(size);
+  return data;
+}
+
+/* Inflates the raw deflate stream in into out, chunkIn input bytes and
+   chunkOut output bytes at a time. Each call writes to a buffer followed by
+   guard bytes, and fails if any of them is touched. */
+static int inflate_guarded(const std::string &in, std::string &out,
+                           uInt chunkIn, uInt chunkOut)
+{
+  const size_t guard = 64;
+  std::string buf(chunkOut + guard, 0);
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  EXPECT_EQ(inflateInit2(&strm, -MAX_WBITS), Z_OK);
+  out.clear();
+  strm.next_in = (Bytef *)in.data();
+  int err = Z_OK;
+  while (err == Z_OK)
+  {
+    memset(&buf[chunkOut], 0xA5, guard);
+    strm.avail_in = (uInt)MIN(in.size() - strm.total_in, chunkIn);
+    strm.next_out = (Bytef *)&buf[0];
+    strm.avail_out = chunkOut;
+    err = inflate(&strm, Z_NO_FLUSH);
+    for (size_t i = 0; i < guard; i++)
+      if ((unsigned char)buf[chunkOut + i] != 0xA5)
+      {
+        ADD_FAILURE() << "write past avail_out at total_out " << strm.total_out;
+        err = Z_MEM_ERROR;
+        break;
+      }
+    out.append(buf, 0, chunkOut - strm.avail_out);
+    if (err == Z_BUF_ERROR && strm.total_in < in.size())
+      err = Z_OK;
+  }
+  EXPECT_EQ(inflateEnd(&strm), Z_OK);
+  return err;
+}
+
+TEST(ZLIB_inflate_fast_chunk, opt_levels_chunked)
+{
+  const size_t srcLen = 400 * 1024;
+  std::string src = inflate_fast_source(srcLen);
+  aocl_setup_zlib(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+
+  /* dynamic blocks at several levels, and fixed blocks */
+  const int levels[] = { 1, 6, 9, 6 };
+  for (int l = 0; l < 4; l++)
+  {
+    std::string comp(compressBound(srcLen), 0);
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    ASSERT_EQ(deflateInit2(&strm, levels[l], Z_DEFLATED, -MAX_WBITS, 8,
+                           l == 3 ? Z_FIXED : Z_DEFAULT_STRATEGY), Z_OK);
+    strm.next_in = (Bytef *)&src[0];
+    strm.avail_in = srcLen;
+    strm.next_out = (Bytef *)&comp[0];
+    strm.avail_out = comp.size();
+    ASSERT_EQ(deflate(&strm, Z_FINISH), Z_STREAM_END);
+    comp.resize(strm.total_out);
+    EXPECT_EQ(deflateEnd(&strm), Z_OK);
+
+    /* whole buffers, output around INFLATE_FAST_MIN_OUTPUT (293), input
+       around INFLATE_FAST_MIN_INPUT (15), and uneven chunks of both */
+    const uInt chunks[][2] = { { (uInt)-1, srcLen }, { (uInt)-1, 292 },
+                               { (uInt)-1, 293 }, { (uInt)-1, 294 },
+                               { 15, 65536 }, { 16, 300 }, { 1000, 777 } };
+    for (int optLevel = 2; optLevel <= 3; optLevel++)
+    {
+      aocl_setup_zlib(0, optLevel, 0, 0, 0);
+      for (const uInt *c : chunks)
+      {
+        std::string out;
+        EXPECT_EQ(inflate_guarded(comp, out, c[0], c[1]), Z_STREAM_END);
+        EXPECT_TRUE(out == src) << "optLevel " << optLevel << ", chunks "
+                                << c[0] << "/" << c[1];
+      }
+    }
+  }
+  aocl_setup_zlib(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+}
@@ -38,11 +38,18 @@
 
 #include <string>
 #include <climits>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include "gtest/gtest.h"
 
 #ifndef AOCL_EXCLUDE_ZSTD
 #define ZSTD_STATIC_LINKING_ONLY
 #include "algos/zstd/lib/zstd.h"
+#include "algos/zstd/lib/zstd_seekable.h"
+#define ZDICT_STATIC_LINKING_ONLY
+#include "algos/zstd/lib/zdict.h"
 #endif
 
 #define DEFAULT_OPT_LEVEL 2 // system running gtest must have AVX support
@@ -566,6 +573,30 @@ TEST_F(ZSTD_ZSTD_compressed_advanced, AOCL_Compression_zstd_ZSTD_compress_advanc
     EXPECT_TRUE(zstd_check_uncompressed_equal_to_original(d.getOrigData(), d.getOrigSize(), d.getCompressedBuff(), outLen_2));
 }
 
+TEST_F(ZSTD_ZSTD_compressed_advanced, AOCL_Compression_zstd_ZSTD_compress_advanced_common_2) // avx2_histogram_same_output
+{
+    TestLoad_2 d(200000);
+    int level = 3;
+    // skewed symbol distribution with long runs, so literals and sequences
+    // are entropy coded with histograms well above the small-input cutoff
+    for (size_t i = 0; i < d.getOrigSize(); i++)
+        d.getOrigData()[i] = (rand() % 4) ? 'a' + (char)((i / 64) % 3) : (char)(rand() % 255);
+
+    std::vector<char> out_avx(d.getCompressedSize());
+    aocl_setup_zstd_encode(0, 2, 0, 0, 0);   // AVX
+    param = ZSTD_getParams(level, d.getOrigSize(), 0);
+    size_t outLen_1 = Test_ZSTD_compress_advanced(cctx, out_avx.data(), out_avx.size(), d.getOrigData(), d.getOrigSize(), NULL, 0, param);
+
+    aocl_setup_zstd_encode(0, 3, 0, 0, 0);   // AVX2
+    size_t outLen_2 = Test_ZSTD_compress_advanced(cctx, d.getCompressedBuff(), d.getCompressedSize(), d.getOrigData(), d.getOrigSize(), NULL, 0, param);
+    aocl_setup_zstd_encode(0, DEFAULT_OPT_LEVEL, 0, 0, 0);
+
+    ASSERT_FALSE(ZSTD_isError(outLen_1));
+    ASSERT_EQ(outLen_1, outLen_2);
+    EXPECT_EQ(memcmp(out_avx.data(), d.getCompressedBuff(), outLen_1), 0);
+    EXPECT_TRUE(zstd_check_uncompressed_equal_to_original(d.getOrigData(), d.getOrigSize(), d.getCompressedBuff(), outLen_2));
+}
+
 /*********************************************
  * End of ZSTD_compress_advanced
  *********************************************/
@@ -674,3 +705,468 @@ TEST_F(ZSTD_ZSTD_decompressDCtx, AOCL_Compression_zstd_ZSTD_decompressDCtx_commo
 
 
 
+
+
+/*********************************************
+ * Begin of ZSTD_seekable
+ *********************************************/
+
+class ZSTD_ZSTD_seekable : public AOCL_setup_zstd
+{
+public:
+    char *orig = NULL;
+    size_t origLen = 0;
+    char *archive = NULL;
+    size_t archiveLen = 0;
+    ZSTD_seekable *zs = NULL;
+
+    // Creates `sz` bytes of compressible data and a seekable archive of it
+    // made of `frameSize` byte frames.
+    void createArchive(size_t sz, unsigned frameSize, int checksumFlag)
+    {
+        origLen = sz;
+        orig = (char *)malloc(origLen);
+        for (size_t i = 0; i < origLen; i++)
+            orig[i] = (char)((i / 7) % 31 + (rand() % 4));
+
+        size_t bound = ZSTD_seekable_compressBound(origLen, frameSize, checksumFlag);
+        archive = (char *)malloc(bound);
+        archiveLen = ZSTD_seekable_compress(archive, bound, orig, origLen, 3,
+                                            frameSize, checksumFlag);
+        ASSERT_FALSE(ZSTD_isError(archiveLen));
+
+        zs = ZSTD_seekable_create();
+        ASSERT_NE(zs, nullptr);
+    }
+
+    ~ZSTD_ZSTD_seekable()
+    {
+        ZSTD_seekable_free(zs);
+        free(orig);
+        free(archive);
+    }
+};
+
+TEST_F(ZSTD_ZSTD_seekable, AOCL_Compression_zstd_ZSTD_seekable_common_1) // archive_is_a_valid_zstd_stream
+{
+    createArchive(300000, 65536, 1);
+    // Seekable archives are plain zstd frames followed by a skippable frame.
+    char *output = (char *)malloc(origLen);
+    size_t decLen = ZSTD_decompress(output, origLen, archive, archiveLen);
+    ASSERT_EQ(decLen, origLen);
+    EXPECT_EQ(0, memcmp(output, orig, origLen));
+    free(output);
+}
+
+TEST_F(ZSTD_ZSTD_seekable, AOCL_Compression_zstd_ZSTD_seekable_common_2) // seek_table
+{
+    createArchive(300000, 65536, 0);
+    ASSERT_EQ(ZSTD_seekable_initBuff(zs, archive, archiveLen), 0);
+    ASSERT_EQ(ZSTD_seekable_getNumFrames(zs), 5u);
+    for (unsigned i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(ZSTD_seekable_getFrameDecompressedOffset(zs, i), i * 65536ull);
+        EXPECT_EQ(ZSTD_seekable_getFrameDecompressedSize(zs, i), 65536u);
+    }
+    EXPECT_EQ(ZSTD_seekable_getFrameDecompressedSize(zs, 4), 300000u - 4 * 65536);
+    EXPECT_EQ(ZSTD_seekable_offsetToFrameIndex(zs, 65535), 0u);
+    EXPECT_EQ(ZSTD_seekable_offsetToFrameIndex(zs, 65536), 1u);
+    EXPECT_EQ(ZSTD_seekable_offsetToFrameIndex(zs, 299999), 4u);
+    EXPECT_EQ(ZSTD_seekable_getFrameCompressedOffset(zs, 5), ZSTD_SEEKABLE_FRAMEINDEX_TOOLARGE);
+    EXPECT_TRUE(ZSTD_isError(ZSTD_seekable_getFrameCompressedSize(zs, 5)));
+}
+
+TEST_F(ZSTD_ZSTD_seekable, AOCL_Compression_zstd_ZSTD_seekable_common_3) // random_ranges
+{
+    createArchive(1 << 20, 65536, 1);
+    ASSERT_EQ(ZSTD_seekable_initBuff(zs, archive, archiveLen), 0);
+    char *output = (char *)malloc(100000);
+    for (int i = 0; i < 200; i++)
+    {
+        size_t offset = rand() % origLen;
+        size_t len = rand() % 100000;
+        size_t expected = (offset + len > origLen) ? origLen - offset : len;
+        size_t ret = ZSTD_seekable_decompress(zs, output, len, offset);
+        ASSERT_EQ(ret, expected);
+        EXPECT_EQ(0, memcmp(output, orig + offset, expected));
+    }
+    free(output);
+}
+
+TEST_F(ZSTD_ZSTD_seekable, AOCL_Compression_zstd_ZSTD_seekable_common_4) // sequential_reads_and_frames
+{
+    createArchive(200000, 4096, 0);
+    ASSERT_EQ(ZSTD_seekable_initBuff(zs, archive, archiveLen), 0);
+    char *output = (char *)malloc(origLen);
+    // Forward reads resume the frame being decoded.
+    for (size_t offset = 0; offset < origLen; offset += 1000)
+    {
+        size_t ret = ZSTD_seekable_decompress(zs, output + offset, 1000, offset);
+        ASSERT_FALSE(ZSTD_isError(ret));
+    }
+    EXPECT_EQ(0, memcmp(output, orig, origLen));
+
+    size_t frameSize = ZSTD_seekable_getFrameDecompressedSize(zs, 3);
+    EXPECT_TRUE(ZSTD_isError(ZSTD_seekable_decompressFrame(zs, output, frameSize - 1, 3)));
+    EXPECT_EQ(ZSTD_seekable_decompressFrame(zs, output, frameSize, 3), frameSize);
+    EXPECT_EQ(0, memcmp(output, orig + ZSTD_seekable_getFrameDecompressedOffset(zs, 3), frameSize));
+    free(output);
+}
+
+TEST_F(ZSTD_ZSTD_seekable, AOCL_Compression_zstd_ZSTD_seekable_common_5) // streaming_matches_single_pass
+{
+    createArchive(250000, 32768, 1);
+    ZSTD_seekable_CStream *zcs = ZSTD_seekable_createCStream();
+    ASSERT_NE(zcs, nullptr);
+    ASSERT_FALSE(ZSTD_isError(ZSTD_seekable_initCStream(zcs, 3, 1, 32768)));
+
+    // Stream with small output buffers to exercise partial seek table writes.
+    size_t bound = ZSTD_seekable_compressBound(origLen, 32768, 1);
+    char *streamed = (char *)malloc(bound);
+    size_t streamedLen = 0;
+    ZSTD_inBuffer in = { orig, origLen, 0 };
+    while (in.pos < in.size)
+    {
+        ZSTD_outBuffer out = { streamed + streamedLen, 7, 0 };
+        ASSERT_FALSE(ZSTD_isError(ZSTD_seekable_compressStream(zcs, &out, &in)));
+        streamedLen += out.pos;
+    }
+    size_t remaining;
+    do {
+        ZSTD_outBuffer out = { streamed + streamedLen, 7, 0 };
+        remaining = ZSTD_seekable_endStream(zcs, &out);
+        ASSERT_FALSE(ZSTD_isError(remaining));
+        streamedLen += out.pos;
+    } while (remaining);
+    ZSTD_seekable_freeCStream(zcs);
+
+    ASSERT_EQ(ZSTD_seekable_initBuff(zs, streamed, streamedLen), 0);
+    EXPECT_EQ(ZSTD_seekable_getNumFrames(zs), 8u);
+    char *output = (char *)malloc(origLen);
+    EXPECT_EQ(ZSTD_seekable_decompress(zs, output, origLen, 0), origLen);
+    EXPECT_EQ(0, memcmp(output, orig, origLen));
+    free(output);
+    free(streamed);
+}
+
+TEST_F(ZSTD_ZSTD_seekable, AOCL_Compression_zstd_ZSTD_seekable_common_6) // invalid_archives
+{
+    createArchive(100000, 16384, 1);
+    // Regular zstd frame without a seek table.
+    char *plain = (char *)malloc(ZSTD_compressBound(origLen));
+    size_t plainLen = ZSTD_compress(plain, ZSTD_compressBound(origLen), orig, origLen, 1);
+    EXPECT_TRUE(ZSTD_isError(ZSTD_seekable_initBuff(zs, plain, plainLen)));
+    EXPECT_TRUE(ZSTD_isError(ZSTD_seekable_initBuff(zs, archive, 4)));
+    free(plain);
+
+    // Corrupted frame content is caught by the per-frame checksum or the decoder.
+    ASSERT_EQ(ZSTD_seekable_initBuff(zs, archive, archiveLen), 0);
+    size_t cOffset = ZSTD_seekable_getFrameCompressedOffset(zs, 2);
+    size_t cSize = ZSTD_seekable_getFrameCompressedSize(zs, 2);
+    for (size_t i = cOffset + cSize / 2; i < cOffset + cSize / 2 + 16; i++)
+        archive[i] ^= 0x5a;
+    char *output = (char *)malloc(origLen);
+    EXPECT_TRUE(ZSTD_isError(ZSTD_seekable_decompressFrame(zs, output, origLen, 2)));
+    EXPECT_EQ(ZSTD_seekable_decompressFrame(zs, output, origLen, 1), 16384u);
+    free(output);
+}
+
+/*********************************************
+ * End of ZSTD_seekable
+ *********************************************/
+
+
+
+/*********************************************
+ * Begin of ZDICT_optimizeTrainFromBuffer_fastCover_memLimit
+ *********************************************/
+
+class ZSTD_ZDICT_fastCover_memLimit : public AOCL_setup_zstd
+{
+public:
+    static const unsigned nbSamples = 400;
+    static const size_t dictCapacity = 16 * 1024;
+    char *samples = NULL;
+    size_t sampleSizes[nbSamples];
+    size_t samplesLen = 0;
+    char dict[dictCapacity];
+    ZDICT_fastCover_params_t params;
+
+    // Samples are records built from a small vocabulary, like log lines.
+    ZSTD_ZDICT_fastCover_memLimit()
+    {
+        static const char *words[] = { "timestamp=", "level=INFO ", "level=WARN ",
+            "tenant=", "request_id=", "latency_ms=", "status=200 ", "status=404 ",
+            "path=/api/v1/items ", "path=/api/v1/users ", "user_agent=curl " };
+        const unsigned nbWords = sizeof(words) / sizeof(words[0]);
+        samples = (char *)malloc(nbSamples * 512);
+        for (unsigned i = 0; i < nbSamples; i++)
+        {
+            char *p = samples + samplesLen;
+            size_t len = 0;
+            while (len < 300 + (size_t)(rand() % 150))
+            {
+                const char *w = words[rand() % nbWords];
+                size_t wl = strlen(w);
+                memcpy(p + len, w, wl);
+                len += wl;
+                len += snprintf(p + len, 16, "%d ", rand() % 1000);
+            }
+            sampleSizes[i] = len;
+            samplesLen += len;
+        }
+        memset(&params, 0, sizeof(params));
+        params.d = 8;
+        params.steps = 4;
+        params.nbThreads = 1;
+        params.zParams.compressionLevel = 3;
+    }
+
+    // Checks that `dict` can be used to compress and decompress a sample.
+    void checkDict(size_t dictSize)
+    {
+        ASSERT_FALSE(ZDICT_isError(dictSize));
+        ASSERT_GT(dictSize, 0u);
+        EXPECT_NE(ZDICT_getDictID(dict, dictSize), 0u);
+
+        ZSTD_CCtx *cctx = ZSTD_createCCtx();
+        ZSTD_DCtx *dctx = ZSTD_createDCtx();
+        size_t bound = ZSTD_compressBound(sampleSizes[0]);
+        char *cbuf = (char *)malloc(bound);
+        char *dbuf = (char *)malloc(sampleSizes[0]);
+        size_t cSize = ZSTD_compress_usingDict(cctx, cbuf, bound, samples,
+                           sampleSizes[0], dict, dictSize, 3);
+        ASSERT_FALSE(ZSTD_isError(cSize));
+        size_t dSize = ZSTD_decompress_usingDict(dctx, dbuf, sampleSizes[0],
+                           cbuf, cSize, dict, dictSize);
+        EXPECT_EQ(dSize, sampleSizes[0]);
+        EXPECT_EQ(0, memcmp(dbuf, samples, sampleSizes[0]));
+        free(cbuf);
+        free(dbuf);
+        ZSTD_freeCCtx(cctx);
+        ZSTD_freeDCtx(dctx);
+    }
+
+    ~ZSTD_ZDICT_fastCover_memLimit()
+    {
+        free(samples);
+    }
+};
+
+TEST_F(ZSTD_ZDICT_fastCover_memLimit, AOCL_Compression_zstd_ZDICT_fastCover_memLimit_common_1) // no_limit
+{
+    size_t dictSize = ZDICT_optimizeTrainFromBuffer_fastCover_memLimit(dict,
+                          dictCapacity, samples, sampleSizes, nbSamples, &params, 0);
+    checkDict(dictSize);
+    EXPECT_EQ(params.f, 20u);
+}
+
+TEST_F(ZSTD_ZDICT_fastCover_memLimit, AOCL_Compression_zstd_ZDICT_fastCover_memLimit_common_2) // limit_lowers_f
+{
+    size_t dictSize = ZDICT_optimizeTrainFromBuffer_fastCover_memLimit(dict,
+                          dictCapacity, samples, sampleSizes, nbSamples, &params,
+                          4 * 1024 * 1024);
+    checkDict(dictSize);
+    EXPECT_LT(params.f, 20u);
+}
+
+TEST_F(ZSTD_ZDICT_fastCover_memLimit, AOCL_Compression_zstd_ZDICT_fastCover_memLimit_common_3) // threads_within_limit
+{
+    params.nbThreads = 4;
+    size_t dictSize = ZDICT_optimizeTrainFromBuffer_fastCover_memLimit(dict,
+                          dictCapacity, samples, sampleSizes, nbSamples, &params,
+                          64 * 1024 * 1024);
+    checkDict(dictSize);
+}
+
+TEST_F(ZSTD_ZDICT_fastCover_memLimit, AOCL_Compression_zstd_ZDICT_fastCover_memLimit_common_4) // limit_too_small
+{
+    size_t dictSize = ZDICT_optimizeTrainFromBuffer_fastCover_memLimit(dict,
+                          dictCapacity, samples, sampleSizes, nbSamples, &params,
+                          64 * 1024);
+    EXPECT_TRUE(ZDICT_isError(dictSize));
+}
+
+TEST_F(ZSTD_ZDICT_fastCover_memLimit, AOCL_Compression_zstd_ZDICT_fastCover_memLimit_common_5) // concurrent_callers
+{
+    // With k, d and f given, a single parameter set is tried, so the
+    // dictionary does not depend on how the trials are scheduled.
+    params.k = 256;
+    params.f = 18;
+    size_t refSize = ZDICT_optimizeTrainFromBuffer_fastCover_memLimit(dict,
+                         dictCapacity, samples, sampleSizes, nbSamples, &params, 0);
+    checkDict(refSize);
+
+    // The callers wait for each other and then train at the same time, each
+    // with its own thread pool.
+    const int nbCallers = 4;
+    std::mutex mutex;
+    std::condition_variable allReady;
+    int ready = 0;
+    std::vector<std::vector<char>> dicts(nbCallers, std::vector<char>(dictCapacity));
+    std::vector<size_t> sizes(nbCallers);
+    std::vector<std::thread> callers;
+    for (int i = 0; i < nbCallers; i++)
+    {
+        callers.emplace_back([&, i]() {
+            ZDICT_fastCover_params_t p = params;
+            p.nbThreads = 2;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (++ready == nbCallers)
+                    allReady.notify_all();
+                allReady.wait(lock, [&]() { return ready == nbCallers; });
+            }
+            sizes[i] = ZDICT_optimizeTrainFromBuffer_fastCover_memLimit(dicts[i].data(),
+                           dictCapacity, samples, sampleSizes, nbSamples, &p, 0);
+        });
+    }
+    for (std::thread &t : callers)
+        t.join();
+    for (int i = 0; i < nbCallers; i++)
+    {
+        ASSERT_EQ(sizes[i], refSize);
+        EXPECT_EQ(0, memcmp(dicts[i].data(), dict, refSize));
+    }
+}
+
+/*********************************************
+ * End of ZDICT_optimizeTrainFromBuffer_fastCover_memLimit
+ *********************************************/
+
+
+
+/*********************************************
+ * Begin of ZSTD_c_rsyncable without workers
+ *********************************************/
+
+class ZSTD_ZSTD_rsyncable : public AOCL_setup_zstd
+{
+public:
+    std::vector<char> src;
+    ZSTD_CCtx *cctx = NULL;
+
+    // Creates `sz` bytes of text like data and a single-threaded
+    // rsyncable context.
+    ZSTD_ZSTD_rsyncable()
+    {
+        size_t sz = 6 << 20;
+        unsigned seed = 1;
+        src.resize(sz);
+        for (size_t i = 0; i < sz; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            src[i] = (seed >> 16) % 5 ? 'a' + (seed >> 20) % 8 : ' ';
+        }
+        cctx = ZSTD_createCCtx();
+        EXPECT_FALSE(ZSTD_isError(ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, 1)));
+        EXPECT_FALSE(ZSTD_isError(ZSTD_CCtx_setParameter(cctx, ZSTD_c_rsyncable, 1)));
+    }
+
+    // Compresses `in` with ZSTD_compress2().
+    std::vector<char> compress(const std::vector<char> &in)
+    {
+        std::vector<char> out(ZSTD_compressBound(in.size()));
+        size_t cSize = ZSTD_compress2(cctx, &out[0], out.size(), &in[0], in.size());
+        EXPECT_FALSE(ZSTD_isError(cSize));
+        out.resize(ZSTD_isError(cSize) ? 0 : cSize);
+        return out;
+    }
+
+    void checkRoundtrip(const std::vector<char> &c)
+    {
+        std::vector<char> d(src.size());
+        size_t dSize = ZSTD_decompress(&d[0], d.size(), &c[0], c.size());
+        ASSERT_EQ(dSize, src.size());
+        EXPECT_TRUE(d == src);
+    }
+
+    ~ZSTD_ZSTD_rsyncable()
+    {
+        ZSTD_freeCCtx(cctx);
+    }
+};
+
+TEST_F(ZSTD_ZSTD_rsyncable, AOCL_Compression_zstd_ZSTD_rsyncable_common_1) // roundtrip
+{
+    int value = 0;
+    EXPECT_FALSE(ZSTD_isError(ZSTD_CCtx_getParameter(cctx, ZSTD_c_rsyncable, &value)));
+    EXPECT_EQ(value, 1);
+    checkRoundtrip(compress(src));
+}
+
+TEST_F(ZSTD_ZSTD_rsyncable, AOCL_Compression_zstd_ZSTD_rsyncable_common_2) // streaming_small_buffers
+{
+    std::vector<char> c(ZSTD_compressBound(src.size()));
+    ZSTD_outBuffer out = { &c[0], 0, 0 };
+    ZSTD_inBuffer in = { &src[0], 0, 0 };
+    size_t ret;
+    do
+    {
+        in.size = std::min<size_t>(in.pos + 77777, src.size());
+        out.size = std::min<size_t>(out.pos + 3333, c.size());
+        ret = ZSTD_compressStream2(cctx, &out, &in,
+                  in.size == src.size() ? ZSTD_e_end : ZSTD_e_continue);
+        ASSERT_FALSE(ZSTD_isError(ret));
+    } while (in.size != src.size() || ret != 0);
+    c.resize(out.pos);
+    checkRoundtrip(c);
+}
+
+TEST_F(ZSTD_ZSTD_rsyncable, AOCL_Compression_zstd_ZSTD_rsyncable_common_3) // local_change
+{
+    // A byte changed early in the input must leave the end of the frame untouched.
+    // The fast strategies only index the positions their parse visits, so
+    // on such low redundancy data they take long to resync; use greedy.
+    EXPECT_FALSE(ZSTD_isError(ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, 5)));
+    std::vector<char> c0 = compress(src);
+    std::vector<char> mod = src;
+    mod[1000] ^= 1;
+    std::vector<char> c1 = compress(mod);
+    ASSERT_FALSE(c0.empty() || c1.empty());
+    size_t common = 0;
+    while (common < c0.size() && common < c1.size() &&
+           c0[c0.size() - 1 - common] == c1[c1.size() - 1 - common])
+        common++;
+    EXPECT_GT(common, c0.size() / 2);
+}
+
+TEST_F(ZSTD_ZSTD_rsyncable, AOCL_Compression_zstd_ZSTD_rsyncable_common_4) // stable_input_unsupported
+{
+    std::vector<char> c(ZSTD_compressBound(src.size()));
+    ZSTD_outBuffer out = { &c[0], c.size(), 0 };
+    ZSTD_inBuffer in = { &src[0], src.size(), 0 };
+    EXPECT_FALSE(ZSTD_isError(ZSTD_CCtx_setParameter(cctx, ZSTD_c_stableInBuffer, 1)));
+    EXPECT_TRUE(ZSTD_isError(ZSTD_compressStream2(cctx, &out, &in, ZSTD_e_end)));
+}
+
+TEST_F(ZSTD_ZSTD_rsyncable, AOCL_Compression_zstd_ZSTD_rsyncable_common_5) // moved_input
+{
+    // Each call gets a fresh copy of the unconsumed input, so the bytes before
+    // in.pos are gone; the sync points must not depend on the chunk size.
+    std::vector<char> c[2];
+    size_t chunkSize[2] = { 4099, 77777 };
+    for (int i = 0; i < 2; i++)
+    {
+        c[i].resize(ZSTD_compressBound(src.size()));
+        ZSTD_outBuffer out = { &c[i][0], c[i].size(), 0 };
+        size_t pos = 0, ret;
+        do
+        {
+            size_t end = std::min<size_t>(pos + chunkSize[i], src.size());
+            std::vector<char> chunk(src.begin() + pos, src.begin() + end);
+            ZSTD_inBuffer in = { &chunk[0], chunk.size(), 0 };
+            ret = ZSTD_compressStream2(cctx, &out, &in,
+                      end == src.size() ? ZSTD_e_end : ZSTD_e_continue);
+            ASSERT_FALSE(ZSTD_isError(ret));
+            pos += in.pos;
+        } while (pos != src.size() || ret != 0);
+        c[i].resize(out.pos);
+        checkRoundtrip(c[i]);
+    }
+    EXPECT_TRUE(c[0] == c[1]);
+}
+
+/*********************************************
+ * End of ZSTD_c_rsyncable without workers
+ *********************************************/